@@ -25,6 +25,7 @@ public class OUUBlueprintRuntime : OUUModuleRules
 			"HeadMountedDisplay",
 			"PropertyPath",
 			"ApplicationCore",
+			"Json",
 
 			// Plugin
 			"OUURuntime"
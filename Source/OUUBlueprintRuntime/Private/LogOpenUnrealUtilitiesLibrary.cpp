@@ -2,24 +2,315 @@
 
 #include "LogOpenUnrealUtilitiesLibrary.h"
 
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
 #include "LogOpenUnrealUtilities.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+namespace OUU::BlueprintRuntime::Private::Logging
+{
+	static TAutoConsoleVariable<bool> CVar_StructuredLogEnabled(
+		TEXT("ouu.Log.Structured.Enabled"),
+		true,
+		TEXT("If enabled, structured Blueprint log messages are also written as JSON lines to "
+			 "Saved/Logs/<Project>_Structured.jsonl"));
+
+	FString FormatMessage(const FString& Format, TConstArrayView<FString> FieldNames, TConstArrayView<FString> Values)
+	{
+		FString Result;
+		Result.Reserve(Format.Len());
+		const int32 Len = Format.Len();
+		for (int32 i = 0; i < Len; i++)
+		{
+			if (Format[i] == TEXT('{'))
+			{
+				const int32 NameEnd = Format.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, i + 1);
+				if (NameEnd != INDEX_NONE)
+				{
+					const FStringView Name = FStringView(Format).Mid(i + 1, NameEnd - i - 1);
+					const int32 FieldIdx = FieldNames.IndexOfByPredicate([&](const FString& FieldName) {
+						return Name.Equals(FieldName, ESearchCase::CaseSensitive);
+					});
+					if (Values.IsValidIndex(FieldIdx))
+					{
+						Result += Values[FieldIdx];
+						i = NameEnd;
+						continue;
+					}
+				}
+			}
+			Result.AppendChar(Format[i]);
+		}
+		return Result;
+	}
+
+	/** Fatal messages must halt even if logging is compiled out (see EOUUBlueprintLogVerbosity::Fatal) */
+	FORCEINLINE void HaltOnFatalVerbosity(EOUUBlueprintLogVerbosity Verbosity, const FString& Message)
+	{
+		if (Verbosity == EOUUBlueprintLogVerbosity::Fatal)
+		{
+			LowLevelFatalError(TEXT("%s"), *Message);
+		}
+	}
+
+	FORCEINLINE ELogVerbosity::Type ToLogVerbosity(EOUUBlueprintLogVerbosity Verbosity)
+	{
+		return static_cast<ELogVerbosity::Type>(Verbosity);
+	}
+
+	FString MakeJsonLine(
+		FName CategoryName,
+		ELogVerbosity::Type Verbosity,
+		const FString& Message,
+		TConstArrayView<FString> FieldNames,
+		TConstArrayView<FString> FieldValues)
+	{
+		FString Line;
+		const auto Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("time"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("frame"), static_cast<int64>(GFrameCounter));
+		Writer->WriteValue(TEXT("category"), CategoryName.ToString());
+		Writer->WriteValue(TEXT("verbosity"), FString(ToString(Verbosity)));
+		Writer->WriteValue(TEXT("message"), Message);
+		Writer->WriteObjectStart(TEXT("fields"));
+		const int32 NumFields = FMath::Min(FieldNames.Num(), FieldValues.Num());
+		for (int32 i = 0; i < NumFields; i++)
+		{
+			Writer->WriteValue(FieldNames[i], FieldValues[i]);
+		}
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+		return Line;
+	}
+
+#if !NO_LOGGING
+	/**
+	 * Log categories created for Blueprint category names.
+	 * Log suppression settings are associated by name, so these categories share the verbosity of native categories
+	 * with the same name and react to the same console commands.
+	 */
+	class FBlueprintLogCategoryRegistry
+	{
+	public:
+		static FBlueprintLogCategoryRegistry& Get()
+		{
+			static FBlueprintLogCategoryRegistry Instance;
+			return Instance;
+		}
+
+		FLogCategoryBase& FindOrAdd(FName CategoryName)
+		{
+			if (CategoryName.IsNone() || CategoryName == LogOpenUnrealUtilities.GetCategoryName())
+				return LogOpenUnrealUtilities;
+
+			{
+				FReadScopeLock ReadLock(Lock);
+				if (const TUniquePtr<FLogCategoryBase>* Category = Categories.Find(CategoryName))
+					return **Category;
+			}
+
+			FWriteScopeLock WriteLock(Lock);
+			TUniquePtr<FLogCategoryBase>& Category = Categories.FindOrAdd(CategoryName);
+			if (!Category.IsValid())
+			{
+				Category = MakeUnique<FLogCategoryBase>(
+					*CategoryName.ToString(),
+					ELogVerbosity::Log,
+					ELogVerbosity::All);
+			}
+			return *Category;
+		}
+
+	private:
+		FRWLock Lock;
+		TMap<FName, TUniquePtr<FLogCategoryBase>> Categories;
+	};
+
+	/** Appends JSON lines to the structured log file, which is opened on first use. */
+	class FStructuredLogWriter
+	{
+	public:
+		static FStructuredLogWriter& Get()
+		{
+			static FStructuredLogWriter Instance;
+			return Instance;
+		}
+
+		void WriteLine(FString Line, bool bFlush)
+		{
+			FScopeLock ScopeLock(&CriticalSection);
+			if (!Archive.IsValid())
+			{
+				if (bFailedToOpen)
+					return;
+
+				const FString FilePath =
+					FPaths::ProjectLogDir() / FString::Printf(TEXT("%s_Structured.jsonl"), FApp::GetProjectName());
+				Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_AllowRead));
+				if (!Archive.IsValid())
+				{
+					bFailedToOpen = true;
+					UE_LOG(LogOpenUnrealUtilities, Warning, TEXT("Failed to open structured log file %s"), *FilePath);
+					return;
+				}
+			}
+
+			Line.AppendChar(TEXT('\n'));
+			const FTCHARToUTF8 Utf8Line(*Line);
+			Archive->Serialize(const_cast<void*>(static_cast<const void*>(Utf8Line.Get())), Utf8Line.Length());
+			if (bFlush)
+			{
+				Archive->Flush();
+			}
+		}
+
+		~FStructuredLogWriter()
+		{
+			if (Archive.IsValid())
+			{
+				Archive->Close();
+			}
+		}
+
+	private:
+		FCriticalSection CriticalSection;
+		TUniquePtr<FArchive> Archive;
+		bool bFailedToOpen = false;
+	};
+
+	void WriteMessage(const FLogCategoryBase& Category, ELogVerbosity::Type Verbosity, const FString& Message)
+	{
+		FMsg::Logf(__FILE__, __LINE__, Category.GetCategoryName(), Verbosity, TEXT("%s"), *Message);
+	}
+#endif
+} // namespace OUU::BlueprintRuntime::Private::Logging
 
 void ULogOpenUnrealUtilitiesLibrary::Log(const FString& Message, EOUUBlueprintLogVerbosity Verbosity)
+{
+#if !NO_LOGGING
+	using namespace OUU::BlueprintRuntime::Private::Logging;
+	if (!LogOpenUnrealUtilities.IsSuppressed(ToLogVerbosity(Verbosity)))
+	{
+		WriteMessage(LogOpenUnrealUtilities, ToLogVerbosity(Verbosity), Message);
+	}
+#else
+	OUU::BlueprintRuntime::Private::Logging::HaltOnFatalVerbosity(Verbosity, Message);
+#endif
+}
+
+bool ULogOpenUnrealUtilitiesLibrary::IsLogCategoryActive(FName CategoryName, EOUUBlueprintLogVerbosity Verbosity)
+{
+#if !NO_LOGGING
+	using namespace OUU::BlueprintRuntime::Private::Logging;
+	// Fatal messages are never filtered, so the "Log To Category (OUU)" node always reaches the halt
+	if (Verbosity == EOUUBlueprintLogVerbosity::Fatal)
+		return true;
+
+	return !FBlueprintLogCategoryRegistry::Get().FindOrAdd(CategoryName).IsSuppressed(ToLogVerbosity(Verbosity));
+#else
+	return Verbosity == EOUUBlueprintLogVerbosity::Fatal;
+#endif
+}
+
+void ULogOpenUnrealUtilitiesLibrary::LogToCategory(
+	FName CategoryName,
+	const FString& Message,
+	EOUUBlueprintLogVerbosity Verbosity)
+{
+#if !NO_LOGGING
+	using namespace OUU::BlueprintRuntime::Private::Logging;
+	const FLogCategoryBase& Category = FBlueprintLogCategoryRegistry::Get().FindOrAdd(CategoryName);
+	if (!Category.IsSuppressed(ToLogVerbosity(Verbosity)))
+	{
+		WriteMessage(Category, ToLogVerbosity(Verbosity), Message);
+	}
+#else
+	OUU::BlueprintRuntime::Private::Logging::HaltOnFatalVerbosity(Verbosity, Message);
+#endif
+}
 
+void ULogOpenUnrealUtilitiesLibrary::LogStructured(
+	FName CategoryName,
+	EOUUBlueprintLogVerbosity Verbosity,
+	const FString& Format,
+	const TArray<FString>& FieldNames,
+	const TArray<FString>& FieldValues)
 {
-#define OUU_BLUEPRINT_LOG(Verbosity)                                                                                   \
-	case EOUUBlueprintLogVerbosity::Verbosity: UE_LOG(LogOpenUnrealUtilities, Verbosity, TEXT("%s"), *Message); break;
+#if !NO_LOGGING
+	using namespace OUU::BlueprintRuntime::Private::Logging;
+	const FLogCategoryBase& Category = FBlueprintLogCategoryRegistry::Get().FindOrAdd(CategoryName);
+	const ELogVerbosity::Type LogVerbosity = ToLogVerbosity(Verbosity);
+	if (Category.IsSuppressed(LogVerbosity))
+		return;
 
-	switch (Verbosity)
+	const FString Message = FormatMessage(Format, FieldNames, FieldValues);
+
+	// Write the JSON line first, so fatal messages still end up in the structured log.
+	if (CVar_StructuredLogEnabled.GetValueOnAnyThread())
+	{
+		const bool bFlush = LogVerbosity <= ELogVerbosity::Error;
+		FStructuredLogWriter::Get().WriteLine(
+			MakeJsonLine(Category.GetCategoryName(), LogVerbosity, Message, FieldNames, FieldValues),
+			bFlush);
+	}
+
+	WriteMessage(Category, LogVerbosity, Message);
+#else
+	using namespace OUU::BlueprintRuntime::Private::Logging;
+	// Only format the message if it's needed
+	if (Verbosity == EOUUBlueprintLogVerbosity::Fatal)
+	{
+		HaltOnFatalVerbosity(Verbosity, FormatMessage(Format, FieldNames, FieldValues));
+	}
+#endif
+}
+
+TArray<FString> ULogOpenUnrealUtilitiesLibrary::ParseFormatFieldNames(const FString& Format)
+{
+	TArray<FString> Result;
+	int32 NameStart = INDEX_NONE;
+	for (int32 i = 0; i < Format.Len(); i++)
 	{
-		OUU_BLUEPRINT_LOG(Fatal)
-		OUU_BLUEPRINT_LOG(Warning)
-		OUU_BLUEPRINT_LOG(Display)
-		OUU_BLUEPRINT_LOG(Log)
-		OUU_BLUEPRINT_LOG(Verbose)
-		OUU_BLUEPRINT_LOG(VeryVerbose)
-	default:;
+		const TCHAR Char = Format[i];
+		if (Char == TEXT('{'))
+		{
+			NameStart = i + 1;
+		}
+		else if (Char == TEXT('}') && NameStart != INDEX_NONE)
+		{
+			const FString Name = Format.Mid(NameStart, i - NameStart);
+			if (Name.Len() > 0)
+			{
+				Result.AddUnique(Name);
+			}
+			NameStart = INDEX_NONE;
+		}
 	}
+	return Result;
+}
 
-#undef OUU_BLUEPRINT_LOG
+FString ULogOpenUnrealUtilitiesLibrary::FormatStructuredMessage(
+	const FString& Format,
+	const TArray<FString>& FieldNames,
+	const TArray<FString>& FieldValues)
+{
+	return OUU::BlueprintRuntime::Private::Logging::FormatMessage(Format, FieldNames, FieldValues);
+}
+
+FString ULogOpenUnrealUtilitiesLibrary::MakeStructuredLogLine(
+	FName CategoryName,
+	EOUUBlueprintLogVerbosity Verbosity,
+	const FString& Message,
+	const TArray<FString>& FieldNames,
+	const TArray<FString>& FieldValues)
+{
+	using namespace OUU::BlueprintRuntime::Private::Logging;
+	return MakeJsonLine(CategoryName, ToLogVerbosity(Verbosity), Message, FieldNames, FieldValues);
 }
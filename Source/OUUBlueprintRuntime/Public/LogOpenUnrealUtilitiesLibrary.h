@@ -44,7 +44,13 @@ enum class EOUUBlueprintLogVerbosity : uint8
 };
 
 /**
- * To expose OUU logging to Blueprint
+ * To expose OUU logging to Blueprint.
+ * Log categories are referenced by name. Each name is resolved to a log category object once and then reused, so
+ * the category verbosity can be controlled with the regular "Log <Category> <Verbosity>" console commands and ini
+ * settings like any native category.
+ *
+ * Prefer the "Log To Category (OUU)" node over calling the functions directly: It checks the verbosity before
+ * evaluating the pins that build the message, so filtered messages don't cost any string formatting.
  */
 UCLASS()
 class OUUBLUEPRINTRUNTIME_API ULogOpenUnrealUtilitiesLibrary : public UBlueprintFunctionLibrary
@@ -56,4 +62,64 @@ public:
 		Category = "Open Unreal Utilities|Logging",
 		meta = (DisplayName = "Log (Open Unreal Utilities)"))
 	static void Log(const FString& Message, EOUUBlueprintLogVerbosity Verbosity = EOUUBlueprintLogVerbosity::Log);
+
+	/**
+	 * @returns if messages of the given verbosity are currently written to the log category.
+	 * Always true for Fatal, which halts even if logging is compiled out.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Open Unreal Utilities|Logging", meta = (BlueprintThreadSafe))
+	static bool IsLogCategoryActive(
+		FName CategoryName,
+		EOUUBlueprintLogVerbosity Verbosity = EOUUBlueprintLogVerbosity::Log);
+
+	/**
+	 * Write a message to an arbitrary log category. Empty category names log to LogOpenUnrealUtilities.
+	 * The message is built before the verbosity is checked. Use "Log To Category (OUU)" to avoid that.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "Open Unreal Utilities|Logging",
+		meta = (BlueprintThreadSafe, DisplayName = "Log Prebuilt Message To Category"))
+	static void LogToCategory(
+		FName CategoryName,
+		const FString& Message,
+		EOUUBlueprintLogVerbosity Verbosity = EOUUBlueprintLogVerbosity::Log);
+
+	/**
+	 * Write a message with key/value fields to a log category.
+	 * {Name} arguments in the format string are replaced with the value of the field with the same name.
+	 * If structured logging is enabled (ouu.Log.Structured.Enabled), the entry is also written as a JSON object
+	 * per line to Saved/Logs/<Project>_Structured.jsonl.
+	 * Called by the "Log To Category (OUU)" node, which creates the field pins from the format string.
+	 */
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "Open Unreal Utilities|Logging",
+		meta = (BlueprintInternalUseOnly = "true"))
+	static void LogStructured(
+		FName CategoryName,
+		EOUUBlueprintLogVerbosity Verbosity,
+		const FString& Format,
+		const TArray<FString>& FieldNames,
+		const TArray<FString>& FieldValues);
+
+	/** @returns the names of all {Name} arguments in a log format string in the order of first occurrence. */
+	static TArray<FString> ParseFormatFieldNames(const FString& Format);
+
+	/**
+	 * @returns the format string with all {Name} arguments replaced by the value of the field with the same name.
+	 * Arguments without a matching field are kept as-is.
+	 */
+	static FString FormatStructuredMessage(
+		const FString& Format,
+		const TArray<FString>& FieldNames,
+		const TArray<FString>& FieldValues);
+
+	/** @returns the JSON line LogStructured() writes to the structured log file (without line break). */
+	static FString MakeStructuredLogLine(
+		FName CategoryName,
+		EOUUBlueprintLogVerbosity Verbosity,
+		const FString& Message,
+		const TArray<FString>& FieldNames,
+		const TArray<FString>& FieldValues);
 };
@@ -29,6 +29,8 @@ public class OUUDeveloper : OUUModuleRules
 			"GameplayTags",
 			"GameplayAbilities",
 			"DeveloperSettings",
+			"AssetRegistry",
+			"Json",
 			"EngineSettings",
 			"SourceControl"
 		});
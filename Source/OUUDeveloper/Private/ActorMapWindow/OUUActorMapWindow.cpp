@@ -17,13 +17,16 @@
 #include "GameFramework/PlayerController.h"
 #include "GameplayTagContainer.h"
 #include "GameplayTags/GameplayTagQueryParser.h"
+#include "LogOpenUnrealUtilities.h"
 #include "Misc/RegexUtils.h"
 #include "TextureResource.h"
+#include "UObject/UObjectGlobals.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Input/SNumericEntryBox.h"
+#include "Widgets/Input/SSegmentedControl.h"
 #include "Widgets/Input/SVectorInputBox.h"
 #include "Widgets/Layout/SScaleBox.h"
 #include "Widgets/Layout/SSpacer.h"
@@ -378,6 +381,15 @@ namespace OUU::Developer::ActorMapWindow
 			if (!ensure(TickRate > 0) || InDeltaTime > MagicDeltaTimeLimit)
 				return;
 
+			// The scene capture is scheduled independently of the query updates,
+			// because it's a lot more expensive and usually has to be updated less frequently.
+			UpdateLocalCameraLocation();
+			AccumulatedCaptureTime += InDeltaTime;
+			if (ShouldCapture())
+			{
+				CaptureScene();
+			}
+
 			AccumulatedDeltaTime += InDeltaTime;
 
 			if (AccumulatedDeltaTime >= TickRate)
@@ -387,50 +399,19 @@ namespace OUU::Developer::ActorMapWindow
 					AccumulatedDeltaTime -= TickRate;
 				}
 
-				if (SceneCaptureActor.IsValid())
+				// Start a new pass over all actors for all queries at once.
+				// If the previous pass did not finish yet, we keep working on that one instead.
+				if (!QueryBatch.IsInProgress())
 				{
-					LocalCameraLocation = FVector::ZeroVector;
-					if (bFollowCamera)
-					{
-						bool bSetLocalCameraLocation = false;
-						if (const auto* LocalPlayerController = TargetWorld->GetFirstPlayerController())
-						{
-							if (const APlayerCameraManager* Camera = LocalPlayerController->PlayerCameraManager.Get())
-							{
-								bSetLocalCameraLocation = true;
-								LocalCameraLocation = Camera->GetCameraLocation();
-							}
-						}
-						if (!bSetLocalCameraLocation)
-						{
-#if WITH_EDITOR
-							for (const FLevelEditorViewportClient* LevelVC : GEditor->GetLevelViewportClients())
-							{
-								if (LevelVC && LevelVC->IsPerspective())
-								{
-									LocalCameraLocation = LevelVC->GetViewLocation();
-								}
-							}
-#endif
-						}
-					}
-
-					SceneCaptureActor->SetActorLocation(LocalCameraLocation + ReferencePosition);
-					SceneCaptureActor->GetCaptureComponent2D()->CaptureScene();
+					QueryBatch.Start(TargetWorld.Get(), ActorQueries);
 				}
+			}
 
-				// Update the actor queries
-				UWorld* World = TargetWorld.Get();
-				if (!IsValid(World))
-					return;
-
-				for (auto Query : ActorQueries)
-				{
-					if (!Query.IsValid())
-						continue;
-
-					Query->ExecuteAndCacheQuery(World);
-				}
+			// The query pass may be spread over multiple frames, so we continue it every frame until it's done.
+			// The previous results stay visible in the meantime.
+			if (QueryBatch.IsInProgress())
+			{
+				QueryBatch.Continue(QueryTimeBudgetMs / 1000.0);
 			}
 		}
 
@@ -457,11 +438,12 @@ namespace OUU::Developer::ActorMapWindow
 				UTextureRenderTarget2D::StaticClass(),
 				TEXT("SceneCaptureTextureTarget"));
 			CaptureComponent->TextureTarget = NewObject<UTextureRenderTarget2D>(SceneCaptureActor.Get(), TargetName);
-			CaptureComponent->TextureTarget->InitCustomFormat(CaptureSize, CaptureSize, PF_FloatRGB, false);
+			const int32 CaptureResolution = GetCaptureResolution();
+			CaptureComponent->TextureTarget->InitCustomFormat(CaptureResolution, CaptureResolution, PF_FloatRGB, false);
 			CaptureComponent->TextureTarget->ClearColor = FLinearColor::Black;
 			CaptureComponent->TextureTarget->TargetGamma = 2.2f;
 
-			CaptureComponent->CaptureScene();
+			CaptureScene();
 
 			MapBrush = FSlateBrush();
 			MapBrush.SetResourceObject(CaptureComponent->TextureTarget);
@@ -523,13 +505,98 @@ namespace OUU::Developer::ActorMapWindow
 
 		void SActorMap::OnSetOrthoWidth(float InOrthoSize)
 		{
+			// The ortho width is applied with the next capture, so the overlay stays in sync with the background.
 			OrthoWidth = InOrthoSize;
-			if (SceneCaptureActor.IsValid())
+			RequestCapture();
+		}
+
+		void SActorMap::UpdateLocalCameraLocation()
+		{
+			LocalCameraLocation = FVector::ZeroVector;
+			if (!bFollowCamera || !TargetWorld.IsValid())
+				return;
+
+			if (const auto* LocalPlayerController = TargetWorld->GetFirstPlayerController())
+			{
+				if (const APlayerCameraManager* Camera = LocalPlayerController->PlayerCameraManager.Get())
+				{
+					LocalCameraLocation = Camera->GetCameraLocation();
+					return;
+				}
+			}
+
+#if WITH_EDITOR
+			for (const FLevelEditorViewportClient* LevelVC : GEditor->GetLevelViewportClients())
 			{
-				SceneCaptureActor->GetCaptureComponent2D()->OrthoWidth = OrthoWidth;
+				if (LevelVC && LevelVC->IsPerspective())
+				{
+					LocalCameraLocation = LevelVC->GetViewLocation();
+				}
+			}
+#endif
+		}
+
+		bool SActorMap::ShouldCapture() const
+		{
+			if (!SceneCaptureActor.IsValid())
+				return false;
+
+			if (bCaptureRequested || !CapturedLocation.IsSet())
+				return true;
+
+			switch (CaptureMode)
+			{
+			case EActorMapCaptureMode::Interval: return AccumulatedCaptureTime >= CaptureInterval;
+			case EActorMapCaptureMode::CameraMovement:
+			{
+				const FVector NewCaptureLocation = ReferencePosition + LocalCameraLocation;
+				return FVector::DistSquared(NewCaptureLocation, CapturedLocation.GetValue())
+					> FMath::Square(CaptureMoveThreshold);
+			}
+			case EActorMapCaptureMode::Manual:
+			default: return false;
 			}
 		}
 
+		void SActorMap::CaptureScene()
+		{
+			bCaptureRequested = false;
+			AccumulatedCaptureTime = 0.f;
+
+			if (!SceneCaptureActor.IsValid())
+				return;
+
+			auto* CaptureComponent = SceneCaptureActor->GetCaptureComponent2D();
+			auto* TextureTarget = CaptureComponent->TextureTarget.Get();
+			if (!IsValid(TextureTarget))
+				return;
+
+			// Scale the resolution with the zoom level, so zoomed-in maps don't capture more pixels than needed
+			const int32 CaptureResolution = GetCaptureResolution();
+			if (TextureTarget->SizeX != CaptureResolution || TextureTarget->SizeY != CaptureResolution)
+			{
+				TextureTarget->ResizeTarget(CaptureResolution, CaptureResolution);
+				MapBrush.ImageSize = FVector2D(CaptureResolution, CaptureResolution);
+			}
+
+			const FVector NewCaptureLocation = ReferencePosition + LocalCameraLocation;
+			SceneCaptureActor->SetActorLocation(NewCaptureLocation);
+			CaptureComponent->OrthoWidth = OrthoWidth;
+			CaptureComponent->CaptureScene();
+
+			CapturedLocation = NewCaptureLocation;
+			CapturedOrthoWidth = OrthoWidth;
+		}
+
+		int32 SActorMap::GetCaptureResolution() const
+		{
+			const int32 DesiredResolution = FMath::CeilToInt32(OrthoWidth / UnitsPerTexel);
+			return FMath::Clamp(
+				static_cast<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(DesiredResolution, 1))),
+				MinCaptureSize,
+				MaxCaptureSize);
+		}
+
 		void SActorMap::AddActorQuery()
 		{
 			const int32 NewIndex = ActorQueries.Add(MakeShared<FActorQuery>());
@@ -545,6 +612,8 @@ namespace OUU::Developer::ActorMapWindow
 			if (ActorQueries.Num() > 0)
 			{
 				ActorQueries.Pop();
+				// Removed queries would be ignored by a running pass, but there is no point in evaluating them
+				QueryBatch.Cancel();
 			}
 			if (ActorQueryListWidget.IsValid())
 			{
@@ -603,7 +672,7 @@ namespace OUU::Developer::ActorMapWindow
 		[
 			DetailsColumns.MakeSimpleDetailsSplitter(
 				INVTEXT("Tick Rate"),
-				INVTEXT("Time between two map updates in seconds"),
+				INVTEXT("Time between two actor query updates in seconds"),
 				SNew(SNumericEntryBox<float>)
 					.Value(this, &SActorMap::OnGetOptionalTickRate)
 					.OnValueChanged(this, &SActorMap::OnSetTickRate)
@@ -611,6 +680,83 @@ namespace OUU::Developer::ActorMapWindow
 		]
 		+ SVerticalBox::Slot()
 		.AutoHeight()
+		[
+			DetailsColumns.MakeSimpleDetailsSplitter(
+				INVTEXT("Capture Mode"),
+				INVTEXT("When to update the scene capture in the background of the map. Independent of the tick rate "
+					"of the actor queries."),
+				SNew(SSegmentedControl<EActorMapCaptureMode>)
+					.Value(this, &SActorMap::GetCaptureMode)
+					.OnValueChanged(this, &SActorMap::OnSetCaptureMode)
+				+ SSegmentedControl<EActorMapCaptureMode>::Slot(EActorMapCaptureMode::Interval)
+					.Text(INVTEXT("Interval"))
+					.ToolTip(INVTEXT("Capture in a fixed interval"))
+				+ SSegmentedControl<EActorMapCaptureMode>::Slot(EActorMapCaptureMode::CameraMovement)
+					.Text(INVTEXT("Movement"))
+					.ToolTip(INVTEXT("Capture when the origin moved further than the movement threshold"))
+				+ SSegmentedControl<EActorMapCaptureMode>::Slot(EActorMapCaptureMode::Manual)
+					.Text(INVTEXT("Manual"))
+					.ToolTip(INVTEXT("Only capture when pressing the refresh button"))
+			)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			DetailsColumns.MakeSimpleDetailsSplitter(
+				INVTEXT("Capture Interval"),
+				INVTEXT("Time between two scene captures in seconds (only used in interval capture mode)"),
+				SNew(SNumericEntryBox<float>)
+					.Value(this, &SActorMap::OnGetOptionalCaptureInterval)
+					.OnValueChanged(this, &SActorMap::OnSetCaptureInterval)
+			)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			DetailsColumns.MakeSimpleDetailsSplitter(
+				INVTEXT("Capture Movement Threshold"),
+				INVTEXT("Distance the origin has to move before the scene is captured again (only used in movement "
+					"capture mode)"),
+				SNew(SNumericEntryBox<float>)
+					.Value(this, &SActorMap::OnGetOptionalCaptureMoveThreshold)
+					.OnValueChanged(this, &SActorMap::OnSetCaptureMoveThreshold)
+			)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			DetailsColumns.MakeSimpleDetailsSplitter(
+				INVTEXT("Capture Units per Texel"),
+				INVTEXT("World units covered by a single texel of the scene capture. The capture resolution is derived "
+					"from this and the ortho width, so zooming in reduces the capture cost."),
+				SNew(SNumericEntryBox<float>)
+					.Value(this, &SActorMap::OnGetOptionalUnitsPerTexel)
+					.OnValueChanged(this, &SActorMap::OnSetUnitsPerTexel)
+			)
+		]
+		+ SVerticalBox::Slot()
+		.Padding(0.f, 4.f)
+		.AutoHeight()
+		[
+			SNew(SButton)
+				.Text(INVTEXT("Refresh Capture"))
+				.OnPressed(this, &SActorMap::RequestCapture)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			DetailsColumns.MakeSimpleDetailsSplitter(
+				INVTEXT("Query Time Budget (ms)"),
+				INVTEXT("Maximum time per frame spent evaluating actor queries. If a pass over all actors takes longer, "
+					"it's spread over multiple frames and the previous results are displayed in the meantime. "
+					"0 means unlimited."),
+				SNew(SNumericEntryBox<float>)
+					.Value(this, &SActorMap::OnGetOptionalQueryTimeBudgetMs)
+					.OnValueChanged(this, &SActorMap::OnSetQueryTimeBudgetMs)
+			)
+		]
+		+ SVerticalBox::Slot()
+		.AutoHeight()
 		[
 			DetailsColumns.MakeSimpleDetailsSplitter(
 				INVTEXT("Draw Labels"),
@@ -683,7 +829,7 @@ namespace OUU::Developer::ActorMapWindow
 		[
 			SNew(SActorLocationOverlay)
 				.ActorQueries(&ActorQueries)
-				.MapSize(this, &SActorMap::GetOrthoWidth)
+				.MapSize(this, &SActorMap::GetCapturedOrthoWidth)
 				.DrawLabels(this, &SActorMap::GetDrawLabelsCheckBoxState)
 				.ReferencePosition(this, &SActorMap::GetReferencePosition)
 		];
@@ -716,60 +862,136 @@ namespace OUU::Developer::ActorMapWindow
 
 	void TryInvokeTab() { FGlobalTabmanager::Get()->TryInvokeTab(GTabName); }
 
-	template <typename ExitClass>
-	bool ObjectMatchesClassSearchString(const UObject* Object, const FString& SearchName)
+	namespace Private
 	{
-		if (!IsValid(Object))
-			return false;
+		/**
+		 * Incremented whenever class pointers may have become stale (garbage collection, hot reload) to invalidate the
+		 * memoized class filter results of all queries.
+		 */
+		uint32 GClassFilterGeneration = 1;
 
-		auto* Class = Object->GetClass();
-		// Iterate through all parent classes to find a match
-		while (Class != UStruct::StaticClass() && Class != UClass::StaticClass() && Class != ExitClass::StaticClass())
+		void RegisterClassFilterInvalidation()
 		{
-			if (Class->GetName().Equals(SearchName, ESearchCase::IgnoreCase))
-				return true;
-			Class = Class->GetSuperClass();
+			static bool bRegistered = false;
+			if (bRegistered)
+				return;
+
+			bRegistered = true;
+			FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic([]() { ++GClassFilterGeneration; });
+			FCoreUObjectDelegates::ReloadCompleteDelegate.AddStatic([](EReloadCompleteReason) {
+				++GClassFilterGeneration;
+			});
 		}
 
-		return false;
+		template <typename ExitClass>
+		bool ClassMatchesFilter(const UClass* Class, FName FilterName, TMap<const UClass*, bool>& InOutMemo)
+		{
+			if (Class == nullptr || Class == UStruct::StaticClass() || Class == UClass::StaticClass()
+				|| Class == ExitClass::StaticClass())
+				return false;
+
+			if (const bool* MemoizedResult = InOutMemo.Find(Class))
+				return *MemoizedResult;
+
+			// FName comparison is case insensitive, same as the string comparison used for the filter input.
+			const bool bResult = Class->GetFName() == FilterName
+				|| ClassMatchesFilter<ExitClass>(Class->GetSuperClass(), FilterName, InOutMemo);
+			InOutMemo.Add(Class, bResult);
+			return bResult;
+		}
+	} // namespace Private
+
+	//------------------------------------------------------------------------
+	// FActorQuery::FActorData
+	//------------------------------------------------------------------------
+
+	FActorQuery::FActorData::FActorData(const AActor* InActor) :
+		Actor(InActor), Name(InActor->GetActorNameOrLabel())
+	{
 	}
 
+	const FString& FActorQuery::FActorData::GetLowerCaseName() const
+	{
+		if (!LowerCaseName.IsSet())
+		{
+			LowerCaseName = Name.ToLower();
+		}
+		return LowerCaseName.GetValue();
+	}
+
+	const FGameplayTagContainer* FActorQuery::FActorData::GetOwnedTags() const
+	{
+		if (!bOwnedTagsResolved)
+		{
+			bOwnedTagsResolved = true;
+			if (const UAbilitySystemComponent* AbilitySystemComponent =
+					Actor->FindComponentByClass<UAbilitySystemComponent>())
+			{
+				AbilitySystemComponent->GetOwnedGameplayTags(OUT OwnedTags.Emplace());
+			}
+		}
+		return OwnedTags.GetPtrOrNull();
+	}
+
+	//------------------------------------------------------------------------
+	// FActorQuery
+	//------------------------------------------------------------------------
+
 	bool FActorQuery::MatchesActor(const AActor* Actor) const
 	{
 		if (!IsValid(Actor))
 			return false;
 
+		CompileFilters();
+		return MatchesActor(FActorData(Actor));
+	}
+
+	bool FActorQuery::MatchesActor(const FActorData& ActorData, bool bSkipNameFilter) const
+	{
 		bool bAtLeastOneFilterActive = false;
 
-		const FString ActorName = Actor->GetActorNameOrLabel();
-		if (!NameFilter.IsEmpty())
+		if (!CompiledNameFilter.IsEmpty())
 		{
 			bAtLeastOneFilterActive = true;
-			if (!ActorName.Contains(NameFilter))
+			if (!bSkipNameFilter
+				&& !ActorData.GetLowerCaseName().Contains(CompiledNameFilter, ESearchCase::CaseSensitive))
 				return false;
 		}
 
-		if (!NameRegexPattern.IsEmpty())
+		if (CompiledNameRegex.IsSet())
 		{
 			bAtLeastOneFilterActive = true;
-			if (!OUU::Runtime::RegexUtils::MatchesRegex(NameRegexPattern, ActorName))
+			// Only non-empty matches count (same as FOUUPatternSet), otherwise patterns like "x*" would match any name
+			OUU::Runtime::FRegexMatchRange Matches(CompiledNameRegex.GetValue(), ActorData.Name);
+			if (Matches.begin() == Matches.end())
 				return false;
 		}
 
 		if (ActorClassName.IsEmpty() == false)
 		{
 			bAtLeastOneFilterActive = true;
-			if (!ObjectMatchesClassSearchString<AActor>(Actor, ActorClassName))
+			if (CompiledActorClassName.IsNone()
+				|| !Private::ClassMatchesFilter<AActor>(
+					ActorData.Actor->GetClass(),
+					CompiledActorClassName,
+					ActorClassMatches))
 				return false;
 		}
 
 		if (ComponentClassName.IsEmpty() == false)
 		{
 			bAtLeastOneFilterActive = true;
+			if (CompiledComponentClassName.IsNone())
+				return false;
+
 			bool bAtLeastOneComponentMatches = false;
-			for (auto& Component : Actor->GetComponents())
+			for (const UActorComponent* Component : ActorData.Actor->GetComponents())
 			{
-				if (ObjectMatchesClassSearchString<UActorComponent>(Component, ComponentClassName))
+				if (IsValid(Component)
+					&& Private::ClassMatchesFilter<UActorComponent>(
+						Component->GetClass(),
+						CompiledComponentClassName,
+						ComponentClassMatches))
 				{
 					bAtLeastOneComponentMatches = true;
 					break;
@@ -782,18 +1004,9 @@ namespace OUU::Developer::ActorMapWindow
 		if (!ActorTagQuery.IsEmpty())
 		{
 			bAtLeastOneFilterActive = true;
-			if (const UAbilitySystemComponent* AbilitySystemComponent =
-					Actor->FindComponentByClass<UAbilitySystemComponent>())
-			{
-				FGameplayTagContainer OwnedTags;
-				AbilitySystemComponent->GetOwnedGameplayTags(OUT OwnedTags);
-				if (!ActorTagQuery.Matches(OwnedTags))
-					return false;
-			}
-			else
-			{
+			const FGameplayTagContainer* OwnedTags = ActorData.GetOwnedTags();
+			if (OwnedTags == nullptr || !ActorTagQuery.Matches(*OwnedTags))
 				return false;
-			}
 		}
 
 		return bAtLeastOneFilterActive;
@@ -805,12 +1018,13 @@ namespace OUU::Developer::ActorMapWindow
 		if (!IsValid(World))
 			return ResultList;
 
+		CompileFilters();
 		for (AActor* Actor : TActorRange<AActor>(World))
 		{
 			if (!IsValid(Actor))
 				continue;
 
-			if (MatchesActor(Actor))
+			if (MatchesActor(FActorData(Actor)))
 			{
 				ResultList.Actors.Add(Actor);
 			}
@@ -818,6 +1032,172 @@ namespace OUU::Developer::ActorMapWindow
 		return ResultList;
 	}
 
+	void FActorQuery::CompileFilters() const
+	{
+		CompiledNameFilter = NameFilter.ToLower();
+
+		// Names that were never created can't be the name of any loaded class, so we can skip adding them.
+		// If a matching class is loaded later, the name is resolved the next time the filters are compiled.
+		const FName NewActorClassName = FName(*ActorClassName, FNAME_Find);
+		const FName NewComponentClassName = FName(*ComponentClassName, FNAME_Find);
+
+		Private::RegisterClassFilterInvalidation();
+		if (ClassMatchesGeneration != Private::GClassFilterGeneration)
+		{
+			ClassMatchesGeneration = Private::GClassFilterGeneration;
+			ActorClassMatches.Reset();
+			ComponentClassMatches.Reset();
+		}
+		if (NewActorClassName != CompiledActorClassName)
+		{
+			CompiledActorClassName = NewActorClassName;
+			ActorClassMatches.Reset();
+		}
+		if (NewComponentClassName != CompiledComponentClassName)
+		{
+			CompiledComponentClassName = NewComponentClassName;
+			ComponentClassMatches.Reset();
+		}
+
+		if (NameRegexPattern.IsEmpty())
+		{
+			CompiledNameRegexPattern.Reset();
+			CompiledNameRegex.Reset();
+		}
+		else if (!CompiledNameRegex.IsSet() || CompiledNameRegexPattern != NameRegexPattern)
+		{
+			CompiledNameRegexPattern = NameRegexPattern;
+			CompiledNameRegex.Emplace(NameRegexPattern);
+		}
+	}
+
+	//------------------------------------------------------------------------
+	// FActorQueryBatch
+	//------------------------------------------------------------------------
+
+	void FActorQueryBatch::Start(UWorld* InWorld, TConstArrayView<TSharedPtr<FActorQuery>> InQueries)
+	{
+		Cancel();
+		if (!IsValid(InWorld))
+			return;
+
+		World = InWorld;
+		for (const auto& Query : InQueries)
+		{
+			if (!Query.IsValid())
+				continue;
+
+			Query->CompileFilters();
+			const int32 QueryIdx = Queries.Add(Query);
+
+			// Regex patterns are matched per query with the pattern that was already compiled by the query.
+			const bool bHasNameFilter = !Query->NameFilter.IsEmpty();
+			QueryHasNameFilter.Add(bHasNameFilter);
+			if (bHasNameFilter)
+			{
+				NameFilterPatterns.AddSubstring(Query->NameFilter);
+				NameFilterPatternQueries.Add(QueryIdx);
+			}
+		}
+		PendingResults.SetNum(Queries.Num());
+
+		// Only gather the actor pointers up-front, so actors that are destroyed while the pass is spread over multiple
+		// frames are skipped instead of invalidating the iteration.
+		for (AActor* Actor : TActorRange<AActor>(InWorld))
+		{
+			PendingActors.Add(Actor);
+		}
+		NextActorIndex = 0;
+	}
+
+	bool FActorQueryBatch::Continue(double TimeBudgetSeconds)
+	{
+		if (!IsInProgress())
+			return false;
+
+		if (!World.IsValid())
+		{
+			Cancel();
+			return false;
+		}
+
+		const bool bHasBudget = TimeBudgetSeconds > 0.0;
+		const double EndTime = FPlatformTime::Seconds() + TimeBudgetSeconds;
+		// Checking the time is not free, so we only do it every couple of actors.
+		constexpr int32 NumActorsBetweenTimeChecks = 64;
+
+		const int32 NumQueries = Queries.Num();
+		TArray<int32> MatchedPatterns;
+		TBitArray<> MatchedNameFilters;
+		while (NextActorIndex < PendingActors.Num())
+		{
+			AActor* Actor = PendingActors[NextActorIndex++].Get();
+			if (IsValid(Actor))
+			{
+				const FActorQuery::FActorData ActorData(Actor);
+
+				// Match the name filters of all queries at once
+				MatchedNameFilters.Init(false, NumQueries);
+				NameFilterPatterns.MatchAll(ActorData.Name, MatchedPatterns);
+				for (const int32 PatternIdx : MatchedPatterns)
+				{
+					MatchedNameFilters[NameFilterPatternQueries[PatternIdx]] = true;
+				}
+
+				for (int32 QueryIdx = 0; QueryIdx < NumQueries; ++QueryIdx)
+				{
+					if (QueryHasNameFilter[QueryIdx] && !MatchedNameFilters[QueryIdx])
+						continue;
+
+					const TSharedPtr<FActorQuery> Query = Queries[QueryIdx].Pin();
+					if (Query.IsValid() && Query->MatchesActor(ActorData, true))
+					{
+						PendingResults[QueryIdx].Actors.Add(Actor);
+					}
+				}
+			}
+
+			if (bHasBudget && (NextActorIndex % NumActorsBetweenTimeChecks) == 0 && FPlatformTime::Seconds() > EndTime)
+				return false;
+		}
+
+		for (int32 QueryIdx = 0; QueryIdx < NumQueries; ++QueryIdx)
+		{
+			if (const TSharedPtr<FActorQuery> Query = Queries[QueryIdx].Pin())
+			{
+				Query->CachedQueryResult = MoveTemp(PendingResults[QueryIdx]);
+			}
+		}
+		Cancel();
+		return true;
+	}
+
+	void FActorQueryBatch::Cancel()
+	{
+		World.Reset();
+		Queries.Reset();
+		PendingResults.Reset();
+		PendingActors.Reset();
+		NextActorIndex = INDEX_NONE;
+		NameFilterPatterns.Reset();
+		NameFilterPatternQueries.Reset();
+		QueryHasNameFilter.Reset();
+	}
+
+	float FActorQueryBatch::GetProgress() const
+	{
+		if (!IsInProgress() || PendingActors.Num() == 0)
+			return 1.f;
+		return static_cast<float>(NextActorIndex) / PendingActors.Num();
+	}
+
+	void FActorQueryBatch::ExecuteAndCacheQueries(UWorld* World, TConstArrayView<TSharedPtr<FActorQuery>> Queries)
+	{
+		FActorQueryBatch Batch;
+		Batch.Start(World, Queries);
+		Batch.Continue(0.0);
+	}
+
 	//------------------------------------------------------------------------
 	// Console command
 	//------------------------------------------------------------------------
@@ -827,6 +1207,42 @@ namespace OUU::Developer::ActorMapWindow
 		TEXT("Open an actor map for the current world (game or editor)"),
 		FConsoleCommandDelegate::CreateStatic(TryInvokeTab));
 
+	static FAutoConsoleCommandWithWorldAndArgs BenchmarkActorQueryCommand(
+		TEXT("ouu.Debug.ActorMap.BenchmarkQuery"),
+		TEXT("Time passes of an actor query over all actors of the current world. "
+			 "Args: <ActorClassName> [ComponentClassName] [NumPasses=10]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+			if (Args.Num() < 1 || !IsValid(World))
+				return;
+
+			const TSharedPtr<FActorQuery> Query = MakeShared<FActorQuery>();
+			Query->ActorClassName = Args[0];
+			Query->ComponentClassName = Args.IsValidIndex(1) ? Args[1] : FString();
+			const int32 NumPasses = Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 10;
+
+			int32 NumActors = 0;
+			for (TActorIterator<AActor> It(World); It; ++It)
+			{
+				NumActors++;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumPasses; i++)
+			{
+				FActorQueryBatch::ExecuteAndCacheQueries(World, {Query});
+			}
+			const double AverageTimeMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / FMath::Max(NumPasses, 1);
+
+			UE_LOG(
+				LogOpenUnrealUtilities,
+				Log,
+				TEXT("Actor query pass over %i actors took %.3f ms on average (%i passes, %i matches)"),
+				NumActors,
+				AverageTimeMs,
+				NumPasses,
+				Query->CachedQueryResult.Actors.Num());
+		}));
+
 } // namespace OUU::Developer::ActorMapWindow
 
 UE_DISABLE_OPTIMIZATION
@@ -13,6 +13,17 @@ namespace OUU::Developer::ActorMapWindow::Private
 {
 	extern FText GInvalidText;
 
+	/** When the scene capture in the background of the actor map is updated. */
+	enum class EActorMapCaptureMode : uint8
+	{
+		/** Capture in a fixed interval that is independent of the query tick rate. */
+		Interval,
+		/** Capture whenever the capture location moved further than a threshold. */
+		CameraMovement,
+		/** Only capture when explicitly requested via the refresh button. */
+		Manual
+	};
+
 	/**
 	 * The data and core functionality of the actor map window:
 	 * SActorMap takes care of creating objects, widgets and performing actor queries in tick.
@@ -51,12 +62,55 @@ namespace OUU::Developer::ActorMapWindow::Private
 		//------------------------
 
 		float OrthoWidth = 10000.f;
-		float CaptureSize = 2048.f;
 		FORCEINLINE TOptional<float> OnGetOptionalOrthoWidth() const { return OrthoWidth; }
-		FORCEINLINE float GetOrthoWidth() const { return OrthoWidth; }
 
 		void OnSetOrthoWidth(float InOrthoSize);
 
+		//------------------------
+		// Scene capture
+		//------------------------
+
+		static constexpr int32 MinCaptureSize = 256;
+		static constexpr int32 MaxCaptureSize = 2048;
+
+		EActorMapCaptureMode CaptureMode = EActorMapCaptureMode::Interval;
+		FORCEINLINE EActorMapCaptureMode GetCaptureMode() const { return CaptureMode; }
+		FORCEINLINE void OnSetCaptureMode(EActorMapCaptureMode InMode) { CaptureMode = InMode; }
+
+		float CaptureInterval = 1.f;
+		FORCEINLINE TOptional<float> OnGetOptionalCaptureInterval() const { return CaptureInterval; }
+		FORCEINLINE void OnSetCaptureInterval(float InInterval) { CaptureInterval = FMath::Max(InInterval, 0.f); }
+
+		float CaptureMoveThreshold = 1000.f;
+		FORCEINLINE TOptional<float> OnGetOptionalCaptureMoveThreshold() const { return CaptureMoveThreshold; }
+		FORCEINLINE void OnSetCaptureMoveThreshold(float InThreshold)
+		{
+			CaptureMoveThreshold = FMath::Max(InThreshold, 0.f);
+		}
+
+		/** World units covered by a single texel of the capture. Determines the capture resolution for an ortho width. */
+		float UnitsPerTexel = 5.f;
+		FORCEINLINE TOptional<float> OnGetOptionalUnitsPerTexel() const { return UnitsPerTexel; }
+		FORCEINLINE void OnSetUnitsPerTexel(float InUnitsPerTexel)
+		{
+			UnitsPerTexel = FMath::Max(InUnitsPerTexel, 0.1f);
+			RequestCapture();
+		}
+
+		float AccumulatedCaptureTime = 0.f;
+		bool bCaptureRequested = true;
+		FORCEINLINE void RequestCapture() { bCaptureRequested = true; }
+
+		/** Location and ortho width of the last capture. The overlay is drawn relative to these. */
+		TOptional<FVector> CapturedLocation;
+		float CapturedOrthoWidth = 10000.f;
+		FORCEINLINE float GetCapturedOrthoWidth() const { return CapturedOrthoWidth; }
+
+		void UpdateLocalCameraLocation();
+		bool ShouldCapture() const;
+		void CaptureScene();
+		int32 GetCaptureResolution() const;
+
 		FSplitterColumnSizeData MainColumns{0.75f};
 		FSplitterColumnSizeData DetailsColumns{0.6f};
 
@@ -68,10 +122,14 @@ namespace OUU::Developer::ActorMapWindow::Private
 		FORCEINLINE void OnSetPosition(float NewValue, ETextCommit::Type CommitInfo, int32 Axis)
 		{
 			ReferencePosition.Component(Axis) = NewValue;
+			RequestCapture();
 		}
 
 		FVector LocalCameraLocation = FVector::ZeroVector;
-		FORCEINLINE FVector GetReferencePosition() const { return ReferencePosition + LocalCameraLocation; }
+		FORCEINLINE FVector GetReferencePosition() const
+		{
+			return CapturedLocation.Get(ReferencePosition + LocalCameraLocation);
+		}
 
 #define DEFINE_CHECKBOX_BOOL(BoolName, DefaultValue)                                                                   \
 	bool b##BoolName = DefaultValue;                                                                                   \
@@ -94,7 +152,12 @@ namespace OUU::Developer::ActorMapWindow::Private
 		FORCEINLINE float GetTickRate() const { return TickRate; }
 		FORCEINLINE void OnSetTickRate(float InTickRate) { TickRate = InTickRate; }
 
+		float QueryTimeBudgetMs = 2.f;
+		FORCEINLINE TOptional<float> OnGetOptionalQueryTimeBudgetMs() const { return QueryTimeBudgetMs; }
+		FORCEINLINE void OnSetQueryTimeBudgetMs(float InBudget) { QueryTimeBudgetMs = FMath::Max(InBudget, 0.f); }
+
 		TArray<TSharedPtr<FActorQuery>> ActorQueries;
+		FActorQueryBatch QueryBatch;
 
 		void AddActorQuery();
 		void RemoveLastActorQuery();
@@ -0,0 +1,136 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "GarbageCollectionHistory.h"
+
+#include "Algo/Sort.h"
+#include "UObject/UObjectIterator.h"
+
+FGarbageCollectionHistory::FGarbageCollectionHistory(int32 InHistorySize) : HistorySize(FMath::Max(InHistorySize, 2))
+{
+	SampleTimestamps.SetNumZeroed(HistorySize);
+}
+
+void FGarbageCollectionHistory::SampleLiveObjects()
+{
+	TMap<const UClass*, int32> LiveCounts;
+	LiveCounts.Reserve(Classes.Num());
+	// Skip objects that are only pending purge
+	for (TObjectIterator<UObject> It(RF_ClassDefaultObject, true, EInternalObjectFlags::Unreachable); It; ++It)
+	{
+		LiveCounts.FindOrAdd(It->GetClass(), 0) += 1;
+	}
+	AddSample(LiveCounts, FPlatformTime::Seconds());
+}
+
+void FGarbageCollectionHistory::AddSample(const TMap<const UClass*, int32>& LiveCounts, double Timestamp)
+{
+	const int32 WriteIndex = TotalNumSamples % HistorySize;
+	TotalNumSamples++;
+	SampleTimestamps[WriteIndex] = Timestamp;
+
+	for (const auto& Entry : LiveCounts)
+	{
+		FClassHistory& History = Classes.FindOrAdd(FObjectKey(Entry.Key));
+		if (History.LiveCounts.Num() == 0)
+		{
+			History.ClassName = GetPathNameSafe(Entry.Key);
+			History.LiveCounts.SetNumZeroed(HistorySize);
+		}
+		History.LiveCounts[WriteIndex] = Entry.Value;
+		History.NumSamples = FMath::Min(History.NumSamples + 1, HistorySize);
+		History.LastSampleNumber = TotalNumSamples;
+	}
+
+	for (auto It = Classes.CreateIterator(); It; ++It)
+	{
+		FClassHistory& History = It.Value();
+		if (History.LastSampleNumber == TotalNumSamples)
+			continue;
+
+		History.LiveCounts[WriteIndex] = 0;
+		History.NumSamples = FMath::Min(History.NumSamples + 1, HistorySize);
+		History.LastSampleNumber = TotalNumSamples;
+
+		// Drop classes that had no live objects for the entire history to keep the memory bounded.
+		const bool bHadLiveObjects = History.LiveCounts.ContainsByPredicate([](int32 Count) { return Count > 0; });
+		if (History.NumSamples == HistorySize && !bHadLiveObjects)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TArray<FGarbageCollectionHistory::FLeakSuspect> FGarbageCollectionHistory::FindLeakSuspects(
+	int32 MinPasses,
+	double MinGrowthPerPass,
+	double MinLinearity) const
+{
+	MinPasses = FMath::Max(MinPasses, 2);
+
+	TArray<FLeakSuspect> Suspects;
+	for (const auto& Entry : Classes)
+	{
+		const FClassHistory& History = Entry.Value;
+		const int32 N = History.NumSamples;
+		if (N < MinPasses)
+			continue;
+
+		const int32 FirstCount = History.LiveCounts[GetRingIndex(N, 0)];
+		const int32 LastCount = History.LiveCounts[GetRingIndex(N, N - 1)];
+		if (LastCount <= FirstCount)
+			continue;
+
+		// Least squares regression of count over pass index
+		const double MeanX = (N - 1) * 0.5;
+		double MeanY = 0.0;
+		for (int32 i = 0; i < N; i++)
+		{
+			MeanY += History.LiveCounts[GetRingIndex(N, i)];
+		}
+		MeanY /= N;
+
+		double Sxx = 0.0, Sxy = 0.0, Syy = 0.0;
+		for (int32 i = 0; i < N; i++)
+		{
+			const double Dx = i - MeanX;
+			const double Dy = History.LiveCounts[GetRingIndex(N, i)] - MeanY;
+			Sxx += Dx * Dx;
+			Sxy += Dx * Dy;
+			Syy += Dy * Dy;
+		}
+
+		const double Slope = Sxy / Sxx;
+		const double Linearity = Syy > 0.0 ? (Sxy * Sxy) / (Sxx * Syy) : 0.0;
+		if (Slope < MinGrowthPerPass || Linearity < MinLinearity)
+			continue;
+
+		FLeakSuspect& Suspect = Suspects.AddDefaulted_GetRef();
+		Suspect.ClassName = History.ClassName;
+		Suspect.NumSamples = N;
+		Suspect.FirstCount = FirstCount;
+		Suspect.LastCount = LastCount;
+		Suspect.GrowthPerPass = Slope;
+		Suspect.Linearity = Linearity;
+
+		const double Duration = SampleTimestamps[GetRingIndex(N, N - 1)] - SampleTimestamps[GetRingIndex(N, 0)];
+		Suspect.GrowthPerMinute = Duration > 0.0 ? Slope * (N - 1) / Duration * 60.0 : 0.0;
+	}
+
+	Algo::Sort(Suspects, [](const FLeakSuspect& A, const FLeakSuspect& B) {
+		return A.GrowthPerPass > B.GrowthPerPass;
+	});
+	return Suspects;
+}
+
+void FGarbageCollectionHistory::Reset()
+{
+	TotalNumSamples = 0;
+	Classes.Reset();
+	SampleTimestamps.Init(0.0, HistorySize);
+}
+
+int32 FGarbageCollectionHistory::GetRingIndex(int32 NumSamplesBack, int32 Index) const
+{
+	check(NumSamplesBack <= HistorySize && Index < NumSamplesBack);
+	return (TotalNumSamples - NumSamplesBack + Index) % HistorySize;
+}
@@ -7,6 +7,7 @@
 #include "Components/Widget.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Engine/Engine.h"
+#include "GarbageCollectionHistory.h"
 #include "LogOpenUnrealUtilities.h"
 #include "TimerManager.h"
 
@@ -16,6 +17,28 @@ static TAutoConsoleVariable<bool> bCVarAccumulateGCCounts(
 	TEXT("If true GC reports are only logged at the moment dumping is shut off. Otherwise every GC call triggers a log "
 		 "dump"));
 
+static TAutoConsoleVariable<int32> CVarGCHistorySize(
+	TEXT("ouu.Debug.GC.History.Size"),
+	32,
+	TEXT("Number of garbage collection passes kept in the live object count history. Applied when the history is "
+		 "started."));
+
+static TAutoConsoleVariable<int32> CVarLeakSuspectMinPasses(
+	TEXT("ouu.Debug.GC.History.LeakSuspectMinPasses"),
+	8,
+	TEXT("Minimum number of sampled garbage collection passes before a class can be flagged as leak suspect"));
+
+static TAutoConsoleVariable<float> CVarLeakSuspectMinGrowth(
+	TEXT("ouu.Debug.GC.History.LeakSuspectMinGrowth"),
+	1.f,
+	TEXT("Minimum growth of live objects per garbage collection pass for a class to be flagged as leak suspect"));
+
+static TAutoConsoleVariable<float> CVarLeakSuspectMinLinearity(
+	TEXT("ouu.Debug.GC.History.LeakSuspectMinLinearity"),
+	0.8f,
+	TEXT("Minimum coefficient of determination (0-1) of the linear live object count trend for a class to be flagged "
+		 "as leak suspect. Higher values only report classes with steady growth."));
+
 // Right now we only track the count, but it would be great to extend this
 // with some other metrics that we can still get during GC.
 struct FGarbageCollectionStats
@@ -240,6 +263,91 @@ public:
 
 TUniquePtr<FGarbageCollectionListener> FGarbageCollectionListener::GGarbageCollectionListener;
 
+/**
+ * Samples per-class live object counts into a history after every garbage collection.
+ */
+class FGarbageCollectionHistoryTracker
+{
+private:
+	static TUniquePtr<FGarbageCollectionHistoryTracker> GTracker;
+
+	FGarbageCollectionHistory History;
+	FDelegateHandle PostGarbageCollectHandle;
+
+public:
+	FGarbageCollectionHistoryTracker() : History(CVarGCHistorySize.GetValueOnGameThread())
+	{
+		PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(
+			this,
+			&FGarbageCollectionHistoryTracker::HandlePostGarbageCollect);
+		// Initial sample, so the first GC pass already yields a delta
+		History.SampleLiveObjects();
+	}
+
+	~FGarbageCollectionHistoryTracker()
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	}
+
+	static void Start()
+	{
+		if (!GTracker.IsValid())
+		{
+			GTracker = MakeUnique<FGarbageCollectionHistoryTracker>();
+		}
+	}
+
+	static void Stop() { GTracker.Reset(); }
+
+	static void DumpLeakSuspects(int32 MaxNumSuspects)
+	{
+		if (!GTracker.IsValid())
+		{
+			UE_LOG(
+				LogOpenUnrealUtilities,
+				Warning,
+				TEXT("GC history is not running. Start it with ouu.Debug.GC.History.Start"));
+			return;
+		}
+
+		const FGarbageCollectionHistory& History = GTracker->History;
+		const auto Suspects = History.FindLeakSuspects(
+			CVarLeakSuspectMinPasses.GetValueOnGameThread(),
+			CVarLeakSuspectMinGrowth.GetValueOnGameThread(),
+			CVarLeakSuspectMinLinearity.GetValueOnGameThread());
+
+		UE_LOG(LogOpenUnrealUtilities, Log, TEXT("--- Garbage Collection Leak Suspects ---"));
+		UE_LOG(
+			LogOpenUnrealUtilities,
+			Log,
+			TEXT("%i suspects in %i tracked classes over %i sampled GC passes (history size %i):"),
+			Suspects.Num(),
+			History.NumTrackedClasses(),
+			History.NumSamples(),
+			History.GetHistorySize());
+		for (int32 i = 0; i < FMath::Min(Suspects.Num(), MaxNumSuspects); i++)
+		{
+			const auto& Suspect = Suspects[i];
+			UE_LOG(
+				LogOpenUnrealUtilities,
+				Log,
+				TEXT("\t- %s: %i -> %i live objects over %i passes (%+.2f/pass, %+.2f/min, R^2=%.2f)"),
+				*Suspect.ClassName,
+				Suspect.FirstCount,
+				Suspect.LastCount,
+				Suspect.NumSamples,
+				Suspect.GrowthPerPass,
+				Suspect.GrowthPerMinute,
+				Suspect.Linearity);
+		}
+	}
+
+private:
+	void HandlePostGarbageCollect() { History.SampleLiveObjects(); }
+};
+
+TUniquePtr<FGarbageCollectionHistoryTracker> FGarbageCollectionHistoryTracker::GTracker;
+
 static FAutoConsoleCommand DumpGarbageCollection(
 	TEXT("ouu.Debug.GC.DumpNext"),
 	TEXT("Dump a summary of the next garbage collection that is triggered into the output log"),
@@ -262,3 +370,26 @@ static FAutoConsoleCommand StopGarbageCollectionDumping(
 			Listener->Deactivate();
 		}
 	}));
+
+static FAutoConsoleCommand StartGarbageCollectionHistory(
+	TEXT("ouu.Debug.GC.History.Start"),
+	TEXT("Start sampling live object counts per class after every garbage collection to detect leak suspects"),
+	FConsoleCommandDelegate::CreateStatic([]() { FGarbageCollectionHistoryTracker::Start(); }));
+
+static FAutoConsoleCommand StopGarbageCollectionHistory(
+	TEXT("ouu.Debug.GC.History.Stop"),
+	TEXT("Stop sampling live object counts and discard the history"),
+	FConsoleCommandDelegate::CreateStatic([]() { FGarbageCollectionHistoryTracker::Stop(); }));
+
+static FAutoConsoleCommand DumpGarbageCollectionLeakSuspects(
+	TEXT("ouu.Debug.GC.History.DumpLeakSuspects"),
+	TEXT("Print classes whose live object counts rise steadily across garbage collection passes into the output log. "
+		 "Optional argument: max number of suspects to print (default 20)"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args) {
+		int32 MaxNumSuspects = 20;
+		if (Args.Num() > 0)
+		{
+			LexFromString(MaxNumSuspects, *Args[0]);
+		}
+		FGarbageCollectionHistoryTracker::DumpLeakSuspects(MaxNumSuspects);
+	}));
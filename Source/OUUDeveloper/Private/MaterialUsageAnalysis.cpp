@@ -1,7 +1,8 @@
 // Copyright (c) 2023 Jonas Reich & Contributors
 
-#include "CoreMinimal.h"
+#include "MaterialUsageAnalysis.h"
 
+#include "Algo/Sort.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/SkinnedMeshComponent.h"
 #include "Engine/Canvas.h"
@@ -13,6 +14,8 @@
 #include "LogOpenUnrealUtilities.h"
 #include "Materials/MaterialInterface.h"
 #include "Misc/CanvasGraphPlottingUtils.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonWriter.h"
 #include "Templates/CastObjectRange.h"
 #include "Templates/RingAggregator.h"
 #include "Templates/StringUtils.h"
@@ -113,6 +116,12 @@ UObject* GetMeshFromPrimitiveComponent(const UPrimitiveComponent* PrimitiveCompo
 	return nullptr;
 }
 
+bool IsVirtualTextureOnlyPrimitive(const UPrimitiveComponent* PrimitiveComponent)
+{
+	return PrimitiveComponent->GetVirtualTextureRenderPassType() != ERuntimeVirtualTextureMainPassType::Always
+		&& PrimitiveComponent->GetRuntimeVirtualTextures().Num() > 0;
+}
+
 UWorld* GetTargetWorld()
 {
 	auto* TargetWorld = GEngine->GetCurrentPlayWorld();
@@ -156,9 +165,7 @@ FMaterialAnalysisResults AnalyzeMaterialUsage(UWorld* TargetWorld)
 				return;
 			}
 			// Exclude b/c of Virtual Texture?
-			if (bExcludeVTOnlyMeshes
-				&& PrimitiveComponent->GetVirtualTextureRenderPassType() != ERuntimeVirtualTextureMainPassType::Always
-				&& PrimitiveComponent->GetRuntimeVirtualTextures().Num() > 0)
+			if (bExcludeVTOnlyMeshes && IsVirtualTextureOnlyPrimitive(PrimitiveComponent))
 			{
 				Results.NumIgnoredPrimitivesNotRendered += 1;
 				return;
@@ -304,6 +311,194 @@ void DumpMaterialAnalysis(UWorld* TargetWorld)
 	UE_LOG(LogOpenUnrealUtilities, Log, TEXT(" \n%s"), *AnalysisLogString);
 }
 
+namespace OUU::Developer::MaterialUsageAnalysis
+{
+	void GatherPrimitiveUsages(const AActor& Actor, TArray<FPrimitiveUsage>& OutUsages)
+	{
+		const bool bExcludeVTOnlyMeshes = CVarExcludeVirtualTextureOnlyMeshes.GetValueOnAnyThread();
+		const bool bAllowMovableInstances = CVarAllowMovableInstances.GetValueOnAnyThread();
+
+		Actor.ForEachComponent<UPrimitiveComponent>(false, [&](const UPrimitiveComponent* PrimitiveComponent) {
+			const UObject* Mesh = GetMeshFromPrimitiveComponent(PrimitiveComponent);
+			if (!Mesh || (bExcludeVTOnlyMeshes && IsVirtualTextureOnlyPrimitive(PrimitiveComponent)))
+				return;
+
+			TArray<UMaterialInterface*> Materials;
+			constexpr bool bGetDebugMaterials = false;
+			PrimitiveComponent->GetUsedMaterials(OUT Materials, bGetDebugMaterials);
+
+			FPrimitiveUsage& Usage = OutUsages.AddDefaulted_GetRef();
+			Usage.Mesh = FSoftObjectPath(Mesh);
+			Usage.Materials.Reserve(Materials.Num());
+			for (const UMaterialInterface* Material : Materials)
+			{
+				if (IsValid(Material))
+				{
+					Usage.Materials.Emplace(Material);
+				}
+			}
+
+			if (auto* InstancedStaticMeshComponent = Cast<UInstancedStaticMeshComponent>(PrimitiveComponent))
+			{
+				Usage.Type = EPrimitiveUsageType::InstancedStaticMesh;
+				Usage.NumInstances = InstancedStaticMeshComponent->GetInstanceCount();
+				Usage.bCanBeInstanced = true;
+			}
+			else if (PrimitiveComponent->IsA<UStaticMeshComponent>())
+			{
+				Usage.Type = EPrimitiveUsageType::StaticMesh;
+				Usage.bCanBeInstanced =
+					PrimitiveComponent->Mobility == EComponentMobility::Static || bAllowMovableInstances;
+			}
+			else if (PrimitiveComponent->IsA<USkinnedMeshComponent>())
+			{
+				Usage.Type = EPrimitiveUsageType::SkinnedMesh;
+			}
+		});
+	}
+
+	void FMaterialUsageAccumulator::AddLevelUsages(const FString& Level, TConstArrayView<FPrimitiveUsage> Usages)
+	{
+		if (Levels.Num() == 0 || Levels.Last().Level != Level)
+		{
+			Levels.AddDefaulted_GetRef().Level = Level;
+		}
+		const int32 LevelIndex = Levels.Num() - 1;
+		FLevelStats& LevelStats = Levels[LevelIndex];
+
+		TStringBuilder<1024> KeyBuilder;
+		for (const FPrimitiveUsage& Usage : Usages)
+		{
+			KeyBuilder.Reset();
+			Usage.Mesh.AppendString(KeyBuilder);
+			for (const FSoftObjectPath& Material : Usage.Materials)
+			{
+				KeyBuilder.AppendChar(TEXT('|'));
+				Material.AppendString(KeyBuilder);
+			}
+
+			FCombinationStats& Stats = Combinations.FindOrAdd(FString(KeyBuilder.ToView()));
+			if (Stats.LastLevelIndex == INDEX_NONE)
+			{
+				Stats.Mesh = Usage.Mesh;
+				Stats.Materials = Usage.Materials;
+			}
+			if (Stats.LastLevelIndex != LevelIndex)
+			{
+				Stats.LastLevelIndex = LevelIndex;
+				Stats.NumLevels += 1;
+				LevelStats.NumCombinations += 1;
+			}
+
+			Stats.NumInstances += Usage.NumInstances;
+			Stats.NumInstances_Possible += Usage.bCanBeInstanced ? Usage.NumInstances : 0;
+			switch (Usage.Type)
+			{
+			case EPrimitiveUsageType::StaticMesh:
+			case EPrimitiveUsageType::InstancedStaticMesh: Stats.NumStaticMeshComponents += 1; break;
+			case EPrimitiveUsageType::SkinnedMesh: Stats.NumSkinnedMeshComponents += 1; break;
+			default: Stats.NumOtherComponents += 1; break;
+			}
+
+			LevelStats.NumPrimitives += 1;
+			LevelStats.NumInstances += Usage.NumInstances;
+		}
+	}
+
+	void FMaterialUsageAccumulator::Reset()
+	{
+		Combinations.Reset();
+		Levels.Reset();
+	}
+
+	TArray<const FMaterialUsageAccumulator::FCombinationStats*> FMaterialUsageAccumulator::GetSortedCombinations()
+		const
+	{
+		TArray<const FCombinationStats*> Result;
+		Result.Reserve(Combinations.Num());
+		for (const auto& Entry : Combinations)
+		{
+			Result.Add(&Entry.Value);
+		}
+		Algo::Sort(Result, [](const FCombinationStats* A, const FCombinationStats* B) {
+			return A->NumInstances > B->NumInstances;
+		});
+		return Result;
+	}
+
+	bool FMaterialUsageAccumulator::WriteCsv(const FString& FilePath) const
+	{
+		auto ToCsvField = [](FString Value) {
+			Value.ReplaceInline(TEXT("\""), TEXT("\"\""));
+			return FString::Printf(TEXT("\"%s\""), *Value);
+		};
+
+		FString FileContents = TEXT(
+			"Mesh,Materials,NumInstances,NumInstancesPossible,NumStaticMeshComponents,NumSkinnedMeshComponents,"
+			"NumOtherComponents,NumLevels\n");
+		for (const FCombinationStats* Stats : GetSortedCombinations())
+		{
+			FileContents += FString::Printf(
+				TEXT("%s,%s,%i,%i,%i,%i,%i,%i\n"),
+				*ToCsvField(Stats->Mesh.ToString()),
+				*ToCsvField(FString::JoinBy(Stats->Materials, TEXT(";"), [](const FSoftObjectPath& Material) {
+					return Material.ToString();
+				})),
+				Stats->NumInstances,
+				Stats->NumInstances_Possible,
+				Stats->NumStaticMeshComponents,
+				Stats->NumSkinnedMeshComponents,
+				Stats->NumOtherComponents,
+				Stats->NumLevels);
+		}
+		return FFileHelper::SaveStringToFile(FileContents, *FilePath);
+	}
+
+	bool FMaterialUsageAccumulator::WriteJson(const FString& FilePath) const
+	{
+		FString FileContents;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&FileContents);
+		Writer->WriteObjectStart();
+
+		Writer->WriteArrayStart(TEXT("Levels"));
+		for (const FLevelStats& LevelStats : Levels)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Level"), LevelStats.Level);
+			Writer->WriteValue(TEXT("NumPrimitives"), LevelStats.NumPrimitives);
+			Writer->WriteValue(TEXT("NumInstances"), LevelStats.NumInstances);
+			Writer->WriteValue(TEXT("NumCombinations"), LevelStats.NumCombinations);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("Combinations"));
+		for (const FCombinationStats* Stats : GetSortedCombinations())
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("Mesh"), Stats->Mesh.ToString());
+			Writer->WriteArrayStart(TEXT("Materials"));
+			for (const FSoftObjectPath& Material : Stats->Materials)
+			{
+				Writer->WriteValue(Material.ToString());
+			}
+			Writer->WriteArrayEnd();
+			Writer->WriteValue(TEXT("NumInstances"), Stats->NumInstances);
+			Writer->WriteValue(TEXT("NumInstancesPossible"), Stats->NumInstances_Possible);
+			Writer->WriteValue(TEXT("NumStaticMeshComponents"), Stats->NumStaticMeshComponents);
+			Writer->WriteValue(TEXT("NumSkinnedMeshComponents"), Stats->NumSkinnedMeshComponents);
+			Writer->WriteValue(TEXT("NumOtherComponents"), Stats->NumOtherComponents);
+			Writer->WriteValue(TEXT("NumLevels"), Stats->NumLevels);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+		Writer->Close();
+		return FFileHelper::SaveStringToFile(FileContents, *FilePath);
+	}
+} // namespace OUU::Developer::MaterialUsageAnalysis
+
 class FMaterialAnalysisTickHelper : public FTickableGameObject
 {
 private:
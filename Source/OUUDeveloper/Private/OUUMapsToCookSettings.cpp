@@ -2,12 +2,20 @@
 
 #include "OUUMapsToCookSettings.h"
 
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/Async.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/PlatformFileManager.h"
 #include "ISourceControlModule.h"
 #include "LogOpenUnrealUtilities.h"
+#include "Logging/MessageLogBlueprintLibrary.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/PackageName.h"
 #include "SourceControlHelpers.h"
+#include "Tasks/Task.h"
 
 namespace OUU::Developer::Private
 {
@@ -41,6 +49,172 @@ namespace OUU::Developer::Private
 			}
 		}
 	}
+
+	namespace MapsToCookValidation
+	{
+		struct FListSnapshot
+		{
+			FString Section;
+			/** Raw config entries */
+			TArray<FString> Entries;
+			/** Long package names resolved from Entries. Empty if an entry could not be resolved. */
+			TArray<FName> PackageNames;
+		};
+
+		struct FMessage
+		{
+			EMessageLogSeverity Severity;
+			FString Text;
+		};
+
+		/** Snapshot the map lists and resolve package names. Must run on the game thread (mount points). */
+		TArray<FListSnapshot> CreateSnapshot(const TArray<const FOUUMapsToCookList*>& Lists)
+		{
+			TArray<FListSnapshot> Result;
+			Result.Reserve(Lists.Num());
+			for (const FOUUMapsToCookList* List : Lists)
+			{
+				FListSnapshot& Snapshot = Result.AddDefaulted_GetRef();
+				Snapshot.Section = List->OwningConfigSection;
+				Snapshot.Entries.Reserve(List->MapsToCook.Num());
+				Snapshot.PackageNames.Reserve(List->MapsToCook.Num());
+				for (const FFilePath& Map : List->MapsToCook)
+				{
+					Snapshot.Entries.Add(Map.FilePath);
+
+					FString PackageName;
+					if (FPackageName::IsValidLongPackageName(Map.FilePath))
+					{
+						PackageName = Map.FilePath;
+					}
+					else if (!FPackageName::TryConvertFilenameToLongPackageName(Map.FilePath, PackageName))
+					{
+						PackageName.Reset();
+					}
+					Snapshot.PackageNames.Add(PackageName.IsEmpty() ? NAME_None : FName(*PackageName));
+				}
+			}
+			return Result;
+		}
+
+		/** Evaluate the snapshot against a single batched asset registry query. Safe to run on a worker thread. */
+		TArray<FMessage> Validate(const TArray<FListSnapshot>& Lists)
+		{
+			TArray<FMessage> Messages;
+
+			FARFilter Filter;
+			Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+			for (const FListSnapshot& List : Lists)
+			{
+				for (const FName PackageName : List.PackageNames)
+				{
+					if (!PackageName.IsNone())
+					{
+						Filter.PackageNames.AddUnique(PackageName);
+					}
+				}
+			}
+
+			// Package name -> is world partition map
+			TMap<FName, bool> FoundMaps;
+			if (Filter.PackageNames.Num() > 0)
+			{
+				TArray<FAssetData> Assets;
+				IAssetRegistry::GetChecked().GetAssets(Filter, Assets);
+				FoundMaps.Reserve(Assets.Num());
+				for (const FAssetData& Asset : Assets)
+				{
+					FoundMaps.Add(Asset.PackageName, ULevel::GetIsLevelPartitionedFromAsset(Asset));
+				}
+			}
+
+			// Package name -> sections that list the map
+			TMap<FName, TArray<FString, TInlineAllocator<4>>> SectionsPerMap;
+			int32 NumIssues = 0;
+			for (const FListSnapshot& List : Lists)
+			{
+				int32 NumPartitioned = 0;
+				int32 NumNonPartitioned = 0;
+				TSet<FName> SeenInList;
+				for (int32 Idx = 0; Idx < List.Entries.Num(); Idx++)
+				{
+					const FString& Entry = List.Entries[Idx];
+					const FName PackageName = List.PackageNames[Idx];
+					if (PackageName.IsNone())
+					{
+						Messages.Add(
+							{EMessageLogSeverity::Error,
+							 FString::Printf(
+								 TEXT("[%s] '%s' is not a valid map package path"),
+								 *List.Section,
+								 *Entry)});
+						NumIssues++;
+						continue;
+					}
+
+					bool bAlreadyInList = false;
+					SeenInList.Add(PackageName, &bAlreadyInList);
+					if (bAlreadyInList)
+					{
+						Messages.Add(
+							{EMessageLogSeverity::Warning,
+							 FString::Printf(TEXT("[%s] %s is listed more than once"), *List.Section, *Entry)});
+						NumIssues++;
+						continue;
+					}
+					SectionsPerMap.FindOrAdd(PackageName).Add(List.Section);
+
+					const bool* bIsPartitioned = FoundMaps.Find(PackageName);
+					if (bIsPartitioned == nullptr)
+					{
+						Messages.Add(
+							{EMessageLogSeverity::Error,
+							 FString::Printf(
+								 TEXT("[%s] %s does not exist or is not a map"),
+								 *List.Section,
+								 *Entry)});
+						NumIssues++;
+						continue;
+					}
+					(*bIsPartitioned ? NumPartitioned : NumNonPartitioned)++;
+				}
+
+				if (List.Entries.Num() > 0)
+				{
+					Messages.Add(
+						{EMessageLogSeverity::Info,
+						 FString::Printf(
+							 TEXT("[%s] %i entries: %i world partition maps, %i non world partition maps"),
+							 *List.Section,
+							 List.Entries.Num(),
+							 NumPartitioned,
+							 NumNonPartitioned)});
+				}
+			}
+
+			for (const auto& Entry : SectionsPerMap)
+			{
+				if (Entry.Value.Num() > 1)
+				{
+					Messages.Add(
+						{EMessageLogSeverity::Info,
+						 FString::Printf(
+							 TEXT("%s is listed in multiple sections: %s"),
+							 *Entry.Key.ToString(),
+							 *FString::Join(Entry.Value, TEXT(", ")))});
+				}
+			}
+
+			Messages.Add(
+				{NumIssues > 0 ? EMessageLogSeverity::Warning : EMessageLogSeverity::Info,
+				 FString::Printf(
+					 TEXT("Validated %i maps in %i map lists: %i issues found"),
+					 SectionsPerMap.Num(),
+					 Lists.Num(),
+					 NumIssues)});
+			return Messages;
+		}
+	} // namespace MapsToCookValidation
 } // namespace OUU::Developer::Private
 
 void FOUUMapsToCookList::ReloadConfig(const FString& ConfigPath)
@@ -60,35 +234,40 @@ void FOUUMapsToCookList::ReloadConfig(const FString& ConfigPath)
 	}
 }
 
-void FOUUMapsToCookList::UpdateDefaultConfigFile(const FString& ConfigPath)
+bool FOUUMapsToCookList::UpdateDefaultConfigFile(const FString& ConfigPath)
 {
 	// Default ini files require the array syntax to be applied to the property name
 	// We also use the hardcoded name "Map", because that's required by the cooker.
-	const FString CompleteKey = TEXT("+Map");
+	const FName CompleteKey = TEXT("+Map");
 	FConfigSection* Sec = GConfig->GetSectionPrivate(*OwningConfigSection, true, false, *ConfigPath);
-	if (MapsToCook.Num() > 0)
+	if (!Sec)
 	{
-		TArray<FString> MapsToCookStrings;
-		for (auto& Map : MapsToCook)
-		{
-			MapsToCookStrings.Add(Map.FilePath);
-		}
+		return false;
+	}
 
-		if (Sec)
+	// Skip the write if the section already contains exactly these maps, so unrelated edits don't cause checkouts.
+	TArray<FConfigValue> ExistingValues;
+	Sec->MultiFind(CompleteKey, ExistingValues, true);
+	if (ExistingValues.Num() == MapsToCook.Num())
+	{
+		bool bEqual = true;
+		for (int32 i = 0; i < MapsToCook.Num() && bEqual; i++)
 		{
-			// Delete the old value for the property in the ConfigCache before (conditionally) adding in the new value
-			Sec->Remove(*CompleteKey);
+			bEqual = ExistingValues[i].GetSavedValue() == MapsToCook[i].FilePath;
 		}
-
-		for (int32 i = 0; i < MapsToCook.Num(); i++)
+		if (bEqual)
 		{
-			Sec->Add(*CompleteKey, *MapsToCook[i].FilePath);
+			return false;
 		}
 	}
-	else
+
+	// Delete the old value for the property in the ConfigCache before (conditionally) adding in the new value
+	Sec->Remove(CompleteKey);
+	for (int32 i = 0; i < MapsToCook.Num(); i++)
 	{
-		Sec->Remove(*CompleteKey);
+		Sec->Add(CompleteKey, *MapsToCook[i].FilePath);
 	}
+	return true;
 }
 
 UOUUMapsToCookSettings::UOUUMapsToCookSettings()
@@ -117,7 +296,11 @@ void UOUUMapsToCookSettings::PreEditChange(FProperty* PropertyAboutToChange)
 void UOUUMapsToCookSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive)
+		return;
+
 	const auto ConfigPath = GetDefaultConfigFilename();
+	bool bConfigChanged = false;
 
 	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UOUUMapsToCookSettings, ConfigSections))
 	{
@@ -141,7 +324,8 @@ void UOUUMapsToCookSettings::PostEditChangeProperty(FPropertyChangedEvent& Prope
 				Wrapper.OwningConfigSection = NewSectionName;
 
 				// export from renamed section
-				Wrapper.UpdateDefaultConfigFile(GetDefaultConfigFilename());
+				Wrapper.UpdateDefaultConfigFile(ConfigPath);
+				bConfigChanged = true;
 			}
 		}
 		else if (ConfigSections.Num() < ConfigSections_ChangeCopy.Num())
@@ -151,34 +335,77 @@ void UOUUMapsToCookSettings::PostEditChangeProperty(FPropertyChangedEvent& Prope
 			{
 				// Remove old keys that are not in new list
 				auto& OldSectionName = ConfigSections_ChangeCopy[SectionIdx];
-				if (ConfigSections.Find(OldSectionName))
+				if (ConfigSections.Contains(OldSectionName))
 					continue;
 
 				GConfig->EmptySection(*OldSectionName, *ConfigPath);
 			}
+			RefreshMapListsFromConfig();
+			bConfigChanged = true;
 		}
 		else
 		{
 			// case #3: Add
 			RefreshMapListsFromConfig();
+			bConfigChanged = true;
 		}
 	}
 	else
 	{
 		for (auto& NestedSetting : MapLists)
 		{
-			NestedSetting.UpdateDefaultConfigFile(ConfigPath);
+			bConfigChanged |= NestedSetting.UpdateDefaultConfigFile(ConfigPath);
 		}
-		AllMaps.UpdateDefaultConfigFile(ConfigPath);
-		AlwaysCookMaps.UpdateDefaultConfigFile(ConfigPath);
+		bConfigChanged |= AllMaps.UpdateDefaultConfigFile(ConfigPath);
+		bConfigChanged |= AlwaysCookMaps.UpdateDefaultConfigFile(ConfigPath);
 #if WITH_EDITORONLY_DATA
 		bEnableAllMaps = AlwaysCookMaps.MapsToCook.Num() == 0;
 #endif
 	}
 
+	if (bConfigChanged)
+	{
+		RequestConfigFlush();
+	}
+}
+
+void UOUUMapsToCookSettings::RequestConfigFlush()
+{
+	if (PendingConfigFlushHandle.IsValid())
+		return;
+
+	// Defer to the next tick, so multiple edits in the same frame (e.g. multi-select edits, array pastes, undo
+	// transactions) only cause a single checkout and file write.
+	PendingConfigFlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateWeakLambda(
+			this,
+			[this](float) {
+				PendingConfigFlushHandle.Reset();
+				FlushConfig();
+				// Re-validate after every written batch so stale entries are reported right away.
+				ValidateMapLists();
+				return false;
+			}),
+		0.f);
+}
+
+void UOUUMapsToCookSettings::FlushConfig()
+{
+	const auto ConfigPath = GetDefaultConfigFilename();
 	OUU::Developer::Private::CheckoutConfigFile(ConfigPath);
 	GConfig->Flush(false, ConfigPath);
 }
+
+void UOUUMapsToCookSettings::BeginDestroy()
+{
+	if (PendingConfigFlushHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PendingConfigFlushHandle);
+		PendingConfigFlushHandle.Reset();
+		FlushConfig();
+	}
+	Super::BeginDestroy();
+}
 #endif
 
 void UOUUMapsToCookSettings::PostInitProperties()
@@ -192,6 +419,63 @@ FName UOUUMapsToCookSettings::GetCategoryName() const
 	return TEXT("Project");
 }
 
+void UOUUMapsToCookSettings::ValidateMapLists()
+{
+	using namespace OUU::Developer::Private::MapsToCookValidation;
+
+	if (bValidationInProgress)
+	{
+		bValidationRequestedWhileInProgress = true;
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		// Results would be incomplete. Validate once the initial scan is done.
+		bValidationInProgress = true;
+		AssetRegistry.OnFilesLoaded().AddWeakLambda(this, [this]() {
+			IAssetRegistry::GetChecked().OnFilesLoaded().RemoveAll(this);
+			bValidationInProgress = false;
+			ValidateMapLists();
+		});
+		return;
+	}
+
+	TArray<const FOUUMapsToCookList*> Lists{&AllMaps, &AlwaysCookMaps};
+	for (const auto& List : MapLists)
+	{
+		Lists.Add(&List);
+	}
+
+	bValidationInProgress = true;
+	UE::Tasks::Launch(
+		UE_SOURCE_LOCATION,
+		[WeakThis = TWeakObjectPtr<UOUUMapsToCookSettings>(this), Snapshot = CreateSnapshot(Lists)]() {
+			TArray<FMessage> Messages = Validate(Snapshot);
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Messages = MoveTemp(Messages)]() {
+				UOUUMapsToCookSettings* This = WeakThis.Get();
+				if (!This)
+					return;
+
+				for (const FMessage& Message : Messages)
+				{
+					UMessageLogBlueprintLibrary::AddTokenizedMessageLogMessage(
+						GetMessageLogName(EMessageLogName::AssetCheck),
+						FMessageLogToken::CreateList(Message.Text),
+						Message.Severity);
+				}
+
+				This->bValidationInProgress = false;
+				if (This->bValidationRequestedWhileInProgress)
+				{
+					This->bValidationRequestedWhileInProgress = false;
+					This->ValidateMapLists();
+				}
+			});
+		});
+}
+
 void UOUUMapsToCookSettings::RefreshMapListsFromConfig()
 {
 	AllMaps.ReloadConfig(GEditorIni);
@@ -6,6 +6,8 @@
 
 #include "GameFramework/Actor.h"
 #include "GameplayTags/GameplayTagQueryParser.h"
+#include "Internationalization/Regex.h"
+#include "Misc/OUUPatternSet.h"
 
 namespace OUU::Developer::ActorMapWindow
 {
@@ -57,12 +59,43 @@ namespace OUU::Developer::ActorMapWindow
 		FGameplayTagQuery ActorTagQuery;
 
 		/**
-		 * Cached result from executing the query via ExecuteAndCacheQuery()
+		 * Cached result from executing the query via ExecuteAndCacheQuery() or FActorQueryBatch.
 		 */
 		FResult CachedQueryResult;
 
+		/**
+		 * Per-actor data that is expensive to compute and shared between all queries that are evaluated in the same
+		 * pass over the world. Everything except the name is computed lazily on first access.
+		 */
+		struct OUUDEVELOPER_API FActorData
+		{
+		public:
+			explicit FActorData(const AActor* InActor);
+
+			const AActor* const Actor;
+			const FString Name;
+
+			/** Lower case version of the name for case insensitive name filters. */
+			const FString& GetLowerCaseName() const;
+
+			/** @returns the owned tags of the ability system component or nullptr if the actor does not have one. */
+			const FGameplayTagContainer* GetOwnedTags() const;
+
+		private:
+			mutable TOptional<FString> LowerCaseName;
+			mutable TOptional<FGameplayTagContainer> OwnedTags;
+			mutable bool bOwnedTagsResolved = false;
+		};
+
 		bool MatchesActor(const AActor* Actor) const;
 
+		/**
+		 * Same as above, but reuses the actor data that may be shared with other queries.
+		 * @param	bSkipNameFilter	If true, the case insensitive name filter is assumed to be checked by the caller
+		 *							already. It still counts as active filter. The name regex is always checked.
+		 */
+		bool MatchesActor(const FActorData& ActorData, bool bSkipNameFilter = false) const;
+
 		FResult ExecuteQuery(UWorld* World) const;
 
 		FORCEINLINE FResult& ExecuteAndCacheQuery(UWorld* World)
@@ -70,5 +103,75 @@ namespace OUU::Developer::ActorMapWindow
 			CachedQueryResult = ExecuteQuery(World);
 			return CachedQueryResult;
 		}
+
+		/**
+		 * Update the pre-processed filter data (class filters, lower case name, regex pattern) from the filter strings.
+		 * Must be called after changing filter properties and before calling MatchesActor(FActorData).
+		 */
+		void CompileFilters() const;
+
+	private:
+		mutable FString CompiledNameFilter;
+		mutable FString CompiledNameRegexPattern;
+		mutable TOptional<FRegexPattern> CompiledNameRegex;
+		mutable FName CompiledActorClassName;
+		mutable FName CompiledComponentClassName;
+
+		/**
+		 * Memoized class filter results per class.
+		 * Each class (and its super classes) only has to be checked against the filter name once. Classes that are
+		 * loaded later are simply not memoized yet, so these only need to be reset if classes may have been destroyed.
+		 */
+		mutable TMap<const UClass*, bool> ActorClassMatches;
+		mutable TMap<const UClass*, bool> ComponentClassMatches;
+		mutable uint32 ClassMatchesGeneration = 0;
+	};
+
+	/**
+	 * Evaluates multiple actor queries in a single pass over all actors of a world.
+	 * Per-actor data is computed once and shared by all queries.
+	 * The pass can be split over multiple frames by a time budget. The previous results of the queries remain in
+	 * their CachedQueryResult until a pass completes, at which point all queries are updated at once.
+	 */
+	class OUUDEVELOPER_API FActorQueryBatch
+	{
+	public:
+		/** Start a new pass for the given queries. Cancels any pass that is currently in progress. */
+		void Start(UWorld* InWorld, TConstArrayView<TSharedPtr<FActorQuery>> InQueries);
+
+		/**
+		 * Continue the current pass.
+		 * @param	TimeBudgetSeconds	Maximum time to spend evaluating actors. <= 0 means no limit.
+		 * @returns	if the pass was completed and the results were written to the queries.
+		 */
+		bool Continue(double TimeBudgetSeconds);
+
+		/** Discard the current pass without touching the cached results of the queries. */
+		void Cancel();
+
+		FORCEINLINE bool IsInProgress() const { return NextActorIndex != INDEX_NONE; }
+
+		/** @returns the progress of the current pass in the range [0, 1] */
+		float GetProgress() const;
+
+		/** Run a full pass without time budget and write the results to the queries. */
+		static void ExecuteAndCacheQueries(UWorld* World, TConstArrayView<TSharedPtr<FActorQuery>> Queries);
+
+	private:
+		TWeakObjectPtr<UWorld> World;
+		TArray<TWeakPtr<FActorQuery>> Queries;
+		TArray<FActorQuery::FResult> PendingResults;
+		TArray<TWeakObjectPtr<AActor>> PendingActors;
+		int32 NextActorIndex = INDEX_NONE;
+
+		/**
+		 * Name filters of all queries, so every actor name is matched against all of them in a single pass.
+		 * Name regexes are not part of the set: Each query matches its own pre-compiled regex in MatchesActor().
+		 */
+		FOUUPatternSet NameFilterPatterns{ESearchCase::IgnoreCase};
+		/** Query index for each pattern of the set above */
+		TArray<int32> NameFilterPatternQueries;
+		/** Per query: if the actor name must match one of NameFilterPatterns */
+		TBitArray<> QueryHasNameFilter;
 	};
 } // namespace OUU::Developer::ActorMapWindow
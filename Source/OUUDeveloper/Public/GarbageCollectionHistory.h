@@ -0,0 +1,74 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UObject/ObjectKey.h"
+
+/**
+ * Fixed-size history of live object counts per class that is sampled after garbage collection passes.
+ * Classes whose live counts rise steadily across passes are reported as leak suspects.
+ *
+ * All classes share one ring of samples, so sample N of every class refers to the same GC pass.
+ */
+class OUUDEVELOPER_API FGarbageCollectionHistory
+{
+public:
+	struct FLeakSuspect
+	{
+		FString ClassName;
+		int32 NumSamples = 0;
+		int32 FirstCount = 0;
+		int32 LastCount = 0;
+		/** Slope of the linear regression over all samples in objects per GC pass */
+		double GrowthPerPass = 0.0;
+		/** Growth in objects per minute based on the sample timestamps */
+		double GrowthPerMinute = 0.0;
+		/** Coefficient of determination (R^2) of the linear regression. 1 = perfectly linear growth */
+		double Linearity = 0.0;
+	};
+
+	explicit FGarbageCollectionHistory(int32 InHistorySize = 32);
+
+	/** Count all live objects by class and add the counts as a new sample. */
+	void SampleLiveObjects();
+
+	/** Add a sample of live object counts. Previously sampled classes that are missing in the map count as 0. */
+	void AddSample(const TMap<const UClass*, int32>& LiveCounts, double Timestamp);
+
+	/**
+	 * Find classes whose live object counts grow steadily.
+	 * @param	MinPasses			Minimum number of samples of a class for it to be evaluated
+	 * @param	MinGrowthPerPass	Minimum slope of the regression line
+	 * @param	MinLinearity		Minimum R^2 of the regression line to filter out noisy/spiky counts
+	 * @returns suspects sorted by descending growth per pass
+	 */
+	TArray<FLeakSuspect> FindLeakSuspects(int32 MinPasses, double MinGrowthPerPass, double MinLinearity) const;
+
+	int32 GetHistorySize() const { return HistorySize; }
+	int32 NumSamples() const { return FMath::Min(TotalNumSamples, HistorySize); }
+	int32 NumTrackedClasses() const { return Classes.Num(); }
+
+	void Reset();
+
+private:
+	struct FClassHistory
+	{
+		FString ClassName;
+		/** Ring of live counts indexed the same way as SampleTimestamps */
+		TArray<int32> LiveCounts;
+		/** Number of valid samples. These are always the most recent ones. */
+		int32 NumSamples = 0;
+		/** Value of TotalNumSamples when this class was last sampled */
+		int32 LastSampleNumber = 0;
+	};
+
+	int32 HistorySize = 0;
+	int32 TotalNumSamples = 0;
+	TArray<double> SampleTimestamps;
+	TMap<FObjectKey, FClassHistory> Classes;
+
+	/** @returns the ring index of a sample. 0 is the oldest of the last NumSamplesBack samples. */
+	int32 GetRingIndex(int32 NumSamplesBack, int32 Index) const;
+};
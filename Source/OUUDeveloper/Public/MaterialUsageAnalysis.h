@@ -0,0 +1,99 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UObject/SoftObjectPath.h"
+
+class AActor;
+
+namespace OUU::Developer::MaterialUsageAnalysis
+{
+	enum class EPrimitiveUsageType : uint8
+	{
+		StaticMesh,
+		InstancedStaticMesh,
+		SkinnedMesh,
+		// Primitive with a mesh that is not handled explicitly
+		Other
+	};
+
+	/**
+	 * Mesh/material combination used by a single primitive component.
+	 * Stores paths instead of object pointers, so usages can be aggregated after the level was unloaded.
+	 */
+	struct FPrimitiveUsage
+	{
+		FSoftObjectPath Mesh;
+		TArray<FSoftObjectPath> Materials;
+		EPrimitiveUsageType Type = EPrimitiveUsageType::Other;
+		int32 NumInstances = 1;
+		// Whether the primitive qualifies for conversion into an instanced static mesh
+		bool bCanBeInstanced = false;
+	};
+
+	/**
+	 * Gather the mesh/material combinations of all primitive components of an actor.
+	 * Uses the same filter settings as the ouu.Debug.MaterialUsageAnalysis console commands, except for the
+	 * recently rendered check, which does not make sense for offline analysis.
+	 */
+	OUUDEVELOPER_API void GatherPrimitiveUsages(const AActor& Actor, TArray<FPrimitiveUsage>& OutUsages);
+
+	/**
+	 * Accumulates primitive usages across multiple levels.
+	 * Memory usage only scales with the number of unique mesh/material combinations, not with the number of
+	 * analyzed primitives. Not thread-safe, but may be fed from any single thread at a time.
+	 */
+	class OUUDEVELOPER_API FMaterialUsageAccumulator
+	{
+	public:
+		struct FCombinationStats
+		{
+			FSoftObjectPath Mesh;
+			TArray<FSoftObjectPath> Materials;
+
+			int32 NumInstances = 0;
+			int32 NumInstances_Possible = 0;
+			int32 NumStaticMeshComponents = 0;
+			int32 NumSkinnedMeshComponents = 0;
+			int32 NumOtherComponents = 0;
+			int32 NumLevels = 0;
+
+		private:
+			friend FMaterialUsageAccumulator;
+			int32 LastLevelIndex = INDEX_NONE;
+		};
+
+		struct FLevelStats
+		{
+			FString Level;
+			int32 NumPrimitives = 0;
+			int32 NumInstances = 0;
+			int32 NumCombinations = 0;
+		};
+
+		/**
+		 * Add usages of a level. Consecutive calls with the same level name are merged into the same level stats,
+		 * so large levels can be added in chunks.
+		 */
+		void AddLevelUsages(const FString& Level, TConstArrayView<FPrimitiveUsage> Usages);
+
+		/** Discard all accumulated combinations and levels. */
+		void Reset();
+
+		/** @returns all combinations sorted by descending instance count */
+		TArray<const FCombinationStats*> GetSortedCombinations() const;
+
+		const TArray<FLevelStats>& GetLevelStats() const { return Levels; }
+		int32 NumCombinations() const { return Combinations.Num(); }
+
+		bool WriteCsv(const FString& FilePath) const;
+		bool WriteJson(const FString& FilePath) const;
+
+	private:
+		// Key: mesh path followed by material paths
+		TMap<FString, FCombinationStats> Combinations;
+		TArray<FLevelStats> Levels;
+	};
+} // namespace OUU::Developer::MaterialUsageAnalysis
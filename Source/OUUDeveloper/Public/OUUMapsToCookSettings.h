@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "Containers/Ticker.h"
 #include "Engine/DeveloperSettings.h"
 
 #include "OUUMapsToCookSettings.generated.h"
@@ -22,7 +23,12 @@ public:
 	TArray<FFilePath> MapsToCook;
 
 	void ReloadConfig(const FString& ConfigPath);
-	void UpdateDefaultConfigFile(const FString& ConfigPath);
+
+	/**
+	 * Write the map list into the config cache (does not flush to disk).
+	 * @returns if the config section contents changed
+	 */
+	bool UpdateDefaultConfigFile(const FString& ConfigPath);
 };
 
 /**
@@ -65,12 +71,23 @@ public:
 #if WITH_EDITOR
 	void PreEditChange(FProperty* PropertyAboutToChange) override;
 	void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	void BeginDestroy() override;
 #endif
 	void PostInitProperties() override;
 	// --
 
 	FName GetCategoryName() const override;
 
+	/**
+	 * Check all map lists against the asset registry in one batched query.
+	 * Reports missing maps, duplicate entries and world partition usage to the AssetCheck message log.
+	 * The asset registry query and evaluation run on a background task.
+	 */
+	UFUNCTION(CallInEditor, Category = "Validation")
+	void ValidateMapLists();
+
+	bool IsValidationInProgress() const { return bValidationInProgress; }
+
 private:
 #if WITH_EDITORONLY_DATA
 	// Cache if AllMaps property should be editable
@@ -82,5 +99,18 @@ private:
 	TArray<FString> ConfigSections_ChangeCopy;
 #endif
 
+#if WITH_EDITOR
+	// Pending deferred config write. All edits until the next tick are written with a single checkout + flush.
+	FTSTicker::FDelegateHandle PendingConfigFlushHandle;
+#endif
+
+	bool bValidationInProgress = false;
+	bool bValidationRequestedWhileInProgress = false;
+
 	void RefreshMapListsFromConfig();
+
+#if WITH_EDITOR
+	void RequestConfigFlush();
+	void FlushConfig();
+#endif
 };
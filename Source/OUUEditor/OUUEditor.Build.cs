@@ -56,10 +56,13 @@ public class OUUEditor : OUUModuleRules
 			"DeveloperSettings",
 			"GameplayTags",
 			"GameplayTagsEditor",
+			"BlueprintGraph",
+			"KismetCompiler",
 
             // OUU
             "OUURuntime",
-			"OUUDeveloper"
+			"OUUDeveloper",
+			"OUUBlueprintRuntime"
 		});
 	}
 }
@@ -0,0 +1,253 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "BlueprintGraph/K2Node_OUULog.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MakeArray.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiler.h"
+#include "LogOpenUnrealUtilitiesLibrary.h"
+
+namespace OUU::Editor::Private::K2Node_OUULog
+{
+	const FName CategoryPinName = TEXT("Category");
+	const FName VerbosityPinName = TEXT("Verbosity");
+	const FName FormatPinName = TEXT("Format");
+
+	bool IsReservedPinName(const FString& Name)
+	{
+		return Name == CategoryPinName.ToString() || Name == VerbosityPinName.ToString()
+			|| Name == FormatPinName.ToString() || Name == UEdGraphSchema_K2::PN_Execute.ToString()
+			|| Name == UEdGraphSchema_K2::PN_Then.ToString();
+	}
+
+	UK2Node_CallFunction* SpawnLibraryCall(
+		UK2Node& SourceNode,
+		FKismetCompilerContext& CompilerContext,
+		UEdGraph* SourceGraph,
+		FName FunctionName)
+	{
+		auto* CallNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(&SourceNode, SourceGraph);
+		CallNode->FunctionReference.SetExternalMember(FunctionName, ULogOpenUnrealUtilitiesLibrary::StaticClass());
+		CallNode->AllocateDefaultPins();
+		return CallNode;
+	}
+
+	/** Spawn a make array node with NumInputs entries that is connected to the given array pin. */
+	UK2Node_MakeArray* SpawnMakeArray(
+		UK2Node& SourceNode,
+		FKismetCompilerContext& CompilerContext,
+		UEdGraph* SourceGraph,
+		UEdGraphPin& ArrayPin,
+		int32 NumInputs)
+	{
+		auto* MakeArrayNode = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(&SourceNode, SourceGraph);
+		MakeArrayNode->AllocateDefaultPins();
+		UEdGraphPin* OutputPin = MakeArrayNode->GetOutputPin();
+		OutputPin->MakeLinkTo(&ArrayPin);
+		// Resolves the wildcard type of the array from the connected pin
+		MakeArrayNode->PinConnectionListChanged(OutputPin);
+		for (int32 i = 1; i < NumInputs; i++)
+		{
+			MakeArrayNode->AddInputPin();
+		}
+		return MakeArrayNode;
+	}
+
+	FName GetArrayInputPinName(int32 Index) { return *FString::Printf(TEXT("[%d]"), Index); }
+} // namespace OUU::Editor::Private::K2Node_OUULog
+
+void UK2Node_OUULog::AllocateDefaultPins()
+{
+	using namespace OUU::Editor::Private::K2Node_OUULog;
+
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Then);
+
+	UEdGraphPin* CategoryPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Name, CategoryPinName);
+	CategoryPin->DefaultValue = TEXT("LogBlueprintUserMessages");
+
+	UEdGraphPin* VerbosityPin = CreatePin(
+		EGPD_Input,
+		UEdGraphSchema_K2::PC_Byte,
+		StaticEnum<EOUUBlueprintLogVerbosity>(),
+		VerbosityPinName);
+	VerbosityPin->DefaultValue =
+		StaticEnum<EOUUBlueprintLogVerbosity>()->GetNameStringByValue(
+			static_cast<int64>(EOUUBlueprintLogVerbosity::Log));
+
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_String, FormatPinName);
+
+	for (const FString& FieldName : FieldNames)
+	{
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_String, FName(*FieldName));
+	}
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_OUULog::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return INVTEXT("Log To Category (OUU)");
+}
+
+FText UK2Node_OUULog::GetTooltipText() const
+{
+	return INVTEXT(
+		"Write a formatted message to a log category.\n"
+		"Every {Name} argument in the format string adds an input pin for a field of the same name. "
+		"Connected nodes are only evaluated if the category would actually write a message of the given "
+		"verbosity.\n"
+		"Fields are also written as JSON lines to Saved/Logs/<Project>_Structured.jsonl "
+		"(see ouu.Log.Structured.Enabled).");
+}
+
+void UK2Node_OUULog::PinDefaultValueChanged(UEdGraphPin* Pin)
+{
+	Super::PinDefaultValueChanged(Pin);
+	if (Pin && Pin->PinName == OUU::Editor::Private::K2Node_OUULog::FormatPinName)
+	{
+		SyncFieldPins();
+	}
+}
+
+void UK2Node_OUULog::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+	if (Pin && Pin->PinName == OUU::Editor::Private::K2Node_OUULog::FormatPinName)
+	{
+		SyncFieldPins();
+	}
+}
+
+void UK2Node_OUULog::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	using namespace OUU::Editor::Private::K2Node_OUULog;
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+	UEdGraphPin* CategoryPin = FindPinChecked(CategoryPinName);
+	UEdGraphPin* VerbosityPin = FindPinChecked(VerbosityPinName);
+	UEdGraphPin* ThenPin = FindPinChecked(UEdGraphSchema_K2::PN_Then);
+
+	UK2Node_CallFunction* IsActiveNode = SpawnLibraryCall(
+		*this,
+		CompilerContext,
+		SourceGraph,
+		GET_FUNCTION_NAME_CHECKED(ULogOpenUnrealUtilitiesLibrary, IsLogCategoryActive));
+	CompilerContext.CopyPinLinksToIntermediate(*CategoryPin, *IsActiveNode->FindPinChecked(TEXT("CategoryName")));
+	CompilerContext.CopyPinLinksToIntermediate(*VerbosityPin, *IsActiveNode->FindPinChecked(TEXT("Verbosity")));
+
+	auto* BranchNode = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
+	BranchNode->AllocateDefaultPins();
+	Schema->TryCreateConnection(IsActiveNode->GetReturnValuePin(), BranchNode->GetConditionPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *BranchNode->GetExecPin());
+
+	UK2Node_CallFunction* LogNode = SpawnLibraryCall(
+		*this,
+		CompilerContext,
+		SourceGraph,
+		GET_FUNCTION_NAME_CHECKED(ULogOpenUnrealUtilitiesLibrary, LogStructured));
+	Schema->TryCreateConnection(BranchNode->GetThenPin(), LogNode->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*CategoryPin, *LogNode->FindPinChecked(TEXT("CategoryName")));
+	CompilerContext.MovePinLinksToIntermediate(*VerbosityPin, *LogNode->FindPinChecked(TEXT("Verbosity")));
+	CompilerContext.MovePinLinksToIntermediate(
+		*FindPinChecked(FormatPinName),
+		*LogNode->FindPinChecked(TEXT("Format")));
+
+	// Both the skipped and the executed log call continue with the nodes connected to our then pin
+	CompilerContext.CopyPinLinksToIntermediate(*ThenPin, *BranchNode->GetElsePin());
+	CompilerContext.MovePinLinksToIntermediate(*ThenPin, *LogNode->GetThenPin());
+
+	if (FieldNames.Num() > 0)
+	{
+		UK2Node_MakeArray* NamesNode = SpawnMakeArray(
+			*this,
+			CompilerContext,
+			SourceGraph,
+			*LogNode->FindPinChecked(TEXT("FieldNames")),
+			FieldNames.Num());
+		UK2Node_MakeArray* ValuesNode = SpawnMakeArray(
+			*this,
+			CompilerContext,
+			SourceGraph,
+			*LogNode->FindPinChecked(TEXT("FieldValues")),
+			FieldNames.Num());
+
+		for (int32 i = 0; i < FieldNames.Num(); i++)
+		{
+			const FName ArrayInputPinName = GetArrayInputPinName(i);
+			Schema->TrySetDefaultValue(*NamesNode->FindPinChecked(ArrayInputPinName), FieldNames[i]);
+			CompilerContext.MovePinLinksToIntermediate(
+				*FindPinChecked(FName(*FieldNames[i])),
+				*ValuesNode->FindPinChecked(ArrayInputPinName));
+		}
+	}
+
+	BreakAllNodeLinks();
+}
+
+void UK2Node_OUULog::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner);
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_OUULog::GetMenuCategory() const
+{
+	return INVTEXT("Open Unreal Utilities|Logging");
+}
+
+bool UK2Node_OUULog::IsFieldPin(const UEdGraphPin* Pin) const
+{
+	return Pin->Direction == EGPD_Input && Pin->PinCategory == UEdGraphSchema_K2::PC_String
+		&& Pin->PinName != OUU::Editor::Private::K2Node_OUULog::FormatPinName;
+}
+
+void UK2Node_OUULog::SyncFieldPins()
+{
+	using namespace OUU::Editor::Private::K2Node_OUULog;
+
+	// A connected format string is only known at runtime, so the previous fields are kept as they are.
+	const UEdGraphPin* FormatPin = FindPinChecked(FormatPinName);
+	if (FormatPin->LinkedTo.Num() > 0)
+		return;
+
+	TArray<FString> NewFieldNames = ULogOpenUnrealUtilitiesLibrary::ParseFormatFieldNames(FormatPin->DefaultValue);
+	NewFieldNames.RemoveAll(&IsReservedPinName);
+	if (NewFieldNames == FieldNames)
+		return;
+
+	Modify();
+	FieldNames = MoveTemp(NewFieldNames);
+
+	// Remove pins of fields that no longer exist, but keep the links of the remaining ones
+	for (int32 PinIdx = Pins.Num() - 1; PinIdx >= 0; --PinIdx)
+	{
+		UEdGraphPin* Pin = Pins[PinIdx];
+		if (IsFieldPin(Pin) && !FieldNames.Contains(Pin->PinName.ToString()))
+		{
+			RemovePin(Pin);
+		}
+	}
+	for (const FString& FieldName : FieldNames)
+	{
+		if (!FindPin(FName(*FieldName), EGPD_Input))
+		{
+			CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_String, FName(*FieldName));
+		}
+	}
+
+	GetGraph()->NotifyGraphChanged();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+}
@@ -0,0 +1,250 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "Commandlets/MaterialUsageAnalysisCommandlet.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "EditorWorldUtils.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "LogOpenUnrealUtilities.h"
+#include "MaterialUsageAnalysis.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "PackageTools.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDesc.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+
+namespace OUU::Editor::Private::MaterialUsageAnalysisCommandlet
+{
+	using namespace OUU::Developer::MaterialUsageAnalysis;
+
+	// Number of gathered primitives after which they are handed over to the aggregation task
+	constexpr int32 UsageChunkSize = 16 * 1024;
+
+	/**
+	 * Gathers usages on the game thread and aggregates them on a worker thread while the next actors/levels are
+	 * loaded. Only one chunk is in flight at a time, so memory stays bounded independent of the project size.
+	 */
+	class FAggregationPipeline
+	{
+	public:
+		~FAggregationPipeline() { Wait(); }
+
+		TArray<FPrimitiveUsage> PendingUsages;
+
+		void FlushIfFull(const FString& Level)
+		{
+			if (PendingUsages.Num() >= UsageChunkSize)
+			{
+				Flush(Level);
+			}
+		}
+
+		void Flush(const FString& Level)
+		{
+			Wait();
+			if (PendingUsages.Num() == 0)
+				return;
+
+			AggregationTask = UE::Tasks::Launch(
+				UE_SOURCE_LOCATION,
+				[this, Level, Usages = MoveTemp(PendingUsages)]() { Accumulator.AddLevelUsages(Level, Usages); });
+			PendingUsages.Reset();
+		}
+
+		/** @returns the accumulator after all in-flight usages were aggregated */
+		const FMaterialUsageAccumulator& Finish()
+		{
+			Wait();
+			return Accumulator;
+		}
+
+	private:
+		FMaterialUsageAccumulator Accumulator;
+		UE::Tasks::FTask AggregationTask;
+
+		void Wait()
+		{
+			if (AggregationTask.IsValid())
+			{
+				AggregationTask.Wait();
+			}
+		}
+	};
+
+	void GatherLevel(const ULevel& Level, FAggregationPipeline& Pipeline, const FString& LevelName)
+	{
+		for (const AActor* Actor : Level.Actors)
+		{
+			if (IsValid(Actor))
+			{
+				GatherPrimitiveUsages(*Actor, Pipeline.PendingUsages);
+				Pipeline.FlushIfFull(LevelName);
+			}
+		}
+	}
+
+	void GatherPartitionedWorld(UWorld& World, FAggregationPipeline& Pipeline, const FString& LevelName)
+	{
+		UWorld::InitializationValues IVS;
+		IVS.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true);
+		FScopedEditorWorld EditorWorld(&World, IVS);
+
+		UWorldPartition* WorldPartition = World.GetWorldPartition();
+		if (!WorldPartition)
+		{
+			UE_LOG(LogOpenUnrealUtilities, Error, TEXT("Failed to initialize world partition of %s"), *LevelName);
+			return;
+		}
+
+		// Loads actors incrementally and releases them (incl. garbage collection) when exceeding the memory budget.
+		// The usages don't hold object references, so they are not affected by unloading.
+		auto GatherActor = [&](const FWorldPartitionActorDesc* ActorDesc) {
+			if (const AActor* Actor = ActorDesc->GetActor())
+			{
+				GatherPrimitiveUsages(*Actor, Pipeline.PendingUsages);
+				Pipeline.FlushIfFull(LevelName);
+			}
+			return true;
+		};
+#if UE_VERSION_OLDER_THAN(5, 3, 0)
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, AActor::StaticClass(), GatherActor);
+#else
+		FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, GatherActor);
+#endif
+
+		// Persistent level actors that are not managed by world partition
+		GatherLevel(*World.PersistentLevel, Pipeline, LevelName);
+	}
+} // namespace OUU::Editor::Private::MaterialUsageAnalysisCommandlet
+
+UMaterialUsageAnalysisCommandlet::UMaterialUsageAnalysisCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMaterialUsageAnalysisCommandlet::Main(const FString& Params)
+{
+	using namespace OUU::Editor::Private::MaterialUsageAnalysisCommandlet;
+
+	TArray<FString> Tokens, Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<FString> Paths;
+	ParamValues.FindRef(TEXT("Paths")).ParseIntoArray(Paths, TEXT("+"));
+	if (Paths.Num() == 0)
+	{
+		Paths.Add(TEXT("/Game"));
+	}
+
+	const FString Format = ParamValues.Contains(TEXT("Format")) ? ParamValues[TEXT("Format")] : TEXT("all");
+	const bool bWriteCsv = Format == TEXT("csv") || Format == TEXT("all");
+	const bool bWriteJson = Format == TEXT("json") || Format == TEXT("all");
+	if (!bWriteCsv && !bWriteJson)
+	{
+		UE_LOG(LogOpenUnrealUtilities, Error, TEXT("Invalid -Format=%s. Expected csv, json or all."), *Format);
+		return 1;
+	}
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(*Path);
+	}
+
+	TArray<FAssetData> Maps;
+	AssetRegistry.GetAssets(Filter, Maps);
+	Maps.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+	UE_LOG(LogOpenUnrealUtilities, Display, TEXT("Analyzing material usage of %i maps"), Maps.Num());
+
+	FAggregationPipeline Pipeline;
+	FScopedSlowTask SlowTask(Maps.Num(), INVTEXT("Analyzing material usage"));
+	for (const FAssetData& Map : Maps)
+	{
+		const FString LevelName = Map.PackageName.ToString();
+		SlowTask.EnterProgressFrame(1.f, FText::FromString(LevelName));
+		UE_LOG(LogOpenUnrealUtilities, Display, TEXT("Loading %s"), *LevelName);
+
+		UPackage* Package = LoadPackage(nullptr, *LevelName, LOAD_None);
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World)
+		{
+			UE_LOG(LogOpenUnrealUtilities, Warning, TEXT("Failed to load map %s"), *LevelName);
+			continue;
+		}
+
+		if (World->IsPartitionedWorld())
+		{
+			GatherPartitionedWorld(*World, Pipeline, LevelName);
+		}
+		else
+		{
+			// Sub-levels are analyzed separately as maps of their own, so only the persistent level is relevant.
+			GatherLevel(*World->PersistentLevel, Pipeline, LevelName);
+		}
+		Pipeline.Flush(LevelName);
+
+		// Unload the map before loading the next one.
+		// Aggregation of the last chunk continues in the background, because it doesn't reference any objects.
+		// Map packages are standalone, so they must be unloaded explicitly. Otherwise GC keeps them alive in editor.
+		const TWeakObjectPtr<UPackage> WeakPackage = Package;
+		World = nullptr;
+		const TArray<UPackage*> PackagesToUnload = {Package};
+		UPackageTools::UnloadPackages(PackagesToUnload);
+		Package = nullptr;
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		if (WeakPackage.IsValid())
+		{
+			UE_LOG(
+				LogOpenUnrealUtilities,
+				Warning,
+				TEXT("Failed to unload map %s. Memory usage will grow with every analyzed map."),
+				*LevelName);
+		}
+	}
+
+	const FMaterialUsageAccumulator& Accumulator = Pipeline.Finish();
+	UE_LOG(
+		LogOpenUnrealUtilities,
+		Display,
+		TEXT("Found %i unique mesh/material combinations in %i maps"),
+		Accumulator.NumCombinations(),
+		Accumulator.GetLevelStats().Num());
+
+	const FString OutputBasePath = FPaths::ProjectSavedDir() / TEXT("MaterialUsageAnalysis")
+		/ FString::Printf(TEXT("MaterialUsage_%s"), *FDateTime::Now().ToString());
+	bool bSuccess = true;
+	if (bWriteCsv)
+	{
+		const FString FilePath = OutputBasePath + TEXT(".csv");
+		bSuccess &= Accumulator.WriteCsv(FilePath);
+		UE_LOG(LogOpenUnrealUtilities, Display, TEXT("Wrote material usage report to %s"), *FilePath);
+	}
+	if (bWriteJson)
+	{
+		const FString FilePath = OutputBasePath + TEXT(".json");
+		bSuccess &= Accumulator.WriteJson(FilePath);
+		UE_LOG(LogOpenUnrealUtilities, Display, TEXT("Wrote material usage report to %s"), *FilePath);
+	}
+
+	return bSuccess ? 0 : 1;
+}
@@ -16,6 +16,7 @@
 #include "KismetCompilerModule.h"
 #include "LogOpenUnrealUtilities.h"
 #include "Misc/FileHelper.h"
+#include "Misc/OUUPatternSet.h"
 #include "Misc/Paths.h"
 
 namespace OUU::Editor::CompileBlueprints
@@ -28,9 +29,10 @@ namespace OUU::Editor::CompileBlueprints
 		bool bCompileSkeletonOnly = false;
 		bool bCookedOnly = false;
 		bool bDirtyOnly = false;
-		TArray<FString> IncludeFolders;
-		TArray<FString> IgnoreFolders;
-		TArray<FString> WhitelistFiles;
+		// Asset paths are compared case insensitive like the FString comparisons these replace
+		FOUUPatternSet IncludeFolders{ESearchCase::IgnoreCase};
+		FOUUPatternSet IgnoreFolders{ESearchCase::IgnoreCase};
+		FOUUPatternSet WhitelistFiles{ESearchCase::IgnoreCase};
 		TArray<TPair<FString, TArray<FString>>> RequireAssetTags;
 		TArray<TPair<FString, TArray<FString>>> ExcludeAssetTags;
 		FTopLevelAssetPath BlueprintBaseClassName = UBlueprint::StaticClass()->GetClassPathName();
@@ -62,7 +64,7 @@ namespace OUU::Editor::CompileBlueprints
 			const FString& FullTagString,
 			TArray<TPair<FString, TArray<FString>>>& OutputAssetTags);
 
-		static void ParseFolders(const FString& FullFolderString, TArray<FString>& OutFolderList);
+		static void ParseFolders(const FString& FullFolderString, FOUUPatternSet& OutFolderPatterns);
 
 		void ParseWhitelist(const FString& WhitelistFilePath);
 
@@ -152,21 +154,21 @@ namespace OUU::Editor::CompileBlueprints
 			ParseTagPairs(FullTagInfo, ExcludeAssetTags);
 		}
 
-		IncludeFolders.Empty();
+		IncludeFolders.Reset();
 		if (SwitchParams.Contains(TEXT("IncludeFolders")))
 		{
 			const FString& AllIncludeFolders = SwitchParams[TEXT("IncludeFolders")];
 			ParseFolders(AllIncludeFolders, IncludeFolders);
 		}
 
-		IgnoreFolders.Empty();
+		IgnoreFolders.Reset();
 		if (SwitchParams.Contains(TEXT("IgnoreFolder")))
 		{
 			const FString& AllIgnoreFolders = SwitchParams[TEXT("IgnoreFolder")];
 			ParseFolders(AllIgnoreFolders, IgnoreFolders);
 		}
 
-		WhitelistFiles.Empty();
+		WhitelistFiles.Reset();
 		if (SwitchParams.Contains(TEXT("WhitelistFile")))
 		{
 			const FString& WhitelistFullPath = SwitchParams[TEXT("WhitelistFile")];
@@ -211,24 +213,30 @@ namespace OUU::Editor::CompileBlueprints
 
 	void FOUUCompileBlueprintsCommandHelper::ParseFolders(
 		const FString& FullFolderString,
-		TArray<FString>& OutFolderList)
+		FOUUPatternSet& OutFolderPatterns)
 	{
 		TArray<FString> ParsedFolders;
 		FullFolderString.ParseIntoArray(ParsedFolders, TEXT(","));
 
 		for (const FString& Folder : ParsedFolders)
 		{
-			OutFolderList.Add(Folder.TrimQuotes());
+			OutFolderPatterns.AddPrefix(Folder.TrimQuotes());
 		}
 	}
 
 	void FOUUCompileBlueprintsCommandHelper::ParseWhitelist(const FString& WhitelistFilePath)
 	{
 		const FString FilePath = FPaths::ProjectDir() + WhitelistFilePath;
-		if (!FFileHelper::LoadANSITextFileToStrings(*FilePath, &IFileManager::Get(), WhitelistFiles))
+		TArray<FString> WhitelistLines;
+		if (!FFileHelper::LoadANSITextFileToStrings(*FilePath, &IFileManager::Get(), WhitelistLines))
 		{
 			UE_LOG(LogOpenUnrealUtilities, Error, TEXT("Failed to Load Whitelist File! : %s"), *FilePath);
 		}
+
+		for (const FString& Line : WhitelistLines)
+		{
+			WhitelistFiles.AddExact(Line);
+		}
 	}
 
 	void FOUUCompileBlueprintsCommandHelper::BuildBlueprintAssetList()
@@ -305,14 +313,12 @@ namespace OUU::Editor::CompileBlueprints
 			bShouldBuild = false;
 		}
 
-		if (bShouldBuild && IncludeFolders.Num() > 0)
+		if (bShouldBuild && !IncludeFolders.IsEmpty())
 		{
-			bShouldBuild = IncludeFolders.ContainsByPredicate([Asset](const FString& IncludeFolder) -> bool {
-				return Asset.GetSoftObjectPath().ToString().StartsWith(IncludeFolder);
-			});
+			FString const AssetPath = Asset.GetSoftObjectPath().ToString();
+			bShouldBuild = IncludeFolders.MatchesAny(AssetPath);
 			if (!bShouldBuild)
 			{
-				FString const AssetPath = Asset.GetSoftObjectPath().ToString();
 				UE_LOG(
 					LogOpenUnrealUtilities,
 					Verbose,
@@ -321,20 +327,17 @@ namespace OUU::Editor::CompileBlueprints
 			}
 		}
 
-		if (IgnoreFolders.Num() > 0)
+		if (!IgnoreFolders.IsEmpty())
 		{
-			for (const FString& IgnoreFolder : IgnoreFolders)
+			FString const AssetPath = Asset.GetSoftObjectPath().ToString();
+			if (IgnoreFolders.MatchesAny(AssetPath))
 			{
-				if (Asset.GetSoftObjectPath().ToString().StartsWith(IgnoreFolder))
-				{
-					FString const AssetPath = Asset.GetSoftObjectPath().ToString();
-					UE_LOG(
-						LogOpenUnrealUtilities,
-						Verbose,
-						TEXT("Skipping Building %s: As Object is in an Ignored Folder"),
-						*AssetPath);
-					bShouldBuild = false;
-				}
+				UE_LOG(
+					LogOpenUnrealUtilities,
+					Verbose,
+					TEXT("Skipping Building %s: As Object is in an Ignored Folder"),
+					*AssetPath);
+				bShouldBuild = false;
 			}
 		}
 
@@ -356,7 +359,7 @@ namespace OUU::Editor::CompileBlueprints
 			bShouldBuild = false;
 		}
 
-		if ((WhitelistFiles.Num() > 0) && (!CheckInWhitelist(Asset)))
+		if (!WhitelistFiles.IsEmpty() && !CheckInWhitelist(Asset))
 		{
 			FString const AssetPath = Asset.GetSoftObjectPath().ToString();
 			UE_LOG(
@@ -422,19 +425,7 @@ namespace OUU::Editor::CompileBlueprints
 
 	bool FOUUCompileBlueprintsCommandHelper::CheckInWhitelist(FAssetData const& Asset) const
 	{
-		bool bIsInWhitelist = false;
-
-		const FString& AssetFilePath = Asset.GetSoftObjectPath().ToString();
-		for (const FString& WhiteList : WhitelistFiles)
-		{
-			if (AssetFilePath == WhiteList)
-			{
-				bIsInWhitelist = true;
-				break;
-			}
-		}
-
-		return bIsInWhitelist;
+		return WhitelistFiles.MatchesAny(Asset.GetSoftObjectPath().ToString());
 	}
 
 	void FOUUCompileBlueprintsCommandHelper::CompileBlueprint(UBlueprint* Blueprint)
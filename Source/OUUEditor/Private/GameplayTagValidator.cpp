@@ -7,7 +7,8 @@
 #include "GameplayTagsManager.h"
 #include "GameplayTagsModule.h"
 #include "LogOpenUnrealUtilities.h"
-#include "Logging/MessageLogMacros.h"
+#include "Logging/MessageLogBatch.h"
+#include "Logging/MessageLogBlueprintLibrary.h"
 #include "Misc/DataValidation.h"
 
 FAutoConsoleCommand GTagsValidateCommand{
@@ -113,19 +114,23 @@ void UGameplayTagValidatorSubsystem::ValidateGameplayTagTree()
 	TArray<FText> Warnings, Errors;
 	ValidationContext.SplitIssues(OUT Warnings, OUT Errors);
 
-	#define MESSAGE_LOG_CAT AssetCheck
-	const auto MessageLogName = GetMessageLogName(EMessageLogName::MESSAGE_LOG_CAT);
-
-	UMessageLogBlueprintLibrary::NewMessageLogPage(MessageLogName, INVTEXT("Gameplay Tag Validation"));
+	const auto MessageLogName = GetMessageLogName(EMessageLogName::AssetCheck);
 
+	// Large tag trees can produce thousands of issues, which are added to the message log in one go.
+	FMessageLogBatch MessageLogBatch(MessageLogName, INVTEXT("Gameplay Tag Validation"));
 	for (const auto& Error : Errors)
 	{
-		UE_MESSAGELOG(MESSAGE_LOG_CAT, Error, Error);
+		MessageLogBatch.Add(EMessageLogSeverity::Error, Error);
 	}
 	for (const auto& Warning : Warnings)
 	{
-		UE_MESSAGELOG(MESSAGE_LOG_CAT, Warning, Warning);
+		MessageLogBatch.Add(EMessageLogSeverity::Warning, Warning);
+	}
+	if (Errors.Num() == 0 && Warnings.Num() == 0)
+	{
+		MessageLogBatch.Add(EMessageLogSeverity::Info, INVTEXT("No GameplayTag validation issues found."));
 	}
+	MessageLogBatch.Commit();
 
 	if (Errors.Num() > 0)
 	{
@@ -141,11 +146,6 @@ void UGameplayTagValidatorSubsystem::ValidateGameplayTagTree()
 			FText::Format(INVTEXT("{0} GameplayTag validation warnings"), Warnings.Num()),
 			EMessageLogSeverity::Info);
 	}
-	else
-	{
-		UE_MESSAGELOG(MESSAGE_LOG_CAT, Info, "No GameplayTag validation issues found.");
-	}
-	#undef MESSAGE_LOG_CAT
 }
 
 void UGameplayTagValidatorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -4,10 +4,10 @@
 
 #include "Animation/AnimBlueprint.h"
 #include "Animation/AnimInstance.h"
-#include "Animation/BoneChainRange.h"
+#include "Animation/BoneHierarchyAccelerator.h"
 #include "Animation/TraverseBoneTree.h"
 #include "MeshUtilities.h"
-#include "Misc/RegexUtils.h"
+#include "Misc/OUUPatternSet.h"
 #include "Modules/ModuleManager.h"
 #include "Rendering/SkeletalMeshRenderData.h"
 #include "ScopedTransaction.h"
@@ -76,23 +76,35 @@ int32 UOUUAnimationEditorLibrary::RemoveUnskinnedBonesFromMesh(
 		Include
 	};
 
+	// Compile the patterns once instead of for every bone
+	FOUUPatternSet IncludePatterns, ExcludePatterns;
+	if (BoneNameIncludePattern.Len() > 0)
+	{
+		IncludePatterns.AddRegex(BoneNameIncludePattern);
+	}
+	if (BoneNameExcludePattern.Len() > 0)
+	{
+		ExcludePatterns.AddRegex(BoneNameExcludePattern);
+	}
+
 	auto FilterBoneName = [&](int32 MeshBoneIndex, FName BoneName) -> EFilterAction {
 		// Skip bone that are vertex weighted / skinned -> continue with children
 		if (LODData.ActiveBoneIndices.Find(MeshBoneIndex) != INDEX_NONE)
 			return EFilterAction::Exclude;
 		const auto BoneNameString = BoneName.ToString();
-		if (BoneNameIncludePattern.Len() > 0
-			&& !OUU::Runtime::RegexUtils::MatchesRegex(BoneNameIncludePattern, BoneNameString))
+		if (!IncludePatterns.IsEmpty() && !IncludePatterns.MatchesAny(BoneNameString))
 			return EFilterAction::Unknown;
-		if (BoneNameExcludePattern.Len() > 0
-			&& OUU::Runtime::RegexUtils::MatchesRegex(BoneNameExcludePattern, BoneNameString))
+		if (ExcludePatterns.MatchesAny(BoneNameString))
 			return EFilterAction::Exclude;
 		return EFilterAction::Include;
 	};
 
+	using OUU::Runtime::Animation::EBoneChainDirection;
 	using OUU::Runtime::Animation::EBoneChainLeaf;
 	using OUU::Runtime::Animation::ETraverseBoneTreeAction;
-	using OUU::Runtime::Animation::TBoneChainRange;
+
+	// Bone chains of the mesh are walked for many bones, so the hierarchy is only evaluated once
+	const OUU::Runtime::Animation::FBoneHierarchyAccelerator MeshHierarchy(SkeletalMesh->GetRefSkeleton());
 
 	OUU::Runtime::Animation::TraverseBoneTree(Skeleton, [&](int32 SkeletonBoneIndex) -> ETraverseBoneTreeAction {
 		const auto BoneName = Skeleton->GetReferenceSkeleton().GetBoneName(SkeletonBoneIndex);
@@ -112,8 +124,8 @@ int32 UOUUAnimationEditorLibrary::RemoveUnskinnedBonesFromMesh(
 		{
 			BonesToKeep_Indices.Add(MeshBoneIndex);
 			// This bone is excluded. If any parent bone was included we must remove it from the list.
-			for (const FBoneIndexType ParentBoneIndex :
-				 TBoneChainRange(SkeletalMesh->GetRefSkeleton(), MeshBoneIndex, EBoneChainLeaf::Exclude))
+			for (const int32 ParentBoneIndex :
+				 MeshHierarchy.GetBoneChain<EBoneChainDirection::LeafToRoot>(MeshBoneIndex, EBoneChainLeaf::Exclude))
 			{
 				BonesToKeep_Indices.Add(ParentBoneIndex);
 				if (BonesToRemove_Indices.Contains(ParentBoneIndex))
@@ -144,8 +156,8 @@ int32 UOUUAnimationEditorLibrary::RemoveUnskinnedBonesFromMesh(
 	{
 		auto BoneName = SkeletalMesh->GetRefSkeleton().GetBoneName(MeshBoneIndex);
 		bool bIsImplicitlyExcluded = false;
-		for (const FBoneIndexType ParentMeshBoneIndex :
-			 TBoneChainRange(SkeletalMesh->GetRefSkeleton(), MeshBoneIndex, EBoneChainLeaf::Exclude))
+		for (const int32 ParentMeshBoneIndex :
+			 MeshHierarchy.GetBoneChain<EBoneChainDirection::LeafToRoot>(MeshBoneIndex, EBoneChainLeaf::Exclude))
 		{
 			if (BonesToRemove_Indices.Contains(ParentMeshBoneIndex))
 			{
@@ -0,0 +1,44 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "K2Node.h"
+
+#include "K2Node_OUULog.generated.h"
+
+/**
+ * Blueprint log node that writes a formatted message with key/value fields to an arbitrary log category.
+ *
+ * Every {Name} argument in the format string adds a string input pin for the field of the same name.
+ * The node expands to a verbosity check that branches around the actual log call. Pure nodes connected to the
+ * field pins are only evaluated by the log call, so messages that are filtered out don't cost any string building.
+ */
+UCLASS()
+class OUUEDITOR_API UK2Node_OUULog : public UK2Node
+{
+	GENERATED_BODY()
+public:
+	// - UEdGraphNode
+	void AllocateDefaultPins() override;
+	FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	FText GetTooltipText() const override;
+	void PinDefaultValueChanged(UEdGraphPin* Pin) override;
+	void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	// - UK2Node
+	void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	FText GetMenuCategory() const override;
+	// --
+
+private:
+	/** Field names parsed from the format string. Stored separately, so linked format pins keep their fields. */
+	UPROPERTY()
+	TArray<FString> FieldNames;
+
+	bool IsFieldPin(const UEdGraphPin* Pin) const;
+
+	/** Parse the field names from the format pin and add/remove field pins accordingly. */
+	void SyncFieldPins();
+};
@@ -0,0 +1,29 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Commandlets/Commandlet.h"
+
+#include "MaterialUsageAnalysisCommandlet.generated.h"
+
+/**
+ * Project wide variant of the ouu.Debug.MaterialUsageAnalysis console commands.
+ * Loads all maps one after another (world partition maps actor by actor with memory bound unloading) and writes
+ * the accumulated mesh/material combination stats sorted by instance count to Saved/MaterialUsageAnalysis/.
+ *
+ * Usage:
+ * UnrealEditor-Cmd <Project> -run=MaterialUsageAnalysis [-Paths=/Game/Maps+/Game/Other] [-Format=csv|json|all]
+ */
+UCLASS()
+class OUUEDITOR_API UMaterialUsageAnalysisCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UMaterialUsageAnalysisCommandlet();
+
+	// - UCommandlet
+	int32 Main(const FString& Params) override;
+	// --
+};
@@ -0,0 +1,157 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "Animation/BoneHierarchyAccelerator.h"
+
+#include "LogOpenUnrealUtilities.h"
+#include "ReferenceSkeleton.h"
+
+namespace OUU::Runtime::Animation
+{
+	FBoneHierarchyAccelerator::FBoneHierarchyAccelerator(const FReferenceSkeleton& ReferenceSkeleton)
+	{
+		Build(ReferenceSkeleton);
+	}
+
+	void FBoneHierarchyAccelerator::Build(const FReferenceSkeleton& ReferenceSkeleton)
+	{
+		const int32 NumBones = ReferenceSkeleton.GetNum();
+		TArray<int32> SkeletonParentIndices;
+		SkeletonParentIndices.SetNumUninitialized(NumBones);
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			SkeletonParentIndices[BoneIndex] = ReferenceSkeleton.GetParentIndex(BoneIndex);
+		}
+		Build(SkeletonParentIndices);
+	}
+
+	void FBoneHierarchyAccelerator::Build(TConstArrayView<int32> InParentIndices)
+	{
+		Reset();
+
+		const int32 NumBones = InParentIndices.Num();
+		ParentIndices.Append(InParentIndices.GetData(), InParentIndices.Num());
+		Depths.SetNumUninitialized(NumBones);
+
+		int32 MaxDepth = 0;
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			int32& ParentIndex = ParentIndices[BoneIndex];
+			if (ParentIndex >= BoneIndex || ParentIndex < INDEX_NONE)
+			{
+				UE_LOG(
+					LogOpenUnrealUtilities,
+					Error,
+					TEXT("Bone %i has invalid parent index %i. Parents must be listed before their children. "
+						 "The bone is treated as root bone."),
+					BoneIndex,
+					ParentIndex);
+				ParentIndex = INDEX_NONE;
+			}
+			Depths[BoneIndex] = ParentIndex == INDEX_NONE ? 0 : Depths[ParentIndex] + 1;
+			MaxDepth = FMath::Max(MaxDepth, Depths[BoneIndex]);
+		}
+
+		// Child lists: count the children per bone, then fill them in ascending order
+		ChildOffsets.SetNumZeroed(NumBones + 1);
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			const int32 ParentIndex = ParentIndices[BoneIndex];
+			if (ParentIndex != INDEX_NONE)
+			{
+				ChildOffsets[ParentIndex + 1]++;
+			}
+		}
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			ChildOffsets[BoneIndex + 1] += ChildOffsets[BoneIndex];
+		}
+		ChildIndices.SetNumUninitialized(ChildOffsets[NumBones]);
+		{
+			TArray<int32> NextChildSlots(ChildOffsets.GetData(), NumBones);
+			for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+			{
+				const int32 ParentIndex = ParentIndices[BoneIndex];
+				if (ParentIndex != INDEX_NONE)
+				{
+					ChildIndices[NextChildSlots[ParentIndex]++] = BoneIndex;
+				}
+			}
+		}
+
+		// Subtree sizes in reverse order, because all children are listed after their parents
+		TArray<int32> SubtreeSizes;
+		SubtreeSizes.Init(1, NumBones);
+		for (int32 BoneIndex = NumBones - 1; BoneIndex >= 0; BoneIndex--)
+		{
+			const int32 ParentIndex = ParentIndices[BoneIndex];
+			if (ParentIndex != INDEX_NONE)
+			{
+				SubtreeSizes[ParentIndex] += SubtreeSizes[BoneIndex];
+			}
+		}
+
+		// Depth first entry indices without an explicit traversal: Every bone reserves a slot range of its subtree
+		// size right after the last subtree of its previous siblings.
+		EntryIndices.SetNumUninitialized(NumBones);
+		ExitIndices.SetNumUninitialized(NumBones);
+		TArray<int32> NextChildEntryIndices;
+		NextChildEntryIndices.SetNumUninitialized(NumBones);
+		int32 NextRootEntryIndex = 0;
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			const int32 ParentIndex = ParentIndices[BoneIndex];
+			int32& NextEntryIndex =
+				ParentIndex == INDEX_NONE ? NextRootEntryIndex : NextChildEntryIndices[ParentIndex];
+			EntryIndices[BoneIndex] = NextEntryIndex;
+			ExitIndices[BoneIndex] = NextEntryIndex + SubtreeSizes[BoneIndex];
+			NextEntryIndex = ExitIndices[BoneIndex];
+			NextChildEntryIndices[BoneIndex] = EntryIndices[BoneIndex] + 1;
+		}
+
+		// Binary lifting: the 2^L-th ancestor is the 2^(L-1)-th ancestor of the 2^(L-1)-th ancestor
+		NumLevels = FMath::Max(1, FMath::CeilLogTwo(static_cast<uint32>(MaxDepth) + 1));
+		AncestorTable.SetNumUninitialized(NumLevels * NumBones);
+		FMemory::Memcpy(AncestorTable.GetData(), ParentIndices.GetData(), NumBones * sizeof(int32));
+		for (int32 Level = 1; Level < NumLevels; Level++)
+		{
+			const int32* PreviousLevel = AncestorTable.GetData() + (Level - 1) * NumBones;
+			int32* CurrentLevel = AncestorTable.GetData() + Level * NumBones;
+			for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+			{
+				const int32 HalfwayAncestor = PreviousLevel[BoneIndex];
+				CurrentLevel[BoneIndex] = HalfwayAncestor == INDEX_NONE ? INDEX_NONE : PreviousLevel[HalfwayAncestor];
+			}
+		}
+	}
+
+	void FBoneHierarchyAccelerator::Reset()
+	{
+		ParentIndices.Reset();
+		Depths.Reset();
+		ChildOffsets.Reset();
+		ChildIndices.Reset();
+		EntryIndices.Reset();
+		ExitIndices.Reset();
+		AncestorTable.Reset();
+		NumLevels = 0;
+	}
+
+	int32 FBoneHierarchyAccelerator::GetAncestorAtDepth(int32 BoneIndex, int32 Depth) const
+	{
+		const int32 BoneDepth = Depths[BoneIndex];
+		if (Depth < 0 || Depth > BoneDepth)
+			return INDEX_NONE;
+
+		const int32 NumBones = ParentIndices.Num();
+		int32 Result = BoneIndex;
+		uint32 NumSteps = static_cast<uint32>(BoneDepth - Depth);
+		for (int32 Level = 0; NumSteps != 0; Level++, NumSteps >>= 1)
+		{
+			if (NumSteps & 1)
+			{
+				Result = AncestorTable[Level * NumBones + Result];
+			}
+		}
+		return Result;
+	}
+} // namespace OUU::Runtime::Animation
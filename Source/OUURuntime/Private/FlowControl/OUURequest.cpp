@@ -21,6 +21,7 @@ void UOUURequest::Raise()
 		return;
 
 	ChangeState(EOUURequestState::Pending);
+	OnRaisedNative.Broadcast(this);
 	OnRaised.Broadcast(this);
 }
 
@@ -30,6 +31,12 @@ void UOUURequest::RaiseAndWait(FOnRequestStatusChangedDelegate CompletedCallback
 	Raise();
 }
 
+void UOUURequest::RaiseAndWaitNative(FOnRequestStatusChangedNative::FDelegate CompletedCallback)
+{
+	NativeCompletedCallbacks.Add(MoveTemp(CompletedCallback));
+	Raise();
+}
+
 void UOUURequest::Cancel()
 {
 	if (State != EOUURequestState::Pending)
@@ -59,15 +66,75 @@ EOUURequestState UOUURequest::GetState() const
 	return State;
 }
 
+double UOUURequest::GetStateEnterTime(EOUURequestState InState) const
+{
+	return StateEnterTimes[static_cast<int32>(InState)];
+}
+
+double UOUURequest::GetLatency() const
+{
+	const double RaiseTime = GetStateEnterTime(EOUURequestState::Pending);
+	for (const EOUURequestState CompletionState :
+		 {EOUURequestState::Canceled, EOUURequestState::Successful, EOUURequestState::Failed})
+	{
+		const double CompletionTime = GetStateEnterTime(CompletionState);
+		if (CompletionTime > 0.0)
+			return CompletionTime - RaiseTime;
+	}
+	return 0.0;
+}
+
+bool UOUURequest::IsValidStateTransition(EOUURequestState From, EOUURequestState To)
+{
+	switch (From)
+	{
+	case EOUURequestState::Idle: return To == EOUURequestState::Pending;
+	case EOUURequestState::Pending:
+		return To == EOUURequestState::Canceled || To == EOUURequestState::Successful
+			|| To == EOUURequestState::Failed;
+	case EOUURequestState::Canceled:
+	case EOUURequestState::Successful:
+	case EOUURequestState::Failed: return To == EOUURequestState::Idle;
+	default: return false;
+	}
+}
+
 void UOUURequest::ChangeState(EOUURequestState NewState)
 {
 	if (State == NewState)
 		return;
+#if DO_CHECK
+	if (!ensureMsgf(
+			IsValidStateTransition(State, NewState),
+			TEXT("Illegal state transition %s -> %s of request %s"),
+			*LexToString(State),
+			*LexToString(NewState),
+			*GetNameSafe(this)))
+		return;
+#endif
+
+	const double Now = FPlatformTime::Seconds();
+	if (NewState == EOUURequestState::Pending)
+	{
+		// Completion times of the previous request cycle are no longer valid
+		FMemory::Memzero(StateEnterTimes);
+	}
+	StateEnterTimes[static_cast<int32>(NewState)] = Now;
+
 	State = NewState;
+	OnStatusChangedNative.Broadcast(this, NewState);
 	OnStatusChanged.Broadcast(this, NewState);
 	if (NewState == EOUURequestState::Successful || NewState == EOUURequestState::Failed
 		|| NewState == EOUURequestState::Canceled)
 	{
+		// Callbacks may bind new callbacks for the next request cycle
+		auto CompletedCallbacks = MoveTemp(NativeCompletedCallbacks);
+		NativeCompletedCallbacks.Reset();
+		for (auto& Callback : CompletedCallbacks)
+		{
+			Callback.ExecuteIfBound(this, NewState);
+		}
+		OnCompletedNative.Broadcast(this, NewState);
 		OnCompleted.Broadcast(this, NewState);
 		if (bResetAfterCompletion)
 		{
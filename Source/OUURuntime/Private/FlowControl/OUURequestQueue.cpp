@@ -14,8 +14,8 @@ UOUURequest* UOUURequestQueue::CreateNewRequest()
 	const UClass* RequestClassToUse = ensure(*RequestClass) ? *RequestClass : UOUURequest::StaticClass();
 	UOUURequest* Request = NewObject<UOUURequest>(GetTransientPackage(), RequestClassToUse);
 	RequestQueue.Add(Request);
-	Request->OnCompleted.AddDynamic(this, &UOUURequestQueue::HandleRequestCompleted);
-	Request->OnRaised.AddDynamic(this, &UOUURequestQueue::HandleRequestRaised);
+	Request->OnCompletedNative.AddUObject(this, &UOUURequestQueue::HandleRequestCompleted);
+	Request->OnRaisedNative.AddUObject(this, &UOUURequestQueue::HandleRequestRaised);
 	return Request;
 }
 
@@ -53,6 +53,16 @@ UOUURequest* UOUURequestQueue::GetOldestRequestWithState(EOUURequestState State)
 	return nullptr;
 }
 
+const TCircularHistogramAggregator<double>* UOUURequestQueue::GetLatencyHistogram() const
+{
+	return LatencyHistogram.Get();
+}
+
+void UOUURequestQueue::ResetLatencyHistogram()
+{
+	LatencyHistogram.Reset();
+}
+
 // ReSharper disable once CppMemberFunctionMayBeConst
 void UOUURequestQueue::HandleRequestRaised(UOUURequest* Request)
 {
@@ -62,8 +72,22 @@ void UOUURequestQueue::HandleRequestRaised(UOUURequest* Request)
 
 void UOUURequestQueue::HandleRequestCompleted(UOUURequest* Request, EOUURequestState State)
 {
-	Request->OnCompleted.RemoveDynamic(this, &UOUURequestQueue::HandleRequestCompleted);
-	Request->OnRaised.RemoveDynamic(this, &UOUURequestQueue::HandleRequestRaised);
+	Request->OnCompletedNative.RemoveAll(this);
+	Request->OnRaisedNative.RemoveAll(this);
 	RequestQueue.Remove(Request);
+
+	if (bRecordLatencyHistogram && State != EOUURequestState::Canceled)
+	{
+		if (!LatencyHistogram)
+		{
+			LatencyHistogram = MakeUnique<TCircularHistogramAggregator<double>>(
+				FMath::Max(LatencyHistogramNumSamples, 1),
+				0.0,
+				FMath::Max<double>(LatencyHistogramMaxSeconds, 0.001),
+				FMath::Max(LatencyHistogramNumBuckets, 1));
+		}
+		LatencyHistogram->Add(Request->GetLatency());
+	}
+
 	OnCompleted.Broadcast(Request, State);
 }
@@ -21,6 +21,7 @@
 	#include "GameplayEffect.h"
 	#include "GameplayTagContainer.h"
 	#include "GameplayTagsManager.h"
+	#include "Internationalization/Regex.h"
 	#include "Misc/RegexUtils.h"
 	#include "Templates/ReverseIterator.h"
 	#include "Templates/StringUtils.h"
@@ -32,6 +33,170 @@ TAutoConsoleVariable<FString> AbilityFilter{
 	TEXT("Regular expression filter for ability names. Default value: '.*' (allow all)."),
 	ECVF_Cheat};
 
+TAutoConsoleVariable<float> AttributeChangeHighlightDuration{
+	TEXT("ouu.Debug.Ability.AttributeChangeHighlightDuration"),
+	2.f,
+	TEXT("Time in seconds for which attributes are highlighted after their value changed."),
+	ECVF_Cheat};
+
+TAutoConsoleVariable<FString> EventFilter{
+	TEXT("ouu.Debug.Ability.EventFilter"),
+	TEXT(""),
+	TEXT("Gameplay tag filter for the gameplay event history. Only events with this tag or its child tags are displayed. "
+		 "Default value: '' (allow all)."),
+	ECVF_Cheat};
+
+TAutoConsoleVariable<FString> CueFilter{
+	TEXT("ouu.Debug.Ability.CueFilter"),
+	TEXT(".*"),
+	TEXT("Regular expression filter for gameplay cue tags (without the GameplayCue. prefix). Default value: '.*' (allow "
+		 "all)."),
+	ECVF_Cheat};
+
+namespace OUU::Runtime::Private::AbilitiesDebugger
+{
+	/** Filters that pass everything are not evaluated, so the default filter has no regex cost */
+	FORCEINLINE bool IsPassAllFilter(const FString& Filter) { return Filter.IsEmpty() || Filter == TEXT(".*"); }
+
+	/** Seconds after which the cached debug string of an active ability task is rebuilt */
+	constexpr double TaskDebugStringRefreshInterval = 0.1;
+} // namespace OUU::Runtime::Private::AbilitiesDebugger
+
+void FGameplayDebuggerCategory_OUUAbilities::FGameplayCueDebugIndex::Update(
+	const UGameplayCueManager* CueManager,
+	const FString& Filter)
+{
+	const UGameplayCueSet* CueSet = IsValid(CueManager) ? CueManager->GetRuntimeCueSet() : nullptr;
+	if (!IsValid(CueSet))
+	{
+		Entries.Reset();
+		FilteredEntries.Reset();
+		IndexedCueSet.Reset();
+		NumIndexedCueData = INDEX_NONE;
+		return;
+	}
+
+	// The cue data is only ever added/removed as a whole (e.g. when adding new cue notify assets in the editor),
+	// so checking the number of entries is enough to detect changes.
+	if (IndexedCueSet.Get() != CueSet || NumIndexedCueData != CueSet->GameplayCueData.Num())
+	{
+		Rebuild(*CueSet);
+	}
+	else
+	{
+		// Only cues that were not loaded before can change their load state.
+		for (int32 i = NotLoadedEntries.Num() - 1; i >= 0; --i)
+		{
+			FEntry& Entry = Entries[NotLoadedEntries[i]];
+			UpdateLoadState(Entry, *CueSet);
+			if (Entry.Type != ECueType::NotLoaded)
+			{
+				NotLoadedEntries.RemoveAtSwap(i);
+			}
+		}
+	}
+
+	if (Filter != CurrentFilter)
+	{
+		CurrentFilter = Filter;
+		bFilterDirty = true;
+	}
+	if (bFilterDirty)
+	{
+		UpdateFilter();
+	}
+}
+
+void FGameplayDebuggerCategory_OUUAbilities::FGameplayCueDebugIndex::Rebuild(const UGameplayCueSet& CueSet)
+{
+	IndexedCueSet = &CueSet;
+	NumIndexedCueData = CueSet.GameplayCueData.Num();
+	Entries.Reset(NumIndexedCueData);
+	NotLoadedEntries.Reset();
+
+	const FString BaseCueTagString = UGameplayCueSet::BaseGameplayCueTag().ToString();
+	for (int32 CueDataIdx = 0; CueDataIdx < NumIndexedCueData; ++CueDataIdx)
+	{
+		const FGameplayCueNotifyData& CueData = CueSet.GameplayCueData[CueDataIdx];
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Tag = CueData.GameplayCueTag;
+		Entry.CueDataIdx = CueDataIdx;
+		Entry.TagDisplayString = CueData.GameplayCueTag.ToString();
+		Entry.TagDisplayString.RemoveFromStart(BaseCueTagString);
+		Entry.TagDisplayString.RemoveFromStart(TEXT("."));
+
+		UpdateLoadState(Entry, CueSet);
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B) { return A.TagDisplayString < B.TagDisplayString; });
+	for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); ++EntryIdx)
+	{
+		if (Entries[EntryIdx].Type == ECueType::NotLoaded)
+		{
+			NotLoadedEntries.Add(EntryIdx);
+		}
+	}
+
+	bFilterDirty = true;
+}
+
+void FGameplayDebuggerCategory_OUUAbilities::FGameplayCueDebugIndex::UpdateLoadState(
+	FEntry& Entry,
+	const UGameplayCueSet& CueSet) const
+{
+	if (!CueSet.GameplayCueData.IsValidIndex(Entry.CueDataIdx))
+		return;
+
+	const UClass* CueClass = CueSet.GameplayCueData[Entry.CueDataIdx].LoadedGameplayCueClass;
+	if (CueClass == nullptr)
+	{
+		Entry.Type = ECueType::NotLoaded;
+		return;
+	}
+
+	const UObject* CDO = CueClass->GetDefaultObject();
+	if (Cast<UGameplayCueNotify_Static>(CDO) != nullptr)
+	{
+		Entry.Type = ECueType::Static;
+	}
+	else if (Cast<AGameplayCueNotify_Actor>(CDO) != nullptr)
+	{
+		Entry.Type = ECueType::Actor;
+	}
+	else
+	{
+		Entry.Type = ECueType::Other;
+	}
+	Entry.CueClassDisplayString = OUU::Runtime::GameplayDebuggerUtils::CleanupName(CueClass->GetName());
+	Entry.CachedLine.Reset();
+	Entry.CachedLineActiveCount = INDEX_NONE;
+}
+
+void FGameplayDebuggerCategory_OUUAbilities::FGameplayCueDebugIndex::UpdateFilter()
+{
+	bFilterDirty = false;
+	FilteredEntries.Reset();
+	if (OUU::Runtime::Private::AbilitiesDebugger::IsPassAllFilter(CurrentFilter))
+	{
+		FilteredEntries.Reserve(Entries.Num());
+		for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); ++EntryIdx)
+		{
+			FilteredEntries.Add(EntryIdx);
+		}
+		return;
+	}
+
+	const FRegexPattern FilterPattern(CurrentFilter);
+	for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); ++EntryIdx)
+	{
+		FRegexMatcher Matcher(FilterPattern, Entries[EntryIdx].TagDisplayString);
+		if (Matcher.FindNext())
+		{
+			FilteredEntries.Add(EntryIdx);
+		}
+	}
+}
+
 void FGameplayDebuggerCategory_OUUAbilities::DrawBackground(
 	FGameplayDebuggerCanvasContext& CanvasContext,
 	const FVector2D& BackgroundLocation,
@@ -134,9 +299,45 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 	// -------------------------------------------------------------
 
 	{
-		TSet<FGameplayAttribute> DrawAttributes;
 		DrawTitle(Info, "ATTRIBUTES");
 
+		if (AttributeDebugCache.Owner.Get() != AbilitySystem)
+		{
+			AttributeDebugCache.Reset();
+			AttributeDebugCache.Owner = AbilitySystem;
+		}
+
+		const double Now = AbilitySystem->GetWorld()->GetTimeSeconds();
+		const float HighlightDuration = AttributeChangeHighlightDuration.GetValueOnGameThread();
+
+		// Draws the cached line of an attribute and highlights it if the value changed recently
+		auto DrawAttributeLine = [&](const FAttributeDebugCache::FEntry& Entry) {
+			const double TimeSinceChange = Now - Entry.LastChangeTime;
+			const bool bHighlight = Entry.LastChangeTime >= 0.0 && TimeSinceChange < HighlightDuration;
+			if (Info.Canvas)
+			{
+				Info.Canvas->SetDrawColor(bHighlight ? FColorList::Orange : FColor::White);
+			}
+
+			if (bHighlight)
+			{
+				// Only highlighted lines are formatted every frame, because the time since the change is displayed.
+				DebugLine(
+					Info,
+					FString::Printf(
+						TEXT("%s [%+.2f %.2fs ago]"),
+						*Entry.Line,
+						Entry.LastChangeDelta,
+						static_cast<float>(TimeSinceChange)),
+					4.f,
+					0.f);
+			}
+			else
+			{
+				DebugLine(Info, Entry.Line, 4.f, 0.f);
+			}
+		};
+
 		TArray<FGameplayAttribute> AllAttributes;
 		AbilitySystem->GetAllAttributes(AllAttributes);
 		for (auto& Attribute : AllAttributes)
@@ -154,86 +355,96 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 				continue;
 			}
 
-			float FinalValue = AbilitySystem->GetNumericAttribute(Attribute);
-			float BaseValue = SnapshotAggregator.GetBaseValue();
+			const float FinalValue = AbilitySystem->GetNumericAttribute(Attribute);
+			const float BaseValue = SnapshotAggregator.GetBaseValue();
 
-			FString PaddedAttributeName = Attribute.GetName();
-			while (PaddedAttributeName.Len() < 30)
-				PaddedAttributeName += " ";
-
-			FString AttributeString =
-				FString::Printf(TEXT("%s %.2f "), *PaddedAttributeName, AbilitySystem->GetNumericAttribute(Attribute));
-			if (FMath::Abs<float>(BaseValue - FinalValue) > SMALL_NUMBER)
-			{
-				AttributeString += FString::Printf(TEXT(" (Base: %.2f)"), BaseValue);
-			}
-
-			if (Info.Canvas)
+			// Hash all mod properties that are displayed, so we only have to reformat if the mods changed
+			uint32 ModListHash = 0;
+			for (const auto& CurMapElement : ModMap)
 			{
-				Info.Canvas->SetDrawColor(FColor::White);
+				ModListHash = HashCombine(ModListHash, GetTypeHash(static_cast<uint8>(CurMapElement.Key)));
+				for (int32 ModOpIdx = 0; ModOpIdx < EGameplayModOp::Max; ++ModOpIdx)
+				{
+					for (const FAggregatorMod& Mod : CurMapElement.Value[ModOpIdx])
+					{
+						ModListHash = HashCombine(ModListHash, GetTypeHash(ModOpIdx));
+						ModListHash = HashCombine(ModListHash, GetTypeHash(Mod.ActiveHandle));
+						ModListHash = HashCombine(ModListHash, GetTypeHash(Mod.EvaluatedMagnitude));
+						ModListHash = HashCombine(ModListHash, GetTypeHash(Mod.Qualifies()));
+					}
+				}
 			}
 
-			DebugLine(Info, AttributeString, 4.f, 0.f);
-
-			DrawAttributes.Add(Attribute);
-
-			for (const auto& CurMapElement : ModMap)
+			FAttributeDebugCache::FEntry& Entry = AttributeDebugCache.ModifiedAttributes.FindOrAdd(Attribute);
+			if (Entry.Update(FinalValue, BaseValue, ModListHash, Now))
 			{
-				const EGameplayModEvaluationChannel Channel = CurMapElement.Key;
-				const TArray<FAggregatorMod>* ModArrays = CurMapElement.Value;
+				Entry.Line = FString::Printf(TEXT("%-30s %.2f "), *Attribute.GetName(), FinalValue);
+				if (FMath::Abs<float>(BaseValue - FinalValue) > SMALL_NUMBER)
+				{
+					Entry.Line += FString::Printf(TEXT(" (Base: %.2f)"), BaseValue);
+				}
 
-				const FString ChannelNameString =
-					UAbilitySystemGlobals::Get().GetGameplayModEvaluationChannelAlias(Channel).ToString();
-				for (int32 ModOpIdx = 0; ModOpIdx < EGameplayModOp::Max; ++ModOpIdx)
+				Entry.ModLines.Reset();
+				for (const auto& CurMapElement : ModMap)
 				{
-					const TArray<FAggregatorMod>& CurModArray = ModArrays[ModOpIdx];
-					for (const FAggregatorMod& Mod : CurModArray)
+					const EGameplayModEvaluationChannel Channel = CurMapElement.Key;
+					const TArray<FAggregatorMod>* ModArrays = CurMapElement.Value;
+
+					const FString ChannelNameString =
+						UAbilitySystemGlobals::Get().GetGameplayModEvaluationChannelAlias(Channel).ToString();
+					for (int32 ModOpIdx = 0; ModOpIdx < EGameplayModOp::Max; ++ModOpIdx)
 					{
-						bool IsActivelyModifyingAttribute = Mod.Qualifies();
-						if (Info.Canvas)
+						const TArray<FAggregatorMod>& CurModArray = ModArrays[ModOpIdx];
+						for (const FAggregatorMod& Mod : CurModArray)
 						{
-							Info.Canvas->SetDrawColor(
-								IsActivelyModifyingAttribute ? FColor::Yellow : FColor(128, 128, 128));
-						}
+							const bool IsActivelyModifyingAttribute = Mod.Qualifies();
 
-						FActiveGameplayEffect* ActiveGE =
-							AbilitySystem->ActiveGameplayEffects.GetActiveGameplayEffect(Mod.ActiveHandle);
-						FString SrcName = ActiveGE ? ActiveGE->Spec.Def->GetName() : FString(TEXT(""));
+							const FActiveGameplayEffect* ActiveGE =
+								AbilitySystem->ActiveGameplayEffects.GetActiveGameplayEffect(Mod.ActiveHandle);
+							FString SrcName = ActiveGE ? ActiveGE->Spec.Def->GetName() : FString(TEXT(""));
 
-						if (IsActivelyModifyingAttribute == false)
-						{
-							if (Mod.SourceTagReqs)
-							{
-								SrcName += FString::Printf(TEXT(" SourceTags: [%s] "), *Mod.SourceTagReqs->ToString());
-							}
-							if (Mod.TargetTagReqs)
+							if (IsActivelyModifyingAttribute == false)
 							{
-								SrcName += FString::Printf(TEXT("TargetTags: [%s]"), *Mod.TargetTagReqs->ToString());
+								if (Mod.SourceTagReqs)
+								{
+									SrcName +=
+										FString::Printf(TEXT(" SourceTags: [%s] "), *Mod.SourceTagReqs->ToString());
+								}
+								if (Mod.TargetTagReqs)
+								{
+									SrcName +=
+										FString::Printf(TEXT("TargetTags: [%s]"), *Mod.TargetTagReqs->ToString());
+								}
 							}
-						}
 
-						DebugLine(
-							Info,
-							FString::Printf(
-								TEXT("   %s %s\t %.2f - %s"),
-								*ChannelNameString,
-								*EGameplayModOpToString(ModOpIdx),
-								Mod.EvaluatedMagnitude,
-								*SrcName),
-							7.f,
-							0.f);
-						Info.NewColumnYPadding = FMath::Max<float>(Info.NewColumnYPadding, Info.YPos + Info.YL);
+							Entry.ModLines.Add(
+								{FString::Printf(
+									 TEXT("   %s %s\t %.2f - %s"),
+									 *ChannelNameString,
+									 *EGameplayModOpToString(ModOpIdx),
+									 Mod.EvaluatedMagnitude,
+									 *SrcName),
+								 IsActivelyModifyingAttribute});
+						}
 					}
 				}
 			}
 
+			DrawAttributeLine(Entry);
+
+			for (const auto& ModLine : Entry.ModLines)
+			{
+				if (Info.Canvas)
+				{
+					Info.Canvas->SetDrawColor(ModLine.bQualifies ? FColor::Yellow : FColor(128, 128, 128));
+				}
+				DebugLine(Info, ModLine.Text, 7.f, 0.f);
+				Info.NewColumnYPadding = FMath::Max<float>(Info.NewColumnYPadding, Info.YPos + Info.YL);
+			}
+
 			AccumulateScreenPos(Info);
 		}
 
-		if (Info.Canvas)
-		{
-			Info.Canvas->SetDrawColor(FColor::White);
-		}
 		for (UAttributeSet* Set : AbilitySystem->GetSpawnedAttributes())
 		{
 			if (!Set)
@@ -241,26 +452,15 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 				continue;
 			}
 
-			for (FProperty* Property : TFieldRange<FProperty>(Set->GetClass()))
+			for (const FGameplayAttribute& Attribute : AttributeDebugCache.GetAttributesOfSetClass(Set->GetClass()))
 			{
-				auto NumericProperty = CastField<FNumericProperty>(Property);
-
-				// to prevent crashes with AttributeSet properties that are not actually attributes
-				if (NumericProperty != nullptr && !NumericProperty->IsFloatingPoint())
+				const float Value = AbilitySystem->GetNumericAttribute(Attribute);
+				FAttributeDebugCache::FEntry& Entry = AttributeDebugCache.AllAttributes.FindOrAdd(Attribute);
+				if (Entry.Update(Value, Value, 0, Now))
 				{
-					continue;
+					Entry.Line = FString::Printf(TEXT("%-30s %.2f"), *Attribute.GetName(), Value);
 				}
-
-				FGameplayAttribute Attribute(Property);
-				if (Attribute.IsValid() == false)
-					continue;
-
-				float Value = AbilitySystem->GetNumericAttribute(Attribute);
-				FString PaddedAttributeName = Attribute.GetName();
-				while (PaddedAttributeName.Len() < 30)
-					PaddedAttributeName += " ";
-
-				DebugLine(Info, FString::Printf(TEXT("%s %.2f"), *PaddedAttributeName, Value), 4.f, 0.f);
+				DrawAttributeLine(Entry);
 			}
 		}
 		AccumulateScreenPos(Info);
@@ -427,21 +627,91 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 	{
 		DrawTitle(Info, "ABILITIES");
 
-		TArray<FGameplayAbilitySpec> ActivatableAbilities = AbilitySystem->GetActivatableAbilities();
+		// Iterate the specs by reference. Copying the whole spec array every frame is way too expensive
+		// for actors with lots of granted abilities.
+		const TArray<FGameplayAbilitySpec>& ActivatableAbilities = AbilitySystem->GetActivatableAbilities();
+		const double Now = AbilitySystem->GetWorld()->GetTimeSeconds();
+		if (AbilitySpecDebugCache.Owner.Get() != AbilitySystem)
+		{
+			AbilitySpecDebugCache.Reset();
+			AbilitySpecDebugCache.Owner = AbilitySystem;
+		}
+		const FString& AbilityFilterString = AbilityFilter.GetValueOnGameThread();
+		const bool bPassAllAbilities = OUU::Runtime::Private::AbilitiesDebugger::IsPassAllFilter(AbilityFilterString);
+		if (AbilitySpecDebugCache.Filter != AbilityFilterString)
+		{
+			AbilitySpecDebugCache.Filter = AbilityFilterString;
+			for (auto& Entry : AbilitySpecDebugCache.Entries)
+			{
+				Entry.Value.bPassesFilter.Reset();
+			}
+		}
+
+		// Add all missing entries before taking pointers to them in the second loop
+		const uint32 Generation = ++AbilitySpecDebugCache.Generation;
+		int32 NumSeenEntries = 0;
+		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities)
+		{
+			if (AbilitySpec.Ability == nullptr)
+				continue;
 
-		// Sort abilities by name
-		ActivatableAbilities.Sort([](const FGameplayAbilitySpec& A, const FGameplayAbilitySpec& B) -> bool {
-			if (!IsValid(A.Ability) || !IsValid(B.Ability))
-				return false;
+			FAbilitySpecDebugCache::FEntry& Entry = AbilitySpecDebugCache.Entries.FindOrAdd(AbilitySpec.Handle);
+			if (Entry.SeenGeneration != Generation)
+			{
+				Entry.SeenGeneration = Generation;
+				NumSeenEntries++;
+			}
+			if (Entry.Ability.Get() != AbilitySpec.Ability.Get())
+			{
+				Entry = FAbilitySpecDebugCache::FEntry();
+				Entry.Ability = AbilitySpec.Ability.Get();
+				Entry.AbilityName =
+					OUU::Runtime::GameplayDebuggerUtils::CleanupName(GetNameSafe(AbilitySpec.Ability));
+			}
+			if (!Entry.bPassesFilter.IsSet())
+			{
+				Entry.bPassesFilter = bPassAllAbilities
+					|| OUU::Runtime::RegexUtils::MatchesRegex(AbilityFilterString, Entry.AbilityName);
+			}
+		}
 
-			return A.Ability->GetName() < B.Ability->GetName();
-		});
+		// Remove cache entries of abilities that were removed from the ASC (incl. handles that were replaced by others)
+		if (AbilitySpecDebugCache.Entries.Num() > NumSeenEntries)
+		{
+			for (auto It = AbilitySpecDebugCache.Entries.CreateIterator(); It; ++It)
+			{
+				if (It->Value.SeenGeneration != Generation)
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
 
+		// Sort abilities by name (names are cached per spec)
+		TArray<TPair<const FGameplayAbilitySpec*, FAbilitySpecDebugCache::FEntry*>, TInlineAllocator<64>> SortedSpecs;
+		SortedSpecs.Reserve(ActivatableAbilities.Num());
 		for (const FGameplayAbilitySpec& AbilitySpec : ActivatableAbilities)
 		{
 			if (AbilitySpec.Ability == nullptr)
 				continue;
 
+			FAbilitySpecDebugCache::FEntry& Entry = AbilitySpecDebugCache.Entries.FindChecked(AbilitySpec.Handle);
+			if (Entry.bPassesFilter.GetValue())
+			{
+				SortedSpecs.Emplace(&AbilitySpec, &Entry);
+			}
+		}
+		SortedSpecs.Sort([](const auto& A, const auto& B) -> bool {
+			return A.Value->AbilityName < B.Value->AbilityName;
+		});
+
+		const TArray<uint8>& LocalBlockedAbilityBindings = AbilitySystem->GetBlockedAbilityBindings();
+
+		for (const auto& SortedSpec : SortedSpecs)
+		{
+			const FGameplayAbilitySpec& AbilitySpec = *SortedSpec.Key;
+			FAbilitySpecDebugCache::FEntry& CacheEntry = *SortedSpec.Value;
+
 			// #TODO-OUU Add debugging for instance-per-execution abilities. Right now only instance-per-actor and
 			// non-instanced abilities are supported.
 			UGameplayAbility* Ability = AbilitySpec.GetPrimaryInstance();
@@ -450,33 +720,33 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 				Ability = AbilitySpec.Ability;
 			}
 
-			const FString AbilityName =
-				OUU::Runtime::GameplayDebuggerUtils::CleanupName(GetNameSafe(AbilitySpec.Ability));
-			if (!OUU::Runtime::RegexUtils::MatchesRegex(AbilityFilter.GetValueOnGameThread(), AbilityName))
-				continue;
-
-			FString StatusText;
-			FColor AbilityTextColor = FColorList::Grey;
+			// Gather the state that determines the status line first and only rebuild the string if it changed.
+			enum class EStatus : uint8
+			{
+				None,
+				Active,
+				InputBlocked,
+				TagBlocked,
+				CantActivate
+			};
+			EStatus Status = EStatus::None;
 			FGameplayTagContainer FailureTags;
-
-			const TArray<uint8>& LocalBlockedAbilityBindings = AbilitySystem->GetBlockedAbilityBindings();
+			bool bHasCooldown = false;
+			int32 CooldownBucket = 0;
 
 			if (AbilitySpec.IsActive())
 			{
-				StatusText = FString::Printf(TEXT(" (Active %d)"), AbilitySpec.ActiveCount);
-				AbilityTextColor = FColor::Yellow;
+				Status = EStatus::Active;
 			}
 			else if (
 				LocalBlockedAbilityBindings.IsValidIndex(AbilitySpec.InputID)
 				&& LocalBlockedAbilityBindings[AbilitySpec.InputID])
 			{
-				StatusText = TEXT(" (InputBlocked)");
-				AbilityTextColor = FColor::Red;
+				Status = EStatus::InputBlocked;
 			}
 			else if (Ability->AbilityTags.HasAny(BlockedAbilityTags))
 			{
-				StatusText = TEXT(" (TagBlocked)");
-				AbilityTextColor = FColor::Red;
+				Status = EStatus::TagBlocked;
 			}
 			else if (
 				Ability->CanActivateAbility(
@@ -487,42 +757,88 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 					&FailureTags)
 				== false)
 			{
-				StatusText = FString::Printf(TEXT(" (CantActivate %s)"), *FailureTags.ToString());
-				AbilityTextColor = FColor::Red;
+				Status = EStatus::CantActivate;
 
-				float Cooldown = Ability->GetCooldownTimeRemaining(AbilitySystem->AbilityActorInfo.Get());
-				if (Cooldown > 0.f)
-				{
-					StatusText += FString::Printf(TEXT("   Cooldown: %.2f\n"), Cooldown);
-				}
+				// Cooldowns are displayed with a precision of 1/100th of a second, so the line only has to be rebuilt
+				// if the displayed value changes
+				const float Cooldown = Ability->GetCooldownTimeRemaining(AbilitySystem->AbilityActorInfo.Get());
+				bHasCooldown = Cooldown > 0.f;
+				CooldownBucket = bHasCooldown ? FMath::RoundToInt32(Cooldown * 100.f) : 0;
 			}
 
-			FString InputPressedStr = AbilitySpec.InputPressed ? TEXT("(InputPressed)") : TEXT("");
-			FString ActivationModeStr = AbilitySpec.IsActive() ? UEnum::GetValueAsString(
-											TEXT("GameplayAbilities.EGameplayAbilityActivationMode"),
-											AbilitySpec.ActivationInfo.ActivationMode)
-															   : TEXT("");
-
-			if (Info.Canvas)
+			uint32 StateHash = GetTypeHash(static_cast<uint8>(Status));
+			StateHash = HashCombine(StateHash, GetTypeHash(AbilitySpec.ActiveCount));
+			StateHash = HashCombine(StateHash, GetTypeHash(AbilitySpec.InputPressed));
+			StateHash = HashCombine(StateHash, GetTypeHash(bHasCooldown));
+			StateHash = HashCombine(StateHash, GetTypeHash(CooldownBucket));
+			StateHash = HashCombine(
+				StateHash,
+				GetTypeHash(static_cast<uint8>(AbilitySpec.ActivationInfo.ActivationMode.GetValue())));
+			StateHash = HashCombine(StateHash, GetTypeHash(AbilitySpec.SourceObject.Get()));
+			for (const FGameplayTag& FailureTag : FailureTags)
 			{
-				Info.Canvas->SetDrawColor(AbilityTextColor);
+				StateHash = HashCombine(StateHash, GetTypeHash(FailureTag));
 			}
 
-			const FString AbilitySourceName =
-				OUU::Runtime::GameplayDebuggerUtils::CleanupName(GetNameSafe(AbilitySpec.SourceObject.Get()));
+			if (!CacheEntry.bHasLine || CacheEntry.StateHash != StateHash)
+			{
+				CacheEntry.bHasLine = true;
+				CacheEntry.StateHash = StateHash;
+
+				FString StatusText;
+				CacheEntry.LineColor = FColorList::Grey;
+				switch (Status)
+				{
+				case EStatus::Active:
+					StatusText = FString::Printf(TEXT(" (Active %d)"), AbilitySpec.ActiveCount);
+					CacheEntry.LineColor = FColor::Yellow;
+					break;
+				case EStatus::InputBlocked:
+					StatusText = TEXT(" (InputBlocked)");
+					CacheEntry.LineColor = FColor::Red;
+					break;
+				case EStatus::TagBlocked:
+					StatusText = TEXT(" (TagBlocked)");
+					CacheEntry.LineColor = FColor::Red;
+					break;
+				case EStatus::CantActivate:
+					StatusText = FString::Printf(TEXT(" (CantActivate %s)"), *FailureTags.ToString());
+					CacheEntry.LineColor = FColor::Red;
+					if (bHasCooldown)
+					{
+						StatusText += FString::Printf(TEXT("   Cooldown: %.2f\n"), CooldownBucket / 100.f);
+					}
+					break;
+				default: break;
+				}
 
-			DebugLine(
-				Info,
-				FString::Printf(
+				const FString InputPressedStr = AbilitySpec.InputPressed ? TEXT("(InputPressed)") : TEXT("");
+				const FString ActivationModeStr = AbilitySpec.IsActive()
+					? UEnum::GetValueAsString(
+						TEXT("GameplayAbilities.EGameplayAbilityActivationMode"),
+						AbilitySpec.ActivationInfo.ActivationMode)
+					: TEXT("");
+
+				const FString AbilitySourceName =
+					OUU::Runtime::GameplayDebuggerUtils::CleanupName(GetNameSafe(AbilitySpec.SourceObject.Get()));
+
+				CacheEntry.Line = FString::Printf(
 					TEXT("%s (%s) %s %s %s"),
-					*AbilityName,
+					*CacheEntry.AbilityName,
 					*AbilitySourceName,
 					*StatusText,
 					*InputPressedStr,
-					*ActivationModeStr),
-				4.f,
-				0.f);
+					*ActivationModeStr);
+			}
+
+			if (Info.Canvas)
+			{
+				Info.Canvas->SetDrawColor(CacheEntry.LineColor);
+			}
+
+			DebugLine(Info, CacheEntry.Line, 4.f, 0.f);
 
+			int32 NumSeenTasks = 0;
 			if (AbilitySpec.IsActive())
 			{
 				TArray<UGameplayAbility*> Instances = AbilitySpec.GetAbilityInstances();
@@ -542,7 +858,21 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 					{
 						if (Task)
 						{
-							DebugLine(Info, FString::Printf(TEXT("%s"), *Task->GetDebugString()), 7.f, 0.f);
+							using OUU::Runtime::Private::AbilitiesDebugger::TaskDebugStringRefreshInterval;
+							FAbilitySpecDebugCache::FTaskDebugString& TaskDebugString =
+								CacheEntry.TaskDebugStrings.FindOrAdd(Task);
+							if (TaskDebugString.SeenGeneration != Generation)
+							{
+								TaskDebugString.SeenGeneration = Generation;
+								NumSeenTasks++;
+							}
+							if (TaskDebugString.UpdateTime < 0.0
+								|| Now - TaskDebugString.UpdateTime >= TaskDebugStringRefreshInterval)
+							{
+								TaskDebugString.Text = Task->GetDebugString();
+								TaskDebugString.UpdateTime = Now;
+							}
+							DebugLine(Info, TaskDebugString.Text, 7.f, 0.f);
 
 							for (FAbilityTaskDebugMessage& Msg : Instance->TaskDebugMessages)
 							{
@@ -593,6 +923,18 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 					}
 				}
 			}
+
+			// Remove the debug strings of tasks that ended
+			if (CacheEntry.TaskDebugStrings.Num() > NumSeenTasks)
+			{
+				for (auto It = CacheEntry.TaskDebugStrings.CreateIterator(); It; ++It)
+				{
+					if (It->Value.SeenGeneration != Generation)
+					{
+						It.RemoveCurrent();
+					}
+				}
+			}
 		}
 		AccumulateScreenPos(Info);
 		NewColumnForCategory_Optional(Info);
@@ -605,90 +947,61 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 
 		// ReSharper disable once CppTooWideScope
 		constexpr bool bPrintNotLoadedCues = false;
-		// ReSharper disable once CppTooWideScope
-		constexpr bool bPrintUnmappedCues = false;
-
-		UGameplayCueManager* CueManager = UAbilitySystemGlobals::Get().GetGameplayCueManager();
-		auto BaseCueTag = UGameplayCueSet::BaseGameplayCueTag();
-		FString BaseCueTagString = BaseCueTag.ToString();
-		FGameplayTagContainer AllGameplayCueTags = UGameplayTagsManager::Get().RequestGameplayTagChildren(BaseCueTag);
-		auto CueSet = CueManager->GetRuntimeCueSet();
-		for (FGameplayTag ThisGameplayCueTag : AllGameplayCueTags)
+
+		CueDebugIndex.Update(UAbilitySystemGlobals::Get().GetGameplayCueManager(), CueFilter.GetValueOnGameThread());
+		for (const int32 EntryIdx : CueDebugIndex.FilteredEntries)
 		{
-			FString CueTagString = ThisGameplayCueTag.ToString();
-			CueTagString.RemoveFromStart(BaseCueTagString);
-			int32 idx = CueSet->GameplayCueDataMap.FindChecked(ThisGameplayCueTag);
-			if (idx != INDEX_NONE)
+			auto& Entry = CueDebugIndex.Entries[EntryIdx];
+			switch (Entry.Type)
 			{
-				auto CueData = CueSet->GameplayCueData[idx];
-
-				if (CueData.LoadedGameplayCueClass == nullptr)
-				{
-					if (bPrintNotLoadedCues)
-					// ReSharper disable once CppUnreachableCode
-					{
-						if (Info.Canvas)
-						{
-							Info.Canvas->SetDrawColor(FColorList::Grey);
-						}
-						DebugLine(Info, FString::Printf(TEXT("%s -> not loaded"), *CueTagString), 0.f, 0.f);
-					}
-					continue;
-				}
-
-				auto CueClass = CueData.LoadedGameplayCueClass;
-
-				if (Cast<UGameplayCueNotify_Static>(CueClass->ClassDefaultObject) != nullptr)
+			case FGameplayCueDebugIndex::ECueType::NotLoaded:
+			{
+				if (bPrintNotLoadedCues)
+				// ReSharper disable once CppUnreachableCode
 				{
 					if (Info.Canvas)
 					{
 						Info.Canvas->SetDrawColor(FColorList::Grey);
 					}
-					DebugLine(Info, FString::Printf(TEXT("%s -> non-instanced"), *CueTagString), 0.f, 0.f);
+					DebugLine(Info, FString::Printf(TEXT("%s -> not loaded"), *Entry.TagDisplayString), 0.f, 0.f);
 				}
-				else if (Cast<AGameplayCueNotify_Actor>(CueClass->ClassDefaultObject) != nullptr)
+				break;
+			}
+			case FGameplayCueDebugIndex::ECueType::Static:
+			{
+				if (Entry.CachedLine.IsEmpty())
 				{
-					if (Info.Canvas)
-					{
-						Info.Canvas->SetDrawColor(FColorList::White);
-					}
-					DebugLine(Info, FString::Printf(TEXT("%s -> actor"), *CueTagString), 0.f, 0.f);
-	#if UE_VERSION_OLDER_THAN(5, 3, 0)
-					AActor* LocalAvatarActor = AbilitySystem->GetAvatarActor_Direct();
-					AActor* LocalOwnerActor = AbilitySystem->GetOwnerActor();
-					for (auto CueEntry : CueManager->NotifyMapActor)
-					{
-						FGCNotifyActorKey Key = CueEntry.Key;
-						if (Key.CueClass != CueClass)
-							continue;
-
-						AGameplayCueNotify_Actor* CueActor = CueEntry.Value.Get();
-						bool bIsValidForThisACS =
-							(Key.TargetActor == LocalAvatarActor || Key.TargetActor == LocalOwnerActor)
-							&& IsValid(CueActor);
-						if (Info.Canvas)
-						{
-							Info.Canvas->SetDrawColor(bIsValidForThisACS ? FColorList::Green : FColorList::Grey);
-						}
-						DebugLine(
-							Info,
-							OUU::Runtime::GameplayDebuggerUtils::CleanupName(CueClass->GetName()),
-							7.f,
-							0.f);
-					}
-	#else
-					DebugLine(Info, TEXT("no NotifyMapActor since UE 5.3.0"), 7.f, 0.f);
-	#endif
+					Entry.CachedLine = FString::Printf(TEXT("%s -> non-instanced"), *Entry.TagDisplayString);
+				}
+				if (Info.Canvas)
+				{
+					Info.Canvas->SetDrawColor(FColorList::Grey);
 				}
+				DebugLine(Info, Entry.CachedLine, 0.f, 0.f);
+				break;
 			}
-			else if (bPrintUnmappedCues)
-			// ReSharper disable once CppUnreachableCode
+			case FGameplayCueDebugIndex::ECueType::Actor:
 			{
+				// Active (non-burst) cues are tracked in the tag map of the ability system component,
+				// so the tag count is the number of active cue instances on this ASC.
+				const int32 ActiveCount = AbilitySystem->GetTagCount(Entry.Tag);
+				if (Entry.CachedLineActiveCount != ActiveCount)
+				{
+					Entry.CachedLineActiveCount = ActiveCount;
+					Entry.CachedLine = FString::Printf(
+						TEXT("%s -> actor %s (%i active)"),
+						*Entry.TagDisplayString,
+						*Entry.CueClassDisplayString,
+						ActiveCount);
+				}
 				if (Info.Canvas)
 				{
-					Info.Canvas->SetDrawColor(FColorList::Grey);
+					Info.Canvas->SetDrawColor(ActiveCount > 0 ? FColorList::Green : FColorList::White);
 				}
-				DebugLine(Info, FString::Printf(TEXT("%s -> unmapped"), *CueTagString), 0.f, 0.f);
+				DebugLine(Info, Entry.CachedLine, 0.f, 0.f);
+				break;
+			}
+			default: break;
 			}
 		}
 
@@ -701,9 +1014,13 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 	{
 		DrawTitle(Info, "GAMEPLAY EVENTS");
 
+		FOUUGameplayEventHistoryQuery Query;
+		Query.EventTag = FGameplayTag::RequestGameplayTag(*EventFilter.GetValueOnGameThread(), false);
+
 		auto Now = FDateTime::Now();
-		for (auto Entry : ReverseRange(AbilitySystem->CircularGameplayEventHistory))
+		for (const FOUUGameplayEventData* EntryPtr : ReverseRange(AbilitySystem->QueryGameplayEventHistory(Query)))
 		{
+			const FOUUGameplayEventData& Entry = *EntryPtr;
 			float SecondsSinceEvent = (Now - Entry.Timestamp).GetTotalSeconds();
 			FNumberFormattingOptions NumberFormattingOptions;
 			NumberFormattingOptions.MinimumIntegralDigits = 3;
@@ -734,10 +1051,68 @@ void FGameplayDebuggerCategory_OUUAbilities::Debug_Custom(
 	Info.YL = MaxCharHeight;
 }
 
+bool FGameplayDebuggerCategory_OUUAbilities::FAttributeDebugCache::FEntry::Update(
+	float NewValue,
+	float NewBaseValue,
+	uint32 NewModListHash,
+	double Now)
+{
+	if (!bInitialized)
+	{
+		bInitialized = true;
+		Value = NewValue;
+		BaseValue = NewBaseValue;
+		ModListHash = NewModListHash;
+		return true;
+	}
+
+	const bool bValueChanged = Value != NewValue;
+	if (bValueChanged)
+	{
+		LastChangeTime = Now;
+		LastChangeDelta = NewValue - Value;
+	}
+
+	if (bValueChanged || BaseValue != NewBaseValue || ModListHash != NewModListHash)
+	{
+		Value = NewValue;
+		BaseValue = NewBaseValue;
+		ModListHash = NewModListHash;
+		return true;
+	}
+	return false;
+}
+
+const TArray<FGameplayAttribute>& FGameplayDebuggerCategory_OUUAbilities::FAttributeDebugCache::
+	GetAttributesOfSetClass(const UClass* SetClass)
+{
+	if (const TArray<FGameplayAttribute>* ExistingAttributes = SetClassAttributes.Find(SetClass))
+		return *ExistingAttributes;
+
+	TArray<FGameplayAttribute>& Attributes = SetClassAttributes.Add(SetClass);
+	for (FProperty* Property : TFieldRange<FProperty>(SetClass))
+	{
+		auto NumericProperty = CastField<FNumericProperty>(Property);
+
+		// to prevent crashes with AttributeSet properties that are not actually attributes
+		if (NumericProperty != nullptr && !NumericProperty->IsFloatingPoint())
+		{
+			continue;
+		}
+
+		FGameplayAttribute Attribute(Property);
+		if (Attribute.IsValid() == false)
+			continue;
+
+		Attributes.Add(Attribute);
+	}
+	return Attributes;
+}
+
 void FGameplayDebuggerCategory_OUUAbilities::GetAttributeAggregatorSnapshot(
 	UOUUAbilitySystemComponent* AbilitySystem,
 	const FGameplayAttribute& Attribute,
-	FAggregator SnapshotAggregator)
+	FAggregator& OutSnapshotAggregator)
 {
 	// NOTE: As of writing this code, this is how I understand the usage of CaptureSource and bSnapshot.
 	//       There might be some misunderstandings, so feel free to make corrections and add an appropriate explanation,
@@ -753,7 +1128,7 @@ void FGameplayDebuggerCategory_OUUAbilities::GetAttributeAggregatorSnapshot(
 	FGameplayEffectAttributeCaptureSpec CaptureSpec{CaptureDefinition};
 	AbilitySystem->CaptureAttributeForGameplayEffect(IN OUT CaptureSpec);
 
-	const bool bGotSnapshot = CaptureSpec.AttemptGetAttributeAggregatorSnapshot(OUT SnapshotAggregator);
+	const bool bGotSnapshot = CaptureSpec.AttemptGetAttributeAggregatorSnapshot(OUT OutSnapshotAggregator);
 	ensureAlwaysMsgf(
 		bGotSnapshot,
 		TEXT("Snapshots should always be successful! "
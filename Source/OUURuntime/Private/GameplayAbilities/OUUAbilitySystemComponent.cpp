@@ -2,12 +2,294 @@
 
 #include "GameplayAbilities/OUUAbilitySystemComponent.h"
 
+#include "Dom/JsonObject.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "LogOpenUnrealUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectIterator.h"
+
+namespace OUU::Runtime::Private::GameplayEventHistory
+{
+	void RemoveEventNumber(TArray<int32>& EventNumbers, int32 EventNumber)
+	{
+		// Evicted events are always the oldest ones, so they are at the front of the index arrays
+		if (EventNumbers.Num() > 0 && EventNumbers[0] == EventNumber)
+		{
+			EventNumbers.RemoveAt(0, 1, false);
+		}
+		else
+		{
+			EventNumbers.Remove(EventNumber);
+		}
+	}
+
+	template <typename KeyType>
+	void RemoveFromIndex(TMap<KeyType, TArray<int32>>& Index, const KeyType& Key, int32 EventNumber)
+	{
+		if (TArray<int32>* EventNumbers = Index.Find(Key))
+		{
+			RemoveEventNumber(*EventNumbers, EventNumber);
+			if (EventNumbers->Num() == 0)
+			{
+				Index.Remove(Key);
+			}
+		}
+	}
+
+	FString ToCsvField(FString Value)
+	{
+		if (Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")))
+		{
+			Value.ReplaceInline(TEXT("\""), TEXT("\"\""));
+			return FString::Printf(TEXT("\"%s\""), *Value);
+		}
+		return Value;
+	}
+} // namespace OUU::Runtime::Private::GameplayEventHistory
+
+bool FOUUGameplayEventHistoryQuery::Matches(const FOUUGameplayEventData& Event) const
+{
+	if (EventTag.IsValid() && !(bExactTagMatch ? Event.EventTag == EventTag : Event.EventTag.MatchesTag(EventTag)))
+		return false;
+
+	if (Instigator.IsSet() && Event.Instigator != Instigator.GetValue())
+		return false;
+
+	return true;
+}
+
 int32 UOUUAbilitySystemComponent::HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload)
 {
 	if (Payload != nullptr)
 	{
 		EventCounter++;
-		CircularGameplayEventHistory.Add(FOUUGameplayEventData(EventCounter, *Payload));
+		AddToGameplayEventHistory(FOUUGameplayEventData(EventCounter, *Payload));
 	}
 	return Super::HandleGameplayEvent(EventTag, Payload);
 }
+
+TArray<const FOUUGameplayEventData*> UOUUAbilitySystemComponent::QueryGameplayEventHistory(
+	const FOUUGameplayEventHistoryQuery& Query) const
+{
+	TArray<const FOUUGameplayEventData*> Result;
+
+	// Pick the most selective index to gather the candidates
+	TArray<int32, TInlineAllocator<GameplayEventHistorySize>> CandidateEventNumbers;
+	if (Query.Instigator.IsSet())
+	{
+		if (const TArray<int32>* EventNumbers =
+				GameplayEventHistoryByInstigator.Find(FObjectKey(Query.Instigator.GetValue())))
+		{
+			CandidateEventNumbers.Append(*EventNumbers);
+		}
+	}
+	else if (Query.EventTag.IsValid())
+	{
+		if (Query.bExactTagMatch)
+		{
+			if (const TArray<int32>* EventNumbers = GameplayEventHistoryByTag.Find(Query.EventTag))
+			{
+				CandidateEventNumbers.Append(*EventNumbers);
+			}
+		}
+		else
+		{
+			for (const auto& Entry : GameplayEventHistoryByTag)
+			{
+				if (Entry.Key.MatchesTag(Query.EventTag))
+				{
+					CandidateEventNumbers.Append(Entry.Value);
+				}
+			}
+			// Restore chronological order after merging the lists of multiple tags
+			CandidateEventNumbers.Sort();
+		}
+	}
+	else
+	{
+		Result.Reserve(CircularGameplayEventHistory.Num());
+		for (const FOUUGameplayEventData& Event : CircularGameplayEventHistory)
+		{
+			Result.Add(&Event);
+		}
+		return Result;
+	}
+
+	Result.Reserve(CandidateEventNumbers.Num());
+	for (const int32 EventNumber : CandidateEventNumbers)
+	{
+		const FOUUGameplayEventData* Event = FindGameplayEventInHistory(EventNumber);
+		if (Event && Query.Matches(*Event))
+		{
+			Result.Add(Event);
+		}
+	}
+	return Result;
+}
+
+bool UOUUAbilitySystemComponent::DumpGameplayEventHistoryToFile(
+	const FOUUGameplayEventHistoryQuery& Query,
+	const FString& FilePath,
+	bool bJson) const
+{
+	using namespace OUU::Runtime::Private::GameplayEventHistory;
+	const TArray<const FOUUGameplayEventData*> Events = QueryGameplayEventHistory(Query);
+
+	FString FileContents;
+	if (bJson)
+	{
+		TArray<TSharedPtr<FJsonValue>> JsonEvents;
+		JsonEvents.Reserve(Events.Num());
+		for (const FOUUGameplayEventData* Event : Events)
+		{
+			const TSharedRef<FJsonObject> JsonEvent = MakeShared<FJsonObject>();
+			JsonEvent->SetNumberField(TEXT("EventNumber"), Event->EventNumber);
+			JsonEvent->SetStringField(TEXT("Timestamp"), Event->Timestamp.ToIso8601());
+			JsonEvent->SetStringField(TEXT("EventTag"), Event->EventTag.ToString());
+			JsonEvent->SetStringField(TEXT("Instigator"), GetNameSafe(Event->Instigator));
+			JsonEvent->SetStringField(TEXT("Target"), GetNameSafe(Event->Target));
+			JsonEvent->SetNumberField(TEXT("EventMagnitude"), Event->EventMagnitude);
+			JsonEvents.Add(MakeShared<FJsonValueObject>(JsonEvent));
+		}
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&FileContents);
+		FJsonSerializer::Serialize(JsonEvents, Writer);
+	}
+	else
+	{
+		FileContents = TEXT("EventNumber,Timestamp,EventTag,Instigator,Target,EventMagnitude\n");
+		for (const FOUUGameplayEventData* Event : Events)
+		{
+			FileContents += FString::Printf(
+				TEXT("%i,%s,%s,%s,%s,%f\n"),
+				Event->EventNumber,
+				*Event->Timestamp.ToIso8601(),
+				*ToCsvField(Event->EventTag.ToString()),
+				*ToCsvField(GetNameSafe(Event->Instigator)),
+				*ToCsvField(GetNameSafe(Event->Target)),
+				Event->EventMagnitude);
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(FileContents, *FilePath);
+}
+
+const FOUUGameplayEventData* UOUUAbilitySystemComponent::FindGameplayEventInHistory(int32 EventNumber) const
+{
+	if (!CircularGameplayEventHistory.HasData())
+		return nullptr;
+
+	// Event numbers are consecutive, so the position in the history can be computed from the oldest event number
+	const int32 Index = EventNumber - CircularGameplayEventHistory.Oldest().EventNumber;
+	if (Index < 0 || Index >= CircularGameplayEventHistory.Num())
+		return nullptr;
+
+	const FOUUGameplayEventData& Event = CircularGameplayEventHistory[Index];
+	return Event.EventNumber == EventNumber ? &Event : nullptr;
+}
+
+void UOUUAbilitySystemComponent::AddToGameplayEventHistory(const FOUUGameplayEventData& Event)
+{
+	using namespace OUU::Runtime::Private::GameplayEventHistory;
+
+	if (CircularGameplayEventHistory.Num() >= GameplayEventHistorySize)
+	{
+		// The oldest event is about to be overwritten
+		const FOUUGameplayEventData& EvictedEvent = CircularGameplayEventHistory[0];
+		RemoveFromIndex(GameplayEventHistoryByTag, EvictedEvent.EventTag, EvictedEvent.EventNumber);
+		RemoveFromIndex(
+			GameplayEventHistoryByInstigator,
+			FObjectKey(EvictedEvent.Instigator),
+			EvictedEvent.EventNumber);
+	}
+
+	CircularGameplayEventHistory.Add(Event);
+	GameplayEventHistoryByTag.FindOrAdd(Event.EventTag).Add(Event.EventNumber);
+	GameplayEventHistoryByInstigator.FindOrAdd(FObjectKey(Event.Instigator)).Add(Event.EventNumber);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+
+static FAutoConsoleCommandWithWorldAndArgs DumpGameplayEventHistoryCommand(
+	TEXT("ouu.Debug.Ability.DumpEventHistory"),
+	TEXT("Write the gameplay event history of all OUU ability system components in the world to files in "
+		 "Saved/GameplayEventHistory. Optional args: Tag=<EventTag> ExactTag=<bool> Instigator=<ActorName> "
+		 "Format=<csv|json>"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+		if (!IsValid(World))
+			return;
+
+		FOUUGameplayEventHistoryQuery Query;
+		FString InstigatorName;
+		bool bJson = false;
+		for (const FString& Arg : Args)
+		{
+			FString Key, Value;
+			if (!Arg.Split(TEXT("="), &Key, &Value))
+				continue;
+
+			if (Key == TEXT("Tag"))
+			{
+				Query.EventTag = FGameplayTag::RequestGameplayTag(*Value, false);
+			}
+			else if (Key == TEXT("ExactTag"))
+			{
+				Query.bExactTagMatch = Value.ToBool();
+			}
+			else if (Key == TEXT("Instigator"))
+			{
+				InstigatorName = Value;
+			}
+			else if (Key == TEXT("Format"))
+			{
+				bJson = Value.Equals(TEXT("json"), ESearchCase::IgnoreCase);
+			}
+		}
+
+		if (!InstigatorName.IsEmpty())
+		{
+			for (const AActor* Actor : TActorRange<AActor>(World))
+			{
+				if (Actor->GetName() == InstigatorName || Actor->GetActorNameOrLabel() == InstigatorName)
+				{
+					Query.Instigator = Actor;
+					break;
+				}
+			}
+			if (!Query.Instigator.IsSet())
+			{
+				UE_LOG(LogOpenUnrealUtilities, Warning, TEXT("Could not find instigator actor %s"), *InstigatorName);
+				return;
+			}
+		}
+
+		const FString Directory = FPaths::ProjectSavedDir() / TEXT("GameplayEventHistory");
+		const FString Timestamp = FDateTime::Now().ToString();
+		for (TObjectIterator<UOUUAbilitySystemComponent> It; It; ++It)
+		{
+			if (It->GetWorld() != World)
+				continue;
+
+			const FString FileName = FString::Printf(
+				TEXT("%s_%s.%s"),
+				*GetNameSafe(It->GetOwner()),
+				*Timestamp,
+				bJson ? TEXT("json") : TEXT("csv"));
+			const FString FilePath = Directory / FileName;
+			if (It->DumpGameplayEventHistoryToFile(Query, FilePath, bJson))
+			{
+				UE_LOG(LogOpenUnrealUtilities, Log, TEXT("Dumped gameplay event history to %s"), *FilePath);
+			}
+			else
+			{
+				UE_LOG(
+					LogOpenUnrealUtilities,
+					Warning,
+					TEXT("Failed to write gameplay event history to %s"),
+					*FilePath);
+			}
+		}
+	}));
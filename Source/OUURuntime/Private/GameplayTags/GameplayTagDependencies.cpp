@@ -15,9 +15,31 @@ void IGameplayTagDependencyInterface::AppendTags(FGameplayTagContainer& OutTags)
 void IGameplayTagDependencyInterface::BroadcastTagsChanged()
 {
 	const FGameplayTagContainer AllTagsBefore = CachedTags_All;
+	const FGameplayTagContainer OwnTagsBefore = CachedTags_Own;
 	UpdateCachedTags(EGameplayTagDependencyGetMode::OwnTags);
 	UpdateCachedTags(EGameplayTagDependencyGetMode::AllTags);
 
+	FTagSourceIndex OwnTagsDelta;
+	const TWeakObjectPtr<const UObject> ThisObject = GetInterfaceObject(this);
+	for (const FGameplayTag& Tag : CachedTags_Own)
+	{
+		if (OwnTagsBefore.HasTagExact(Tag) == false)
+		{
+			OwnTagsDelta.FindOrAdd(Tag).Add(ThisObject, 1);
+		}
+	}
+	for (const FGameplayTag& Tag : OwnTagsBefore)
+	{
+		if (CachedTags_Own.HasTagExact(Tag) == false)
+		{
+			OwnTagsDelta.FindOrAdd(Tag).Add(ThisObject, -1);
+		}
+	}
+	if (OwnTagsDelta.Num() > 0)
+	{
+		ApplyTagSourceDelta_Recursive(OwnTagsDelta, 1);
+	}
+
 	BroadcastTagsChanged_Recursive(AllTagsBefore);
 }
 
@@ -35,8 +57,23 @@ void IGameplayTagDependencyInterface::AddDependency(TScriptInterface<IGameplayTa
 {
 	if (IsValidInterface<IGameplayTagDependencyInterface>(Dependency))
 	{
+		// Cycles would make propagation of tags and tag sources recurse endlessly
+		TSet<const IGameplayTagDependencyInterface*> Visited;
+		if (!ensureAlwaysMsgf(
+				Dependency.GetInterface() != this && !Dependency->DependsOn_Recursive(this, Visited),
+				TEXT("Rejected cyclic gameplay tag dependency of %s on %s"),
+				*GetNameSafe(GetInterfaceObject(this)),
+				*GetNameSafe(Dependency.GetObject())))
+			return;
+
 		Dependencies.Add(TWeakInterfacePtr<IGameplayTagDependencyInterface>(Dependency.GetObject()));
 		Dependency->ImmediateDependants.Add(GetInterfaceObject(this));
+		if (Dependency->OriginalTagSources.Num() > 0)
+		{
+			// Propagate a copy, so the delta is not modified while it's applied
+			const FTagSourceIndex Delta = Dependency->OriginalTagSources;
+			ApplyTagSourceDelta_Recursive(Delta, 1);
+		}
 	}
 }
 
@@ -44,8 +81,15 @@ void IGameplayTagDependencyInterface::RemoveDependency(TScriptInterface<IGamepla
 {
 	if (IsValidInterface<IGameplayTagDependencyInterface>(Dependency))
 	{
-		Dependencies.Remove(TWeakInterfacePtr<IGameplayTagDependencyInterface>(Dependency.GetObject()));
+		const int32 NumRemoved =
+			Dependencies.Remove(TWeakInterfacePtr<IGameplayTagDependencyInterface>(Dependency.GetObject()));
 		Dependency->ImmediateDependants.Remove(GetInterfaceObject(this));
+		if (NumRemoved > 0 && Dependency->OriginalTagSources.Num() > 0)
+		{
+			// Propagate a copy, so the delta is not modified while it's applied
+			const FTagSourceIndex Delta = Dependency->OriginalTagSources;
+			ApplyTagSourceDelta_Recursive(Delta, -NumRemoved);
+		}
 	}
 }
 
@@ -88,6 +132,43 @@ TMap<FGameplayTag, const UObject*> IGameplayTagDependencyInterface::GetImmediate
 }
 
 void IGameplayTagDependencyInterface::GetOriginalTagSources(TMap<FGameplayTag, TSet<const UObject*>>& InOutResult) const
+{
+	for (auto& Entry : OriginalTagSources)
+	{
+		TSet<const UObject*>* ResultSources = nullptr;
+		for (auto& Source : Entry.Value)
+		{
+			if (const UObject* SourceObject = Source.Key.Get())
+			{
+				if (ResultSources == nullptr)
+				{
+					ResultSources = &InOutResult.FindOrAdd(Entry.Key);
+				}
+				ResultSources->Add(SourceObject);
+			}
+		}
+	}
+}
+
+TArray<const UObject*> IGameplayTagDependencyInterface::GetOriginalTagSources(const FGameplayTag& Tag) const
+{
+	TArray<const UObject*> Result;
+	if (const FTagSourceCounts* Sources = OriginalTagSources.Find(Tag))
+	{
+		Result.Reserve(Sources->Num());
+		for (auto& Source : *Sources)
+		{
+			if (const UObject* SourceObject = Source.Key.Get())
+			{
+				Result.Add(SourceObject);
+			}
+		}
+	}
+	return Result;
+}
+
+void IGameplayTagDependencyInterface::RecomputeOriginalTagSources(
+	TMap<FGameplayTag, TSet<const UObject*>>& InOutResult) const
 {
 	for (auto Tag : CachedTags_Own)
 	{
@@ -98,7 +179,7 @@ void IGameplayTagDependencyInterface::GetOriginalTagSources(TMap<FGameplayTag, T
 	{
 		if (Dependency.IsValid() == false)
 			continue;
-		Dependency->GetOriginalTagSources(IN OUT InOutResult);
+		Dependency->RecomputeOriginalTagSources(IN OUT InOutResult);
 	}
 }
 
@@ -196,3 +277,51 @@ void IGameplayTagDependencyInterface::BroadcastTagsChanged_Recursive(const FGame
 		}
 	}
 }
+
+bool IGameplayTagDependencyInterface::DependsOn_Recursive(
+	const IGameplayTagDependencyInterface* Other,
+	TSet<const IGameplayTagDependencyInterface*>& Visited) const
+{
+	bool bAlreadyVisited = false;
+	Visited.Add(this, &bAlreadyVisited);
+	if (bAlreadyVisited)
+		return false;
+
+	for (auto Dependency : Dependencies)
+	{
+		if (Dependency.IsValid() && (Dependency.Get() == Other || Dependency->DependsOn_Recursive(Other, Visited)))
+			return true;
+	}
+	return false;
+}
+
+void IGameplayTagDependencyInterface::ApplyTagSourceDelta_Recursive(const FTagSourceIndex& Delta, int32 Factor)
+{
+	for (auto& DeltaEntry : Delta)
+	{
+		FTagSourceCounts& Sources = OriginalTagSources.FindOrAdd(DeltaEntry.Key);
+		for (auto& SourceDelta : DeltaEntry.Value)
+		{
+			int32& Count = Sources.FindOrAdd(SourceDelta.Key, 0);
+			Count += SourceDelta.Value * Factor;
+			ensureMsgf(Count >= 0, TEXT("Negative tag source count for tag %s"), *DeltaEntry.Key.ToString());
+			if (Count <= 0)
+			{
+				Sources.Remove(SourceDelta.Key);
+			}
+		}
+		if (Sources.Num() == 0)
+		{
+			OriginalTagSources.Remove(DeltaEntry.Key);
+		}
+	}
+
+	// Every dependant contains this index once per dependency entry, so duplicate dependant entries are intended
+	for (auto Dependant : ImmediateDependants)
+	{
+		if (Dependant.IsValid())
+		{
+			Dependant->ApplyTagSourceDelta_Recursive(Delta, Factor);
+		}
+	}
+}
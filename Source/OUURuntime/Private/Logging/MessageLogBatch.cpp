@@ -0,0 +1,285 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "Logging/MessageLogBatch.h"
+
+#include "Logging/MessageLog.h"
+#include "Misc/UObjectToken.h"
+
+namespace OUU::Runtime::Private::MessageLogBatch
+{
+	FORCEINLINE bool IsMoreSevere(EMessageLogSeverity A, EMessageLogSeverity B)
+	{
+		// Lower enum values are more severe
+		return static_cast<uint8>(A) < static_cast<uint8>(B);
+	}
+
+	/** Append a key that identifies the token contents to a message identity key. */
+	void AppendTokenKey(FString& InOutKey, const FMessageLogToken& Token)
+	{
+		InOutKey.AppendChar(static_cast<TCHAR>(TEXT('A') + static_cast<uint8>(Token.Type)));
+		switch (Token.Type)
+		{
+		case EMessageLogTokenType::Object: InOutKey += FString::Printf(TEXT("%p"), Token.Object); break;
+		case EMessageLogTokenType::AssetName: InOutKey += Token.AssetName; break;
+		case EMessageLogTokenType::URL: InOutKey += Token.URL; break;
+		default: break;
+		}
+		InOutKey.AppendChar(TEXT('|'));
+		InOutKey += Token.Text.ToString();
+		InOutKey.AppendChar(TEXT('\n'));
+	}
+} // namespace OUU::Runtime::Private::MessageLogBatch
+
+FMessageLogBatch::FMessageLogBatch(FName InMessageLogName, const FText& InPageLabel) :
+	MessageLogName(InMessageLogName), PageLabel(InPageLabel)
+{
+	Reset();
+}
+
+FMessageLogBatch::~FMessageLogBatch()
+{
+	Commit();
+}
+
+void FMessageLogBatch::AddMessage(EMessageLogSeverity Severity, const TArray<FMessageLogToken>& Tokens)
+{
+	AddMessageToGroup(0, Severity, Tokens);
+}
+
+void FMessageLogBatch::AddObjectMessage(
+	const UObject* ContextObject,
+	EMessageLogSeverity Severity,
+	const TArray<FMessageLogToken>& Tokens)
+{
+	if (!ContextObject)
+	{
+		AddMessage(Severity, Tokens);
+		return;
+	}
+
+	int32& GroupIdx = ObjectGroupIndices.FindOrAdd(FObjectKey(ContextObject), INDEX_NONE);
+	if (GroupIdx == INDEX_NONE)
+	{
+		GroupIdx = Groups.AddDefaulted();
+		Groups[GroupIdx].ContextToken = GetObjectToken(ContextObject);
+	}
+	AddMessageToGroup(GroupIdx, Severity, Tokens);
+}
+
+void FMessageLogBatch::AddAssetMessage(
+	const FString& ContextAssetName,
+	EMessageLogSeverity Severity,
+	const TArray<FMessageLogToken>& Tokens)
+{
+	if (ContextAssetName.IsEmpty())
+	{
+		AddMessage(Severity, Tokens);
+		return;
+	}
+
+	int32& GroupIdx = AssetGroupIndices.FindOrAdd(ContextAssetName, INDEX_NONE);
+	if (GroupIdx == INDEX_NONE)
+	{
+		GroupIdx = Groups.AddDefaulted();
+		Groups[GroupIdx].ContextToken = GetAssetToken(ContextAssetName);
+	}
+	AddMessageToGroup(GroupIdx, Severity, Tokens);
+}
+
+int32 FMessageLogBatch::NumWithSeverity(EMessageLogSeverity Severity) const
+{
+	const uint8 SeverityIdx = static_cast<uint8>(Severity);
+	return SeverityIdx < UE_ARRAY_COUNT(NumMessagesPerSeverity) ? NumMessagesPerSeverity[SeverityIdx] : 0;
+}
+
+int32 FMessageLogBatch::NumUniqueMessages() const
+{
+	int32 Result = 0;
+	for (const FGroup& Group : Groups)
+	{
+		Result += Group.Messages.Num();
+	}
+	return Result;
+}
+
+TArray<TSharedRef<FTokenizedMessage>> FMessageLogBatch::BuildMessages() const
+{
+	using namespace OUU::Runtime::Private::MessageLogBatch;
+
+	TArray<TSharedRef<FTokenizedMessage>> Result;
+	Result.Reserve(NumUniqueMessages() + Groups.Num() * 2);
+
+	auto AddGroupMessages = [&](const FGroup& Group) {
+		if (Group.ContextToken.IsValid())
+		{
+			EMessageLogSeverity MostSevere = EMessageLogSeverity::Info;
+			for (const FMessage& Message : Group.Messages)
+			{
+				if (IsMoreSevere(Message.Severity, MostSevere))
+				{
+					MostSevere = Message.Severity;
+				}
+			}
+
+			const TSharedRef<FTokenizedMessage> Header =
+				FTokenizedMessage::Create(static_cast<EMessageSeverity::Type>(MostSevere));
+			Header->AddToken(Group.ContextToken.ToSharedRef());
+			Header->AddToken(FTextToken::Create(FText::Format(
+				INVTEXT("{0} messages ({1} errors, {2} warnings)"),
+				Group.NumMessages,
+				Group.NumErrors,
+				Group.NumWarnings)));
+			Result.Add(Header);
+		}
+
+		const int32 NumShown = FMath::Min(Group.Messages.Num(), FMath::Max(MaxMessagesPerGroup, 0));
+		for (int32 MessageIdx = 0; MessageIdx < NumShown; MessageIdx++)
+		{
+			const FMessage& Message = Group.Messages[MessageIdx];
+			const TSharedRef<FTokenizedMessage> NativeMessage =
+				FTokenizedMessage::Create(static_cast<EMessageSeverity::Type>(Message.Severity));
+			// Repeating the shared context token keeps every line clickable without allocating new tokens
+			if (Group.ContextToken.IsValid())
+			{
+				NativeMessage->AddToken(Group.ContextToken.ToSharedRef());
+			}
+			for (const TSharedRef<IMessageToken>& Token : Message.Tokens)
+			{
+				NativeMessage->AddToken(Token);
+			}
+			if (Message.Count > 1)
+			{
+				NativeMessage->AddToken(FTextToken::Create(FText::Format(INVTEXT("(x{0})"), Message.Count)));
+			}
+			Result.Add(NativeMessage);
+		}
+
+		const int32 NumHidden = Group.Messages.Num() - NumShown;
+		if (NumHidden > 0)
+		{
+			int32 NumHiddenTotal = 0;
+			for (int32 MessageIdx = NumShown; MessageIdx < Group.Messages.Num(); MessageIdx++)
+			{
+				NumHiddenTotal += Group.Messages[MessageIdx].Count;
+			}
+			const TSharedRef<FTokenizedMessage> Summary = FTokenizedMessage::Create(EMessageSeverity::Info);
+			if (Group.ContextToken.IsValid())
+			{
+				Summary->AddToken(Group.ContextToken.ToSharedRef());
+			}
+			Summary->AddToken(FTextToken::Create(FText::Format(
+				INVTEXT("... and {0} more unique messages ({1} in total)"),
+				NumHidden,
+				NumHiddenTotal)));
+			Result.Add(Summary);
+		}
+	};
+
+	for (int32 GroupIdx = 1; GroupIdx < Groups.Num(); GroupIdx++)
+	{
+		AddGroupMessages(Groups[GroupIdx]);
+	}
+	AddGroupMessages(Groups[0]);
+
+	return Result;
+}
+
+int32 FMessageLogBatch::Commit()
+{
+	if (IsEmpty())
+		return 0;
+
+	const TArray<TSharedRef<FTokenizedMessage>> Messages = BuildMessages();
+	Reset();
+
+	// A single message log instance that only flushes once when it goes out of scope
+	FMessageLog MessageLog(MessageLogName);
+	MessageLog.NewPage(PageLabel);
+	MessageLog.AddMessages(Messages);
+	return Messages.Num();
+}
+
+void FMessageLogBatch::Reset()
+{
+	Groups.Reset();
+	// Messages without context always live in the first group
+	Groups.AddDefaulted();
+	ObjectGroupIndices.Reset();
+	AssetGroupIndices.Reset();
+	InternedObjectTokens.Reset();
+	InternedAssetTokens.Reset();
+	NumMessages = 0;
+	FMemory::Memzero(NumMessagesPerSeverity);
+}
+
+TSharedRef<IMessageToken> FMessageLogBatch::GetObjectToken(const UObject* Object)
+{
+	if (const TSharedRef<IMessageToken>* ExistingToken = InternedObjectTokens.Find(FObjectKey(Object)))
+		return *ExistingToken;
+
+	return InternedObjectTokens.Add(FObjectKey(Object), FUObjectToken::Create(Object));
+}
+
+TSharedRef<IMessageToken> FMessageLogBatch::GetAssetToken(const FString& AssetName)
+{
+	if (const TSharedRef<IMessageToken>* ExistingToken = InternedAssetTokens.Find(AssetName))
+		return *ExistingToken;
+
+	return InternedAssetTokens.Add(AssetName, FAssetNameToken::Create(AssetName));
+}
+
+TSharedRef<IMessageToken> FMessageLogBatch::ToNativeToken(const FMessageLogToken& Token)
+{
+	if (Token.Text.IsEmpty())
+	{
+		if (Token.Type == EMessageLogTokenType::Object && Token.Object)
+			return GetObjectToken(Token.Object);
+		if (Token.Type == EMessageLogTokenType::AssetName && !Token.AssetName.IsEmpty())
+			return GetAssetToken(Token.AssetName);
+	}
+	return Token.CreateNativeMessageToken();
+}
+
+void FMessageLogBatch::AddMessageToGroup(
+	int32 GroupIdx,
+	EMessageLogSeverity Severity,
+	const TArray<FMessageLogToken>& Tokens)
+{
+	FString MessageKey;
+	MessageKey.AppendChar(static_cast<TCHAR>(TEXT('0') + static_cast<uint8>(Severity)));
+	for (const FMessageLogToken& Token : Tokens)
+	{
+		OUU::Runtime::Private::MessageLogBatch::AppendTokenKey(MessageKey, Token);
+	}
+
+	FGroup& Group = Groups[GroupIdx];
+	int32& MessageIdx = Group.MessageIndices.FindOrAdd(MoveTemp(MessageKey), INDEX_NONE);
+	if (MessageIdx == INDEX_NONE)
+	{
+		MessageIdx = Group.Messages.AddDefaulted();
+		FMessage& NewMessage = Group.Messages[MessageIdx];
+		NewMessage.Severity = Severity;
+		NewMessage.Tokens.Reserve(Tokens.Num());
+		for (const FMessageLogToken& Token : Tokens)
+		{
+			NewMessage.Tokens.Add(ToNativeToken(Token));
+		}
+	}
+	else
+	{
+		Group.Messages[MessageIdx].Count++;
+	}
+
+	Group.NumMessages++;
+	Group.NumErrors += Severity == EMessageLogSeverity::Error ? 1 : 0;
+	const bool bIsWarning =
+		Severity == EMessageLogSeverity::Warning || Severity == EMessageLogSeverity::PerformanceWarning;
+	Group.NumWarnings += bIsWarning ? 1 : 0;
+
+	NumMessages++;
+	const uint8 SeverityIdx = static_cast<uint8>(Severity);
+	if (SeverityIdx < UE_ARRAY_COUNT(NumMessagesPerSeverity))
+	{
+		NumMessagesPerSeverity[SeverityIdx]++;
+	}
+}
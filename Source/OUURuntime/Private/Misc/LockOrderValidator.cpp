@@ -0,0 +1,203 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "Misc/LockOrderValidator.h"
+
+#if OUU_WITH_LOCK_ORDER_VALIDATION
+
+	#include "Algo/Reverse.h"
+	#include "HAL/PlatformStackWalk.h"
+	#include "LogOpenUnrealUtilities.h"
+
+namespace OUU::Runtime::Private::LockOrderValidator
+{
+	constexpr uint32 MaxCallStackDepth = 32;
+
+	/** Locks held by the current thread in acquisition order */
+	TArray<const void*>& GetHeldLocks()
+	{
+		thread_local TArray<const void*> HeldLocks;
+		return HeldLocks;
+	}
+} // namespace OUU::Runtime::Private::LockOrderValidator
+
+namespace OUU::Runtime
+{
+	FLockOrderValidator& FLockOrderValidator::Get()
+	{
+		// Intentionally leaked: Locked variables with static storage duration may be destroyed after any
+		// function-local static and still report their destruction.
+		static FLockOrderValidator* Instance = new FLockOrderValidator();
+		return *Instance;
+	}
+
+	void FLockOrderValidator::OnLockAcquired(const void* Lock)
+	{
+		using namespace OUU::Runtime::Private::LockOrderValidator;
+
+		TArray<const void*>& HeldLocks = GetHeldLocks();
+		TArray<FLockOrderViolation> Violations;
+		FViolationHandler Handler;
+		if (HeldLocks.Num() > 0)
+		{
+			FScopeLock ScopeLock(&CriticalSection);
+			for (const void* HeldLock : HeldLocks)
+			{
+				if (HeldLock == Lock || FindEdge(HeldLock, Lock))
+					continue;
+
+				// A path back to the held lock means the new order closes a cycle
+				TArray<const void*> Cycle = FindPath(Lock, HeldLock);
+
+				FOrderEdge& Edge = OrderEdges.FindOrAdd(HeldLock).AddDefaulted_GetRef();
+				Edge.SecondLock = Lock;
+				Edge.ThreadId = FPlatformTLS::GetCurrentThreadId();
+				uint64 BackTrace[MaxCallStackDepth];
+				const uint32 CallStackDepth = FPlatformStackWalk::CaptureStackBackTrace(BackTrace, MaxCallStackDepth);
+				Edge.CallStack.Append(BackTrace, CallStackDepth);
+				OrderedLocks.Add(HeldLock);
+				OrderedLocks.Add(Lock);
+
+				if (Cycle.Num() > 0)
+				{
+					FLockOrderViolation& Violation = Violations.AddDefaulted_GetRef();
+					Violation.Report = CreateReport(Cycle);
+					Violation.Cycle = MoveTemp(Cycle);
+				}
+			}
+			Handler = ViolationHandler;
+		}
+		HeldLocks.Add(Lock);
+
+		// Report outside of the critical section, so handlers may lock other (validated) locks
+		for (const FLockOrderViolation& Violation : Violations)
+		{
+			if (Handler)
+			{
+				Handler(Violation);
+			}
+			else
+			{
+				UE_LOG(LogOpenUnrealUtilities, Error, TEXT("%s"), *Violation.Report);
+			}
+		}
+	}
+
+	void FLockOrderValidator::OnLockReleased(const void* Lock)
+	{
+		TArray<const void*>& HeldLocks = OUU::Runtime::Private::LockOrderValidator::GetHeldLocks();
+		const int32 HeldIndex = HeldLocks.FindLast(Lock);
+		if (HeldIndex != INDEX_NONE)
+		{
+			HeldLocks.RemoveAt(HeldIndex);
+		}
+	}
+
+	void FLockOrderValidator::OnLockDestroyed(const void* Lock)
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (OrderedLocks.Remove(Lock) == 0)
+			return;
+
+		OrderEdges.Remove(Lock);
+		for (auto& Entry : OrderEdges)
+		{
+			Entry.Value.RemoveAll([Lock](const FOrderEdge& Edge) { return Edge.SecondLock == Lock; });
+		}
+	}
+
+	bool FLockOrderValidator::HasRecordedOrder(const void* First, const void* Second) const
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		return FindEdge(First, Second) != nullptr;
+	}
+
+	void FLockOrderValidator::Reset()
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		OrderEdges.Reset();
+		OrderedLocks.Reset();
+	}
+
+	FLockOrderValidator::FViolationHandler FLockOrderValidator::SetViolationHandler(FViolationHandler InHandler)
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		Swap(ViolationHandler, InHandler);
+		return InHandler;
+	}
+
+	const FLockOrderValidator::FOrderEdge* FLockOrderValidator::FindEdge(const void* First, const void* Second) const
+	{
+		const TArray<FOrderEdge>* Edges = OrderEdges.Find(First);
+		if (!Edges)
+			return nullptr;
+		return Edges->FindByPredicate([Second](const FOrderEdge& Edge) { return Edge.SecondLock == Second; });
+	}
+
+	TArray<const void*> FLockOrderValidator::FindPath(const void* Start, const void* Target) const
+	{
+		// Breadth first search, so the reported cycle is as short as possible
+		TMap<const void*, const void*> Predecessors;
+		Predecessors.Add(Start, nullptr);
+		TArray<const void*> Queue = {Start};
+		for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); QueueIndex++)
+		{
+			const void* Current = Queue[QueueIndex];
+			if (Current == Target)
+			{
+				TArray<const void*> Path;
+				for (const void* PathLock = Target; PathLock; PathLock = Predecessors.FindChecked(PathLock))
+				{
+					Path.Add(PathLock);
+				}
+				Algo::Reverse(Path);
+				return Path;
+			}
+
+			if (const TArray<FOrderEdge>* Edges = OrderEdges.Find(Current))
+			{
+				for (const FOrderEdge& Edge : *Edges)
+				{
+					if (!Predecessors.Contains(Edge.SecondLock))
+					{
+						Predecessors.Add(Edge.SecondLock, Current);
+						Queue.Add(Edge.SecondLock);
+					}
+				}
+			}
+		}
+		return {};
+	}
+
+	FString FLockOrderValidator::CreateReport(const TArray<const void*>& Cycle) const
+	{
+		FString Report = FString::Printf(TEXT("Potential deadlock: inconsistent lock order of %i locks."), Cycle.Num());
+		for (int32 CycleIndex = 0; CycleIndex < Cycle.Num(); CycleIndex++)
+		{
+			const void* FirstLock = Cycle[CycleIndex];
+			const void* SecondLock = Cycle[(CycleIndex + 1) % Cycle.Num()];
+			const FOrderEdge* Edge = FindEdge(FirstLock, SecondLock);
+			if (!ensure(Edge))
+				continue;
+
+			Report += FString::Printf(
+				TEXT("\n  Lock %p acquired while holding lock %p on thread %u:"),
+				SecondLock,
+				FirstLock,
+				Edge->ThreadId);
+			for (int32 FrameIndex = 0; FrameIndex < Edge->CallStack.Num(); FrameIndex++)
+			{
+				ANSICHAR FrameString[1024];
+				FrameString[0] = '\0';
+				FPlatformStackWalk::ProgramCounterToHumanReadableString(
+					FrameIndex,
+					Edge->CallStack[FrameIndex],
+					FrameString,
+					UE_ARRAY_COUNT(FrameString));
+				Report += FString::Printf(TEXT("\n    %s"), ANSI_TO_TCHAR(FrameString));
+			}
+		}
+		return Report;
+	}
+} // namespace OUU::Runtime
+
+#endif
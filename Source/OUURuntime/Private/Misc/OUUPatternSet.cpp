@@ -0,0 +1,276 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "Misc/OUUPatternSet.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+
+namespace OUU::Runtime::Private::PatternSet
+{
+	enum class ETokenType : uint8
+	{
+		Literal,
+		AnyChar,
+		AnyString
+	};
+
+	struct FToken
+	{
+		ETokenType Type;
+		TCHAR Char;
+	};
+
+	// Active states are usually few, because all patterns share the same trie. Inline storage avoids allocations
+	// for the typical case.
+	using FStateSet = TArray<int32, TInlineAllocator<32>>;
+} // namespace OUU::Runtime::Private::PatternSet
+
+int32 FOUUPatternSet::FNode::FindLiteralEdge(TCHAR Char) const
+{
+	const int32 EdgeIdx = Algo::BinarySearchBy(LiteralEdges, Char, &FEdge::Char);
+	return EdgeIdx != INDEX_NONE ? LiteralEdges[EdgeIdx].Node : INDEX_NONE;
+}
+
+FOUUPatternSet::FOUUPatternSet(ESearchCase::Type InSearchCase) : SearchCase(InSearchCase)
+{
+	Nodes.AddDefaulted();
+}
+
+int32 FOUUPatternSet::AddPattern(EPatternType Type, const FString& Pattern)
+{
+	const int32 PatternIndex = Patterns.Add(FPatternInfo{Pattern, Type});
+	if (Type == EPatternType::Regex)
+	{
+		const auto Flags =
+			SearchCase == ESearchCase::IgnoreCase ? ERegexPatternFlags::CaseInsensitive : ERegexPatternFlags::None;
+		RegexPatterns.Emplace(PatternIndex, FRegexPattern(Pattern, Flags));
+	}
+	else
+	{
+		AddAutomatonPattern(Type, Pattern, PatternIndex);
+	}
+	return PatternIndex;
+}
+
+bool FOUUPatternSet::MatchesAny(FStringView String) const
+{
+	return ForEachMatch(String, [](int32) { return true; });
+}
+
+void FOUUPatternSet::MatchAll(FStringView String, TArray<int32>& OutPatternIndices) const
+{
+	OutPatternIndices.Reset();
+	ForEachMatch(String, [&](int32 PatternIndex) {
+		OutPatternIndices.Add(PatternIndex);
+		return false;
+	});
+
+	// Prefix states behind * wildcards may be reached multiple times
+	Algo::Sort(OutPatternIndices);
+	OutPatternIndices.SetNum(Algo::Unique(OutPatternIndices), false);
+}
+
+TArray<int32> FOUUPatternSet::MatchAll(FStringView String) const
+{
+	TArray<int32> Result;
+	MatchAll(String, Result);
+	return Result;
+}
+
+void FOUUPatternSet::Reset()
+{
+	Patterns.Reset();
+	RegexPatterns.Reset();
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+}
+
+void FOUUPatternSet::AddAutomatonPattern(EPatternType Type, const FString& Pattern, int32 PatternIndex)
+{
+	using namespace OUU::Runtime::Private::PatternSet;
+
+	TArray<FToken, TInlineAllocator<128>> Tokens;
+	Tokens.Reserve(Pattern.Len() + 1);
+	if (Type == EPatternType::Substring)
+	{
+		Tokens.Add({ETokenType::AnyString, 0});
+	}
+	for (const TCHAR Char : Pattern)
+	{
+		if (Type != EPatternType::Glob)
+		{
+			Tokens.Add({ETokenType::Literal, FoldCase(Char)});
+		}
+		else if (Char == TEXT('*'))
+		{
+			// Consecutive * are equivalent to a single one
+			if (Tokens.Num() == 0 || Tokens.Last().Type != ETokenType::AnyString)
+			{
+				Tokens.Add({ETokenType::AnyString, 0});
+			}
+		}
+		else if (Char == TEXT('?'))
+		{
+			Tokens.Add({ETokenType::AnyChar, 0});
+		}
+		else
+		{
+			Tokens.Add({ETokenType::Literal, FoldCase(Char)});
+		}
+	}
+
+	// A trailing * matches any remainder, so such patterns match as soon as the state before the * is reached.
+	// This turns globs like "/Game/Maps/*" into plain prefix matches that don't keep a state alive until the end.
+	bool bPrefixMatch = (Type == EPatternType::Prefix || Type == EPatternType::Substring);
+	if (Tokens.Num() > 0 && Tokens.Last().Type == ETokenType::AnyString)
+	{
+		Tokens.Pop(false);
+		bPrefixMatch = true;
+	}
+
+	// Nodes may be reallocated while adding new ones, so only indices are kept across iterations.
+	int32 NodeIdx = 0;
+	for (const FToken& Token : Tokens)
+	{
+		switch (Token.Type)
+		{
+		case ETokenType::Literal:
+		{
+			TArray<FEdge>& Edges = Nodes[NodeIdx].LiteralEdges;
+			const int32 EdgeIdx = Algo::LowerBoundBy(Edges, Token.Char, &FEdge::Char);
+			if (Edges.IsValidIndex(EdgeIdx) && Edges[EdgeIdx].Char == Token.Char)
+			{
+				NodeIdx = Edges[EdgeIdx].Node;
+			}
+			else
+			{
+				const int32 NewNodeIdx = Nodes.AddDefaulted();
+				Nodes[NodeIdx].LiteralEdges.Insert(FEdge{Token.Char, NewNodeIdx}, EdgeIdx);
+				NodeIdx = NewNodeIdx;
+			}
+			break;
+		}
+		case ETokenType::AnyChar:
+		{
+			if (Nodes[NodeIdx].AnyCharEdge == INDEX_NONE)
+			{
+				const int32 NewNodeIdx = Nodes.AddDefaulted();
+				Nodes[NodeIdx].AnyCharEdge = NewNodeIdx;
+			}
+			NodeIdx = Nodes[NodeIdx].AnyCharEdge;
+			break;
+		}
+		case ETokenType::AnyString:
+		{
+			if (Nodes[NodeIdx].AnyStringEdge == INDEX_NONE)
+			{
+				const int32 NewNodeIdx = Nodes.AddDefaulted();
+				Nodes[NewNodeIdx].bSelfLoop = true;
+				Nodes[NodeIdx].AnyStringEdge = NewNodeIdx;
+			}
+			NodeIdx = Nodes[NodeIdx].AnyStringEdge;
+			break;
+		}
+		}
+	}
+
+	if (bPrefixMatch)
+	{
+		Nodes[NodeIdx].PrefixMatchPatterns.Add(PatternIndex);
+	}
+	else
+	{
+		Nodes[NodeIdx].FullMatchPatterns.Add(PatternIndex);
+	}
+}
+
+template <typename CallbackType>
+bool FOUUPatternSet::ForEachMatch(FStringView String, CallbackType&& Callback) const
+{
+	using namespace OUU::Runtime::Private::PatternSet;
+
+	FStateSet StatesA, StatesB;
+	FStateSet* CurrentStates = &StatesA;
+	FStateSet* NextStates = &StatesB;
+
+	// Enter a state and all states reachable via * wildcards without consuming a character.
+	auto EnterState = [&](FStateSet& States, int32 NodeIdx) -> bool {
+		for (; NodeIdx != INDEX_NONE; NodeIdx = Nodes[NodeIdx].AnyStringEdge)
+		{
+			if (States.Contains(NodeIdx))
+				return false;
+
+			const FNode& Node = Nodes[NodeIdx];
+			for (const int32 PatternIndex : Node.PrefixMatchPatterns)
+			{
+				if (Callback(PatternIndex))
+					return true;
+			}
+
+			// States without transitions or full matches can't contribute anything after being reported
+			if (Node.HasTransitions() || Node.FullMatchPatterns.Num() > 0)
+			{
+				States.Add(NodeIdx);
+			}
+		}
+		return false;
+	};
+
+	if (EnterState(*CurrentStates, 0))
+		return true;
+
+	for (const TCHAR RawChar : String)
+	{
+		if (CurrentStates->Num() == 0)
+			break;
+
+		const TCHAR Char = FoldCase(RawChar);
+		NextStates->Reset();
+		for (const int32 NodeIdx : *CurrentStates)
+		{
+			const FNode& Node = Nodes[NodeIdx];
+			if (Node.bSelfLoop && EnterState(*NextStates, NodeIdx))
+				return true;
+
+			const int32 LiteralTarget = Node.FindLiteralEdge(Char);
+			if (LiteralTarget != INDEX_NONE && EnterState(*NextStates, LiteralTarget))
+				return true;
+
+			if (Node.AnyCharEdge != INDEX_NONE && EnterState(*NextStates, Node.AnyCharEdge))
+				return true;
+		}
+		Swap(CurrentStates, NextStates);
+	}
+
+	for (const int32 NodeIdx : *CurrentStates)
+	{
+		for (const int32 PatternIndex : Nodes[NodeIdx].FullMatchPatterns)
+		{
+			if (Callback(PatternIndex))
+				return true;
+		}
+	}
+
+	if (RegexPatterns.Num() > 0)
+	{
+		// The regex matcher requires an FString, so the view is copied once for all regex patterns.
+		const FString StringCopy(String);
+		for (const auto& Entry : RegexPatterns)
+		{
+			// Empty matches are ignored like in RegexUtils, otherwise patterns like "x*" would match any string.
+			FRegexMatcher Matcher(Entry.Value, StringCopy);
+			while (Matcher.FindNext())
+			{
+				if (Matcher.GetMatchBeginning() == Matcher.GetMatchEnding())
+					continue;
+
+				if (Callback(Entry.Key))
+					return true;
+				break;
+			}
+		}
+	}
+
+	return false;
+}
@@ -3,6 +3,7 @@
 #include "Misc/RegexUtils.h"
 
 #include "Internationalization/Regex.h"
+#include "LogOpenUnrealUtilities.h"
 
 namespace OUU::Runtime::Private::Regex
 {
@@ -25,124 +26,108 @@ namespace OUU::Runtime::Private::Regex
 		return (StringLength > 0) && (MatchBeginning == 0) && (MatchEnding == StringLength);
 	}
 
-	bool IsValidMatchRange(const FString& TestString, int32 MatchBeginning, int32 MatchEnding)
+	/** @returns the capture group indices of all named groups (?<name>...) in the pattern */
+	TMap<FString, int32> ParseNamedCaptureGroups(const FString& Pattern)
 	{
-		const int32 StringLength = TestString.Len();
-		return (MatchEnding > MatchBeginning) && StringLength > 0
-			&& (MatchBeginning >= 0 && MatchBeginning <= StringLength)
-			&& (MatchEnding >= 0 && MatchEnding <= StringLength);
-	}
-
-	template <typename ResultType, typename TruePredicateType, typename FalsePredicateType>
-	ResultType MatchRegex(
-		const FString& PatternString,
-		const FString& TestString,
-		int32 BeginIndex,
-		TruePredicateType TruePredicate,
-		FalsePredicateType FalsePredicate)
-	{
-		FScopedRegex Regex{PatternString, TestString};
-		const int32 StringLength = TestString.Len();
-		for (int32 i = BeginIndex; i < StringLength; i++)
+		TMap<FString, int32> Result;
+		int32 GroupIndex = 0;
+		bool bInCharacterClass = false;
+		const int32 Len = Pattern.Len();
+		for (int32 i = 0; i < Len; i++)
 		{
-			Regex->SetLimits(i, StringLength);
-			if (!Regex->FindNext())
+			const TCHAR Char = Pattern[i];
+			if (Char == TEXT('\\'))
+			{
+				// Skip escaped character
+				i++;
+				continue;
+			}
+			if (bInCharacterClass)
+			{
+				bInCharacterClass = Char != TEXT(']');
+				continue;
+			}
+			if (Char == TEXT('['))
+			{
+				bInCharacterClass = true;
+				continue;
+			}
+			if (Char != TEXT('('))
 				continue;
 
-			int32 MatchBeginning = Regex->GetMatchBeginning();
-			int32 MatchEnding = Regex->GetMatchEnding();
-			if (IsValidMatchRange(TestString, MatchBeginning, MatchEnding))
+			if (i + 1 >= Len || Pattern[i + 1] != TEXT('?'))
 			{
-				return TruePredicate(Regex, MatchBeginning, MatchEnding, MatchEnding);
+				GroupIndex++;
+				continue;
 			}
-		}
-		return FalsePredicate();
-	}
-
-	bool MatchesRegex_Recursive(const FString& RegexPattern, const FString& TestString, int32 BeginIndex)
-	{
-		return MatchRegex<bool>(
-			RegexPattern,
-			TestString,
-			BeginIndex,
-			[&](FScopedRegex& Regex, int32 MatchBeginning, int32, int32) { return true; },
-			[]() { return false; });
-	}
-
-	int32 CountRegexMatches_Recursive(const FString& RegexPattern, const FString& TestString, int32 BeginIndex)
-	{
-		return MatchRegex<int32>(
-			RegexPattern,
-			TestString,
-			BeginIndex,
-			[&RegexPattern,
-			 &TestString](FScopedRegex& Regex, int32 MatchBeginning, int32 MatchEnding, int32 BeginIndex) {
-				return CountRegexMatches_Recursive(RegexPattern, TestString, BeginIndex) + 1;
-			},
-			[]() { return 0; });
-	}
-
-	TArray<FRegexMatch> GetRegexMatches_Recursive(
-		const FString& RegexPattern,
-		const FString& TestString,
-		int32 BeginIndex)
-	{
-		return MatchRegex<TArray<FRegexMatch>>(
-			RegexPattern,
-			TestString,
-			BeginIndex,
-			[&RegexPattern,
-			 &TestString](FScopedRegex& Regex, int32 MatchBeginning, int32 MatchEnding, int32 BeginIndex) {
-				TArray<FRegexMatch> ResultList;
-				ResultList.Add(FRegexMatch{
-					MatchBeginning,
-					MatchEnding,
-					TestString.Mid(MatchBeginning, MatchEnding - MatchBeginning)});
-				ResultList.Append(GetRegexMatches_Recursive(RegexPattern, TestString, BeginIndex));
-				return ResultList;
-			},
-			[]() { return TArray<FRegexMatch>{}; });
-	}
-
-	TArray<FRegexGroups> GetRegexMatchesAndGroups_Recursive(
-		const FString& RegexPattern,
-		int32 GroupCount,
-		const FString& TestString,
-		int32 BeginIndex)
-	{
-		return MatchRegex<TArray<FRegexGroups>>(
-			RegexPattern,
-			TestString,
-			BeginIndex,
-			[&RegexPattern,
-			 &TestString,
-			 &GroupCount](FScopedRegex& Regex, int32 MatchBeginning, int32 MatchEnding, int32 BeginIndex) {
-				TArray<FRegexGroups> ResultList;
-				FRegexGroups Result;
-				for (int32 i = 0; i < GroupCount; i++)
+
+			// (?<name>...) but not lookbehind (?<=...) / (?<!...)
+			const bool bIsNamedGroup = i + 3 < Len && Pattern[i + 2] == TEXT('<') && Pattern[i + 3] != TEXT('=')
+				&& Pattern[i + 3] != TEXT('!');
+			if (bIsNamedGroup)
+			{
+				GroupIndex++;
+				const int32 NameBeginning = i + 3;
+				const int32 NameEnding = Pattern.Find(TEXT(">"), ESearchCase::CaseSensitive, ESearchDir::FromStart, i);
+				if (NameEnding != INDEX_NONE)
 				{
-					Result.CaptureGroups.Add(FRegexMatch{
-						Regex->GetCaptureGroupBeginning(i),
-						Regex->GetCaptureGroupEnding(i),
-						Regex->GetCaptureGroup(i)});
+					Result.Add(Pattern.Mid(NameBeginning, NameEnding - NameBeginning), GroupIndex);
+					i = NameEnding;
 				}
-				ResultList.Add(Result);
-				ResultList.Append(GetRegexMatchesAndGroups_Recursive(RegexPattern, GroupCount, TestString, BeginIndex));
-				return ResultList;
-			},
-			[]() { return TArray<FRegexGroups>{}; });
+			}
+		}
+		return Result;
 	}
 
+	template <typename AppendReplacementType>
+	FString ReplaceMatches(
+		const FString& Pattern,
+		const FString& Input,
+		int32 MaxReplacements,
+		AppendReplacementType&& AppendReplacement)
+	{
+		FString Result;
+		if (MaxReplacements == 0)
+		{
+			Result = Input;
+			return Result;
+		}
+
+		Result.Reserve(Input.Len());
+		int32 LastMatchEnding = 0;
+		int32 NumReplacements = 0;
+		for (const auto& Match : OUU::Runtime::RegexMatches(Pattern, Input))
+		{
+			// All the chars from input string between last match end and new match
+			Result.AppendChars(*Input + LastMatchEnding, Match.GetBeginning() - LastMatchEnding);
+			AppendReplacement(Match, Result);
+			LastMatchEnding = Match.GetEnding();
+
+			// Break before searching for the next match
+			if (++NumReplacements == MaxReplacements)
+				break;
+		}
+		// Rest of the string until end
+		Result.AppendChars(*Input + LastMatchEnding, Input.Len() - LastMatchEnding);
+		return Result;
+	}
 } // namespace OUU::Runtime::Private::Regex
 
 bool URegexFunctionLibrary::MatchesRegex(const FString& RegexPattern, const FString& TestString)
 {
-	return OUU::Runtime::Private::Regex::MatchesRegex_Recursive(RegexPattern, TestString, 0);
+	auto Matches = OUU::Runtime::RegexMatches(RegexPattern, TestString);
+	return Matches.begin() != Matches.end();
 }
 
 int32 URegexFunctionLibrary::CountRegexMatches(const FString& RegexPattern, const FString& TestString)
 {
-	return OUU::Runtime::Private::Regex::CountRegexMatches_Recursive(RegexPattern, TestString, 0);
+	auto Matches = OUU::Runtime::RegexMatches(RegexPattern, TestString);
+	int32 Count = 0;
+	for (auto It = Matches.begin(); It != Matches.end(); ++It)
+	{
+		Count++;
+	}
+	return Count;
 }
 
 bool URegexFunctionLibrary::MatchesRegexExact(const FString& RegexPattern, const FString& TestString)
@@ -159,7 +144,12 @@ bool URegexFunctionLibrary::MatchesRegexExact(const FString& RegexPattern, const
 
 TArray<FRegexMatch> URegexFunctionLibrary::GetRegexMatches(const FString& RegexPattern, const FString& TestString)
 {
-	return OUU::Runtime::Private::Regex::GetRegexMatches_Recursive(RegexPattern, TestString, 0);
+	TArray<FRegexMatch> Result;
+	for (const auto& Match : OUU::Runtime::RegexMatches(RegexPattern, TestString))
+	{
+		Result.Add(Match.ToRegexMatch());
+	}
+	return Result;
 }
 
 FRegexGroups URegexFunctionLibrary::GetRegexMatchAndGroupsExact(
@@ -195,11 +185,12 @@ TArray<FRegexGroups> URegexFunctionLibrary::GetRegexMatchesAndGroups(
 	int32 GroupCount,
 	const FString& TestString)
 {
-	return OUU::Runtime::Private::Regex::GetRegexMatchesAndGroups_Recursive(
-		RegexPattern,
-		GroupCount + 1,
-		TestString,
-		0);
+	TArray<FRegexGroups> Result;
+	for (const auto& Match : OUU::Runtime::RegexMatches(RegexPattern, TestString))
+	{
+		Result.Add(Match.ToRegexGroups(GroupCount + 1));
+	}
+	return Result;
 }
 
 FRegexGroups URegexFunctionLibrary::GetFirstRegexMatchAndGroups(
@@ -207,8 +198,9 @@ FRegexGroups URegexFunctionLibrary::GetFirstRegexMatchAndGroups(
 	int32 GroupCount,
 	const FString& TestString)
 {
-	auto Result = GetRegexMatchesAndGroups(RegexPattern, GroupCount, TestString);
-	return Result.Num() > 0 ? Result[0] : FRegexGroups::Invalid();
+	auto Matches = OUU::Runtime::RegexMatches(RegexPattern, TestString);
+	const auto It = Matches.begin();
+	return It != Matches.end() ? It->ToRegexGroups(GroupCount + 1) : FRegexGroups::Invalid();
 }
 
 FString URegexFunctionLibrary::ReplaceFirstRegexMatch(
@@ -216,11 +208,11 @@ FString URegexFunctionLibrary::ReplaceFirstRegexMatch(
 	const FString& InputString,
 	const FString& ReplaceString)
 {
-	auto Matches = GetRegexMatches(RegexPattern, InputString);
-	if (Matches.Num() < 1)
-		return InputString;
-	const auto& FirstMatch = Matches[0];
-	return InputString.Mid(0, FirstMatch.MatchBeginning) + ReplaceString + InputString.Mid(FirstMatch.MatchEnding);
+	return OUU::Runtime::RegexReplace(
+		RegexPattern,
+		InputString,
+		OUU::Runtime::FRegexReplaceTemplate::Literal(ReplaceString),
+		1);
 }
 
 FString URegexFunctionLibrary::ReplaceAllRegexMatches(
@@ -228,18 +220,263 @@ FString URegexFunctionLibrary::ReplaceAllRegexMatches(
 	const FString& InputString,
 	const FString& ReplaceString)
 {
-	auto Matches = GetRegexMatches(RegexPattern, InputString);
-	int32 LastMatchEnding = 0;
-	FString Result = "";
-	for (const auto& Match : Matches)
+	return OUU::Runtime::RegexReplace(
+		RegexPattern,
+		InputString,
+		OUU::Runtime::FRegexReplaceTemplate::Literal(ReplaceString));
+}
+
+FString URegexFunctionLibrary::ReplaceAllRegexMatchesWithTemplate(
+	const FString& RegexPattern,
+	const FString& InputString,
+	const FString& ReplaceTemplate)
+{
+	return OUU::Runtime::RegexReplace(
+		RegexPattern,
+		InputString,
+		OUU::Runtime::FRegexReplaceTemplate(ReplaceTemplate, RegexPattern));
+}
+
+namespace OUU::Runtime
+{
+	int32 FRegexMatchRange::FMatch::GetCaptureGroupBeginning(int32 GroupIndex) const
 	{
-		// All the chars from input string between last match end and new match
-		const FString CarryOver = InputString.Mid(LastMatchEnding, Match.MatchBeginning - LastMatchEnding);
+		return Range->Matcher.GetCaptureGroupBeginning(GroupIndex);
+	}
 
-		Result += CarryOver + ReplaceString;
-		LastMatchEnding = Match.MatchEnding;
+	int32 FRegexMatchRange::FMatch::GetCaptureGroupEnding(int32 GroupIndex) const
+	{
+		return Range->Matcher.GetCaptureGroupEnding(GroupIndex);
 	}
-	// Rest of the string until end
-	Result += InputString.Mid(LastMatchEnding);
-	return Result;
-}
+
+	FStringView FRegexMatchRange::FMatch::GetCaptureGroup(int32 GroupIndex) const
+	{
+		const int32 GroupBeginning = GetCaptureGroupBeginning(GroupIndex);
+		const int32 GroupEnding = GetCaptureGroupEnding(GroupIndex);
+		if (GroupBeginning == INDEX_NONE || GroupEnding < GroupBeginning)
+			return {};
+
+		return FStringView(*Range->Input + GroupBeginning, GroupEnding - GroupBeginning);
+	}
+
+	FRegexMatch FRegexMatchRange::FMatch::ToRegexMatch() const
+	{
+		return FRegexMatch{Beginning, Ending, FString(GetView())};
+	}
+
+	FRegexGroups FRegexMatchRange::FMatch::ToRegexGroups(int32 NumGroups) const
+	{
+		FRegexGroups Result;
+		Result.CaptureGroups.Reserve(NumGroups);
+		for (int32 i = 0; i < NumGroups; i++)
+		{
+			Result.CaptureGroups.Add(FRegexMatch{
+				GetCaptureGroupBeginning(i),
+				GetCaptureGroupEnding(i),
+				FString(GetCaptureGroup(i))});
+		}
+		return Result;
+	}
+
+	FRegexMatchRange::FIterator& FRegexMatchRange::FIterator::operator++()
+	{
+		if (Range && !Range->FindNext())
+		{
+			Range = nullptr;
+		}
+		return *this;
+	}
+
+	FRegexMatchRange::FRegexMatchRange(const FRegexPattern& Pattern, const FString& InInput) :
+		Input(InInput), Matcher(Pattern, InInput)
+	{
+		CurrentMatch.Range = this;
+	}
+
+	FRegexMatchRange::FRegexMatchRange(const FString& Pattern, const FString& InInput) :
+		FRegexMatchRange(FRegexPattern(Pattern), InInput)
+	{
+	}
+
+	FRegexMatchRange::FIterator FRegexMatchRange::begin()
+	{
+		if (!bStarted)
+		{
+			bStarted = true;
+			if (FindNext())
+				return FIterator(this);
+		}
+		else if (CurrentMatch.Beginning != INDEX_NONE)
+		{
+			// Already started: continue from the current match
+			return FIterator(this);
+		}
+		return end();
+	}
+
+	bool FRegexMatchRange::FindNext()
+	{
+		// Empty matches are skipped (e.g. "[a-z]*" matches an empty string at every non-letter position).
+		// The matcher automatically advances past empty matches, so this can't get stuck.
+		while (Matcher.FindNext())
+		{
+			const int32 MatchBeginning = Matcher.GetMatchBeginning();
+			const int32 MatchEnding = Matcher.GetMatchEnding();
+			if (MatchEnding > MatchBeginning)
+			{
+				CurrentMatch.Beginning = MatchBeginning;
+				CurrentMatch.Ending = MatchEnding;
+				return true;
+			}
+		}
+		CurrentMatch.Beginning = INDEX_NONE;
+		CurrentMatch.Ending = INDEX_NONE;
+		return false;
+	}
+
+	FRegexReplaceTemplate::FRegexReplaceTemplate(const FString& Template, const FString& Pattern)
+	{
+		TOptional<TMap<FString, int32>> NamedGroups;
+		FString PendingLiteral;
+		auto FlushLiteral = [&]() {
+			if (PendingLiteral.Len() > 0)
+			{
+				Segments.Add({MoveTemp(PendingLiteral), INDEX_NONE});
+				PendingLiteral.Reset();
+			}
+		};
+		auto AddGroup = [&](int32 GroupIndex) {
+			FlushLiteral();
+			Segments.Add({FString(), GroupIndex});
+		};
+
+		const int32 Len = Template.Len();
+		for (int32 i = 0; i < Len; i++)
+		{
+			const TCHAR Char = Template[i];
+			if (Char != TEXT('$') || i + 1 >= Len)
+			{
+				PendingLiteral.AppendChar(Char);
+				continue;
+			}
+
+			const TCHAR Next = Template[i + 1];
+			if (Next == TEXT('$'))
+			{
+				PendingLiteral.AppendChar(TEXT('$'));
+				i++;
+			}
+			else if (FChar::IsDigit(Next))
+			{
+				// $N with up to two digits
+				int32 GroupIndex = Next - TEXT('0');
+				i++;
+				if (i + 1 < Len && FChar::IsDigit(Template[i + 1]))
+				{
+					GroupIndex = GroupIndex * 10 + (Template[i + 1] - TEXT('0'));
+					i++;
+				}
+				AddGroup(GroupIndex);
+			}
+			else if (Next == TEXT('{'))
+			{
+				const int32 ClosingIndex =
+					Template.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, i + 2);
+				if (ClosingIndex == INDEX_NONE)
+				{
+					PendingLiteral.AppendChar(Char);
+					continue;
+				}
+
+				const FString GroupName = Template.Mid(i + 2, ClosingIndex - (i + 2));
+				int32 GroupIndex = INDEX_NONE;
+				if (GroupName.Len() > 0 && GroupName.IsNumeric())
+				{
+					LexFromString(GroupIndex, *GroupName);
+				}
+				else
+				{
+					if (!NamedGroups.IsSet())
+					{
+						NamedGroups = Private::Regex::ParseNamedCaptureGroups(Pattern);
+					}
+					if (const int32* NamedGroupIndex = NamedGroups->Find(GroupName))
+					{
+						GroupIndex = *NamedGroupIndex;
+					}
+				}
+
+				if (GroupIndex == INDEX_NONE)
+				{
+					UE_LOG(
+						LogOpenUnrealUtilities,
+						Warning,
+						TEXT("Regex replace template '%s' references unknown group '%s' of pattern '%s'"),
+						*Template,
+						*GroupName,
+						*Pattern);
+					PendingLiteral.AppendChar(Char);
+					continue;
+				}
+
+				AddGroup(GroupIndex);
+				i = ClosingIndex;
+			}
+			else
+			{
+				PendingLiteral.AppendChar(Char);
+			}
+		}
+		FlushLiteral();
+	}
+
+	FRegexReplaceTemplate FRegexReplaceTemplate::Literal(const FString& String)
+	{
+		FRegexReplaceTemplate Result;
+		Result.Segments.Add({String, INDEX_NONE});
+		return Result;
+	}
+
+	void FRegexReplaceTemplate::AppendReplacement(const FRegexMatchRange::FMatch& Match, FString& OutResult) const
+	{
+		for (const FSegment& Segment : Segments)
+		{
+			if (Segment.GroupIndex == INDEX_NONE)
+			{
+				OutResult.Append(Segment.Literal);
+			}
+			else
+			{
+				const FStringView Group = Match.GetCaptureGroup(Segment.GroupIndex);
+				if (!Group.IsEmpty())
+				{
+					OutResult.AppendChars(Group.GetData(), Group.Len());
+				}
+			}
+		}
+	}
+
+	FString RegexReplace(
+		const FString& Pattern,
+		const FString& Input,
+		const FRegexReplaceTemplate& Replacement,
+		int32 MaxReplacements)
+	{
+		return Private::Regex::ReplaceMatches(
+			Pattern,
+			Input,
+			MaxReplacements,
+			[&Replacement](const FRegexMatchRange::FMatch& Match, FString& OutResult) {
+				Replacement.AppendReplacement(Match, OutResult);
+			});
+	}
+
+	FString RegexReplace(
+		const FString& Pattern,
+		const FString& Input,
+		FRegexReplaceFunc AppendReplacement,
+		int32 MaxReplacements)
+	{
+		return Private::Regex::ReplaceMatches(Pattern, Input, MaxReplacements, AppendReplacement);
+	}
+} // namespace OUU::Runtime
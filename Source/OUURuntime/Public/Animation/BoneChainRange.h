@@ -25,6 +25,9 @@ namespace OUU::Runtime::Animation
 	 * Utility container to support ranged-for loop based on bone-chain in reference skeleton.
 	 * Usage:
 	 * for (int32 BoneIndex : FBoneChainRange(ReferenceSkeleton, LeafBoneIndex)) { ... }
+	 *
+	 * Every range collects its chain from the reference skeleton. Prefer FBoneHierarchyAccelerator for repeated
+	 * chain iteration or ancestor checks on the same skeleton.
 	 */
 	template <EBoneChainDirection Direction = EBoneChainDirection::RootToLeaf>
 	struct TBoneChainRange
@@ -44,13 +47,17 @@ namespace OUU::Runtime::Animation
 
 		auto begin() const noexcept
 		{
-			return MakeReverseIteratorIf<Direction == EBoneChainDirection::LeafToRoot>(
-				OUU::Runtime::Private::IteratorUtils::end(BoneChain_RootToLeaf));
+			if constexpr (Direction == EBoneChainDirection::LeafToRoot)
+				return MakeReverseIterator(OUU::Runtime::Private::IteratorUtils::end(BoneChain_RootToLeaf));
+			else
+				return OUU::Runtime::Private::IteratorUtils::begin(BoneChain_RootToLeaf);
 		}
 		auto end() const noexcept
 		{
-			return MakeReverseIteratorIf<Direction == EBoneChainDirection::LeafToRoot>(
-				OUU::Runtime::Private::IteratorUtils::begin(BoneChain_RootToLeaf));
+			if constexpr (Direction == EBoneChainDirection::LeafToRoot)
+				return MakeReverseIterator(OUU::Runtime::Private::IteratorUtils::begin(BoneChain_RootToLeaf));
+			else
+				return OUU::Runtime::Private::IteratorUtils::end(BoneChain_RootToLeaf);
 		}
 
 	private:
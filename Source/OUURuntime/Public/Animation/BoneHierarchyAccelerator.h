@@ -0,0 +1,195 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Animation/BoneChainRange.h"
+
+namespace OUU::Runtime::Animation
+{
+	template <EBoneChainDirection Direction>
+	class TBoneChainView;
+
+	/**
+	 * Precomputed bone hierarchy of a reference skeleton for fast repeated hierarchy queries.
+	 * - Euler tour entry/exit indices for O(1) ancestor checks
+	 * - Binary lifting tables for O(log(depth)) lookup of the ancestor at a given depth
+	 * - Allocation free bone chain views with random access (see TBoneChainView)
+	 * - Child bone lists, e.g. for TraverseBoneTree / ParallelTraverseBoneTree
+	 *
+	 * Building is O(n * log(depth)). The accelerator does not track changes of the skeleton it was built from.
+	 * Usage:
+	 * const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+	 * if (Hierarchy.IsAncestorOf(SpineBoneIndex, HandBoneIndex)) { ... }
+	 * for (int32 BoneIndex : Hierarchy.GetBoneChain<EBoneChainDirection::LeafToRoot>(HandBoneIndex)) { ... }
+	 */
+	class OUURUNTIME_API FBoneHierarchyAccelerator
+	{
+	public:
+		FBoneHierarchyAccelerator() = default;
+		explicit FBoneHierarchyAccelerator(const FReferenceSkeleton& ReferenceSkeleton);
+
+		/** Rebuild from the final bone hierarchy (including virtual bones) of a reference skeleton. */
+		void Build(const FReferenceSkeleton& ReferenceSkeleton);
+
+		/**
+		 * Rebuild from a list of parent indices. Like in reference skeletons, parents must be listed before their
+		 * children. Bones without parent (INDEX_NONE) are treated as roots.
+		 */
+		void Build(TConstArrayView<int32> InParentIndices);
+
+		void Reset();
+
+		FORCEINLINE int32 Num() const { return ParentIndices.Num(); }
+		FORCEINLINE bool IsValidIndex(int32 BoneIndex) const { return ParentIndices.IsValidIndex(BoneIndex); }
+
+		FORCEINLINE int32 GetParentIndex(int32 BoneIndex) const { return ParentIndices[BoneIndex]; }
+
+		/** @returns the direct children of the bone in ascending index order */
+		FORCEINLINE TConstArrayView<int32> GetChildBones(int32 BoneIndex) const
+		{
+			const int32 FirstChild = ChildOffsets[BoneIndex];
+			const int32 NumChildren = ChildOffsets[BoneIndex + 1] - FirstChild;
+			return TConstArrayView<int32>(ChildIndices.GetData() + FirstChild, NumChildren);
+		}
+
+		/** @returns the number of ancestors of the bone, i.e. 0 for root bones */
+		FORCEINLINE int32 GetDepth(int32 BoneIndex) const { return Depths[BoneIndex]; }
+
+		/** @returns the number of bones in the subtree of the bone including the bone itself */
+		FORCEINLINE int32 GetSubtreeSize(int32 BoneIndex) const
+		{
+			return ExitIndices[BoneIndex] - EntryIndices[BoneIndex];
+		}
+
+		/** @returns if AncestorIndex is a direct or indirect parent of BoneIndex. Bones are not their own ancestors. */
+		FORCEINLINE bool IsAncestorOf(int32 AncestorIndex, int32 BoneIndex) const
+		{
+			return AncestorIndex != BoneIndex && IsSameOrAncestorOf(AncestorIndex, BoneIndex);
+		}
+
+		/** @returns if BoneIndex is part of the subtree starting at AncestorIndex */
+		FORCEINLINE bool IsSameOrAncestorOf(int32 AncestorIndex, int32 BoneIndex) const
+		{
+			return EntryIndices[AncestorIndex] <= EntryIndices[BoneIndex]
+				&& ExitIndices[BoneIndex] <= ExitIndices[AncestorIndex];
+		}
+
+		/**
+		 * @returns the ancestor of the bone with the given depth (0 = root of the bone), the bone itself if Depth is
+		 * the depth of the bone or INDEX_NONE if Depth exceeds the depth of the bone.
+		 */
+		int32 GetAncestorAtDepth(int32 BoneIndex, int32 Depth) const;
+
+		/** Chain of bones from the root to the leaf bone (or the other way around). Does not allocate. */
+		template <EBoneChainDirection Direction = EBoneChainDirection::RootToLeaf>
+		TBoneChainView<Direction> GetBoneChain(
+			int32 LeafBoneIndex,
+			EBoneChainLeaf LeafStatus = EBoneChainLeaf::Include) const;
+
+	private:
+		TArray<int32> ParentIndices;
+		TArray<int32> Depths;
+
+		/** Children of all bones in one array. Children of a bone are [ChildOffsets[Bone], ChildOffsets[Bone + 1]) */
+		TArray<int32> ChildOffsets;
+		TArray<int32> ChildIndices;
+
+		/** Position of the bone in a depth first traversal. Subtree of a bone is [Entry, Exit) */
+		TArray<int32> EntryIndices;
+		TArray<int32> ExitIndices;
+
+		/** AncestorTable[Level * Num() + BoneIndex] is the (2^Level)-th ancestor of the bone or INDEX_NONE */
+		TArray<int32> AncestorTable;
+		int32 NumLevels = 0;
+	};
+
+	/**
+	 * View on the bone chain of a leaf bone backed by the arrays of a FBoneHierarchyAccelerator.
+	 * Iterating leaf to root follows the parent indices. Root to leaf iteration and random access look up the
+	 * ancestors via binary lifting.
+	 * The view must not outlive the accelerator it was created from.
+	 */
+	template <EBoneChainDirection Direction>
+	class TBoneChainView
+	{
+	public:
+		class FIterator
+		{
+		public:
+			FIterator(const TBoneChainView& InView, int32 InChainIndex) :
+				View(&InView), ChainIndex(InChainIndex),
+				BoneIndex(InChainIndex < InView.Num() ? InView[InChainIndex] : INDEX_NONE)
+			{
+			}
+
+			FORCEINLINE int32 operator*() const { return BoneIndex; }
+
+			FORCEINLINE FIterator& operator++()
+			{
+				++ChainIndex;
+				if (ChainIndex >= View->Num())
+				{
+					BoneIndex = INDEX_NONE;
+				}
+				else if constexpr (Direction == EBoneChainDirection::LeafToRoot)
+				{
+					BoneIndex = View->Hierarchy->GetParentIndex(BoneIndex);
+				}
+				else
+				{
+					BoneIndex = (*View)[ChainIndex];
+				}
+				return *this;
+			}
+
+			FORCEINLINE bool operator==(const FIterator& Other) const { return ChainIndex == Other.ChainIndex; }
+			FORCEINLINE bool operator!=(const FIterator& Other) const { return ChainIndex != Other.ChainIndex; }
+
+		private:
+			const TBoneChainView* View;
+			int32 ChainIndex;
+			int32 BoneIndex;
+		};
+
+		TBoneChainView(const FBoneHierarchyAccelerator& InHierarchy, int32 InLeafBoneIndex, EBoneChainLeaf LeafStatus) :
+			Hierarchy(&InHierarchy),
+			// Excluding the leaf is equivalent to starting with its parent
+			LeafBoneIndex(
+				LeafStatus == EBoneChainLeaf::Exclude && InHierarchy.IsValidIndex(InLeafBoneIndex)
+					? InHierarchy.GetParentIndex(InLeafBoneIndex)
+					: InLeafBoneIndex),
+			NumBones(InHierarchy.IsValidIndex(LeafBoneIndex) ? InHierarchy.GetDepth(LeafBoneIndex) + 1 : 0)
+		{
+		}
+
+		FORCEINLINE int32 Num() const { return NumBones; }
+		FORCEINLINE bool IsEmpty() const { return NumBones == 0; }
+
+		/** @returns the bone at the given position in iteration order */
+		FORCEINLINE int32 operator[](int32 ChainIndex) const
+		{
+			check(ChainIndex >= 0 && ChainIndex < NumBones);
+			const int32 Depth =
+				Direction == EBoneChainDirection::RootToLeaf ? ChainIndex : (NumBones - 1 - ChainIndex);
+			return Hierarchy->GetAncestorAtDepth(LeafBoneIndex, Depth);
+		}
+
+		FORCEINLINE FIterator begin() const { return FIterator(*this, 0); }
+		FORCEINLINE FIterator end() const { return FIterator(*this, NumBones); }
+
+	private:
+		const FBoneHierarchyAccelerator* Hierarchy;
+		int32 LeafBoneIndex;
+		int32 NumBones;
+	};
+
+	template <EBoneChainDirection Direction>
+	TBoneChainView<Direction> FBoneHierarchyAccelerator::GetBoneChain(
+		int32 LeafBoneIndex,
+		EBoneChainLeaf LeafStatus) const
+	{
+		return TBoneChainView<Direction>(*this, LeafBoneIndex, LeafStatus);
+	}
+} // namespace OUU::Runtime::Animation
@@ -4,7 +4,9 @@
 
 #include "CoreMinimal.h"
 
+#include "Animation/BoneHierarchyAccelerator.h"
 #include "Animation/Skeleton.h"
+#include "Async/ParallelFor.h"
 
 namespace OUU::Runtime::Animation
 {
@@ -25,7 +27,13 @@ namespace OUU::Runtime::Animation
 		// Forward declaration. See below...
 		template <typename PredicateType>
 		ETraverseBoneTreeAction TraverseBoneTreeImpl(USkeleton* Skeleton, int32 BoneIndex, PredicateType Predicate);
-	}
+
+		template <typename PredicateType>
+		ETraverseBoneTreeAction TraverseBoneTreeImpl(
+			const FBoneHierarchyAccelerator& Hierarchy,
+			int32 BoneIndex,
+			PredicateType& Predicate);
+	} // namespace Private
 
 	/**
 	 * Traverse through all bone indices in a skeleton root to leaf starting from a given root bone index.
@@ -41,8 +49,112 @@ namespace OUU::Runtime::Animation
 		Private::TraverseBoneTreeImpl(Skeleton, StartBoneIndex, Predicate);
 	}
 
+	/**
+	 * Traverse through all bone indices of a precomputed bone hierarchy root to leaf in the same order as the
+	 * USkeleton version above. Prefer this for large skeletons or repeated traversals, because child bones are looked
+	 * up from the hierarchy instead of searching through all bones of the skeleton for every bone.
+	 */
+	template <typename PredicateType>
+	void TraverseBoneTree(
+		const FBoneHierarchyAccelerator& Hierarchy,
+		PredicateType Predicate,
+		int32 StartBoneIndex = ROOT_BONE_IDX)
+	{
+		if (Hierarchy.IsValidIndex(StartBoneIndex))
+		{
+			Private::TraverseBoneTreeImpl(Hierarchy, StartBoneIndex, Predicate);
+		}
+	}
+
+	/**
+	 * Level-synchronous traversal that invokes the predicate for all bones of the same depth in parallel.
+	 * Use this for expensive per-bone work in which bones only depend on the results of their parent bones: All
+	 * predicate calls of a parent bone are finished before any of its children are processed.
+	 * - SkipChildBones: Children of the bone are not visited
+	 * - Stop: All remaining bones of the current depth are still processed, but no deeper bones are visited
+	 * The set of visited bones is deterministic and equal to the serial traversal unless Stop is returned.
+	 * @param	Hierarchy			Precomputed hierarchy of the skeleton through which to iterate
+	 * @param	Predicate			Invoked for every bone index in the tree. Must be safe to call from any thread.
+	 * @param	StartBoneIndex		Index of the bone at which to start the traversal.
+	 * @param	Flags				Flags passed to ParallelFor, e.g. EParallelForFlags::ForceSingleThread for debugging
+	 * @tparam	PredicateType		ETraverseBonesAction(int32)
+	 */
+	template <typename PredicateType>
+	void ParallelTraverseBoneTree(
+		const FBoneHierarchyAccelerator& Hierarchy,
+		PredicateType Predicate,
+		int32 StartBoneIndex = ROOT_BONE_IDX,
+		EParallelForFlags Flags = EParallelForFlags::None)
+	{
+		if (!Hierarchy.IsValidIndex(StartBoneIndex))
+			return;
+
+		TArray<int32> CurrentLevel = {StartBoneIndex};
+		TArray<int32> NextLevel;
+		TArray<ETraverseBoneTreeAction> Actions;
+		while (CurrentLevel.Num() > 0)
+		{
+			Actions.SetNumUninitialized(CurrentLevel.Num());
+			ParallelFor(
+				CurrentLevel.Num(),
+				[&](int32 LevelIndex) { Actions[LevelIndex] = Predicate(CurrentLevel[LevelIndex]); },
+				Flags);
+
+			// Collect children in the order of their parents, so the processing order of the next level is stable
+			NextLevel.Reset();
+			bool bStop = false;
+			for (int32 LevelIndex = 0; LevelIndex < CurrentLevel.Num(); LevelIndex++)
+			{
+				switch (Actions[LevelIndex])
+				{
+				case ETraverseBoneTreeAction::ContinueWithChildBones:
+					NextLevel.Append(Hierarchy.GetChildBones(CurrentLevel[LevelIndex]));
+					break;
+				case ETraverseBoneTreeAction::Stop: bStop = true; break;
+				default: break;
+				}
+			}
+			if (bStop)
+				return;
+
+			Swap(CurrentLevel, NextLevel);
+		}
+	}
+
+	/** Level-synchronous parallel traversal through the bones of a skeleton. See overload above. */
+	template <typename PredicateType>
+	void ParallelTraverseBoneTree(
+		USkeleton* Skeleton,
+		PredicateType Predicate,
+		int32 StartBoneIndex = ROOT_BONE_IDX,
+		EParallelForFlags Flags = EParallelForFlags::None)
+	{
+		const FBoneHierarchyAccelerator Hierarchy(Skeleton->GetReferenceSkeleton());
+		ParallelTraverseBoneTree(Hierarchy, MoveTemp(Predicate), StartBoneIndex, Flags);
+	}
+
 	namespace Private
 	{
+		template <typename PredicateType>
+		ETraverseBoneTreeAction TraverseBoneTreeImpl(
+			const FBoneHierarchyAccelerator& Hierarchy,
+			int32 BoneIndex,
+			PredicateType& Predicate)
+		{
+			const ETraverseBoneTreeAction NextAction = Predicate(BoneIndex);
+			if (NextAction == ETraverseBoneTreeAction::ContinueWithChildBones)
+			{
+				for (const int32 ChildBoneIndex : Hierarchy.GetChildBones(BoneIndex))
+				{
+					const ETraverseBoneTreeAction ChildAction =
+						TraverseBoneTreeImpl(Hierarchy, ChildBoneIndex, Predicate);
+					if (ChildAction == ETraverseBoneTreeAction::Stop)
+						return ETraverseBoneTreeAction::Stop;
+				}
+			}
+			return NextAction;
+		}
+
 		template <typename PredicateType>
 		ETraverseBoneTreeAction TraverseBoneTreeImpl(USkeleton* Skeleton, int32 BoneIndex, PredicateType Predicate)
 		{
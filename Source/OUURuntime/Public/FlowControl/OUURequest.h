@@ -26,11 +26,17 @@ enum class EOUURequestState : uint8
 
 FString OUURUNTIME_API LexToString(EOUURequestState State);
 
+constexpr int32 OUURequestStateNum = static_cast<int32>(EOUURequestState::Failed) + 1;
+
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnRequestStatusChangedDelegate, UOUURequest*, Request, EOUURequestState, State);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRequestStatusChanged, UOUURequest*, Request, EOUURequestState, State);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FOnRequestRaisedDelegate, UOUURequest*, Request);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRequestRaised, UOUURequest*, Request);
 
+// Native variants of the delegates above for C++ callers
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRequestStatusChangedNative, UOUURequest*, EOUURequestState);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnRequestRaisedNative, UOUURequest*);
+
 /**
  * Request object that represents a request from one component to another.
  * One possible application for requests are blueprint callbacks where a C++ system makes a request and binds to the
@@ -43,6 +49,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRequestRaised, UOUURequest*, Requ
  *
  * Request payload data should be added as class members of child classes and can be set up with bidirectional
  * read/write access (from caller to responder and vice versa).
+ *
+ * The time at which each state was entered is recorded, so the latency between raising and completing a request can
+ * be measured (see GetLatency()). State transitions are validated in builds with checks enabled.
  */
 UCLASS(BlueprintType, Blueprintable)
 class OUURUNTIME_API UOUURequest : public UObject
@@ -64,6 +73,11 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FOnRequestStatusChanged OnCompleted;
 
+	/** Native variants of the delegates above. Broadcast before their dynamic counterparts. */
+	FOnRequestStatusChangedNative OnStatusChangedNative;
+	FOnRequestRaisedNative OnRaisedNative;
+	FOnRequestStatusChangedNative OnCompletedNative;
+
 	/**
 	 * Should the status be reset to Idle automatically after completion?
 	 * If this is unchecked, the request has to be reset manually via Reset();
@@ -79,6 +93,12 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void RaiseAndWait(FOnRequestStatusChangedDelegate CompletedCallback);
 
+	/**
+	 * Raise the request and bind a native callback that will be called once when the request is completed.
+	 * Unlike RaiseAndWait(), the callback is unbound after it was called.
+	 */
+	void RaiseAndWaitNative(FOnRequestStatusChangedNative::FDelegate CompletedCallback);
+
 	/**
 	 * Drop the request from the caller side. (i.e. "never mind, I don't need this anymore")
 	 * Doesn't do anything if the request is not in the pending state.
@@ -104,8 +124,25 @@ public:
 	UFUNCTION(BlueprintPure)
 	EOUURequestState GetState() const;
 
+	/**
+	 * Get the time (in FPlatformTime::Seconds()) at which the state was entered most recently.
+	 * The times of all other states are cleared when the request is raised again.
+	 * @returns 0 if the state was not entered yet
+	 */
+	double GetStateEnterTime(EOUURequestState InState) const;
+
+	/** @returns the time in seconds between raising and completing the request or 0 if it was not completed yet */
+	double GetLatency() const;
+
+	/** Idle -> Pending -> Canceled/Successful/Failed -> Idle */
+	static bool IsValidStateTransition(EOUURequestState From, EOUURequestState To);
+
 private:
 	EOUURequestState State = EOUURequestState::Idle;
 
+	double StateEnterTimes[OUURequestStateNum] = {};
+
+	TArray<FOnRequestStatusChangedNative::FDelegate, TInlineAllocator<1>> NativeCompletedCallbacks;
+
 	void ChangeState(EOUURequestState NewState);
 };
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "FlowControl/OUURequest.h"
+#include "Templates/CircularQuantileAggregator.h"
 #include "Templates/SubclassOf.h"
 
 #include "OUURequestQueue.generated.h"
@@ -32,6 +33,21 @@ public:
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UOUURequest> RequestClass;
 
+	/** Record a histogram of the latencies between raising and completing (successfully or failed) requests */
+	UPROPERTY(EditDefaultsOnly)
+	bool bRecordLatencyHistogram = false;
+
+	/** Number of most recent request latencies that are kept in the histogram */
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bRecordLatencyHistogram", ClampMin = 1))
+	int32 LatencyHistogramNumSamples = 1000;
+
+	/** Upper bound of the histogram range in seconds. Longer latencies are counted as overflow. */
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bRecordLatencyHistogram", ClampMin = 0.001))
+	float LatencyHistogramMaxSeconds = 1.f;
+
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bRecordLatencyHistogram", ClampMin = 1))
+	int32 LatencyHistogramNumBuckets = 100;
+
 	/**
 	 * Raise a new request. Adds a new element to the queue.
 	 * The request must be manually raised by the caller!
@@ -82,15 +98,24 @@ public:
 	UFUNCTION(BlueprintCallable)
 	UOUURequest* GetOldestRequestWithState(EOUURequestState State) const;
 
+	/**
+	 * Get the latency histogram (in seconds) of the most recently completed requests.
+	 * @returns nullptr if bRecordLatencyHistogram is disabled or no request was completed yet
+	 */
+	const TCircularHistogramAggregator<double>* GetLatencyHistogram() const;
+
+	/** Drop all recorded latencies, e.g. after changing the histogram settings */
+	void ResetLatencyHistogram();
+
 private:
 	UPROPERTY(Transient)
 	TArray<UOUURequest*> RequestQueue;
 
+	TUniquePtr<TCircularHistogramAggregator<double>> LatencyHistogram;
+
 	// React to one of the requests that were created in the queue being raised.
-	UFUNCTION()
 	void HandleRequestRaised(UOUURequest* Request);
 
 	// React to one of the requests that were created in the queue being completed.
-	UFUNCTION()
 	void HandleRequestCompleted(UOUURequest* Request, EOUURequestState State);
 };
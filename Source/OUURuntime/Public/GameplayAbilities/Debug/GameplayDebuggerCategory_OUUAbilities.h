@@ -10,6 +10,9 @@
 	#include "GameplayDebuggerCategory.h"
 
 class UOUUAbilitySystemComponent;
+class UGameplayCueManager;
+class UGameplayCueSet;
+class UGameplayTask;
 
 class AActor;
 class APlayerController;
@@ -56,6 +59,154 @@ protected:
 
 	float NumColumns = 4;
 
+	/**
+	 * Index of all gameplay cues of the runtime cue set with pre-built display strings.
+	 * Only rebuilt when the cue set changes. Load states are only re-checked for cues that were not loaded yet.
+	 */
+	struct FGameplayCueDebugIndex
+	{
+	public:
+		enum class ECueType : uint8
+		{
+			NotLoaded,
+			Static,
+			Actor,
+			Other
+		};
+
+		struct FEntry
+		{
+			FGameplayTag Tag;
+			int32 CueDataIdx = INDEX_NONE;
+			ECueType Type = ECueType::NotLoaded;
+			/** Tag string without the base cue tag prefix */
+			FString TagDisplayString;
+			FString CueClassDisplayString;
+
+			/** Line text cached for the active count at which it was built */
+			FString CachedLine;
+			int32 CachedLineActiveCount = INDEX_NONE;
+		};
+
+		TArray<FEntry> Entries;
+
+		/** Indices into Entries that match the current filter */
+		TArray<int32> FilteredEntries;
+
+		/** Update the index from the runtime cue set of the cue manager. */
+		void Update(const UGameplayCueManager* CueManager, const FString& Filter);
+
+	private:
+		TWeakObjectPtr<const UGameplayCueSet> IndexedCueSet;
+		int32 NumIndexedCueData = INDEX_NONE;
+		TArray<int32> NotLoadedEntries;
+		FString CurrentFilter;
+		bool bFilterDirty = true;
+
+		void Rebuild(const UGameplayCueSet& CueSet);
+		void UpdateLoadState(FEntry& Entry, const UGameplayCueSet& CueSet) const;
+		void UpdateFilter();
+	};
+
+	mutable FGameplayCueDebugIndex CueDebugIndex;
+
+	/**
+	 * Status lines of ability specs cached by spec handle.
+	 * Lines are only rebuilt if the state hash of the spec (activation state, cooldown bucket, failure tags, etc)
+	 * changes.
+	 * Entries and task strings that were not visited in the current draw (Generation) are pruned.
+	 */
+	struct FAbilitySpecDebugCache
+	{
+	public:
+		struct FTaskDebugString
+		{
+			FString Text;
+			double UpdateTime = -1.0;
+			uint32 SeenGeneration = 0;
+		};
+
+		struct FEntry
+		{
+			TWeakObjectPtr<const UGameplayAbility> Ability;
+			FString AbilityName;
+			TOptional<bool> bPassesFilter;
+			uint32 SeenGeneration = 0;
+
+			bool bHasLine = false;
+			uint32 StateHash = 0;
+			FString Line;
+			FColor LineColor = FColor::White;
+
+			/** GetDebugString() of the active ability tasks. Refreshed periodically, because tasks may be polled. */
+			TMap<TWeakObjectPtr<const UGameplayTask>, FTaskDebugString> TaskDebugStrings;
+		};
+
+		TWeakObjectPtr<const UAbilitySystemComponent> Owner;
+		FString Filter;
+		TMap<FGameplayAbilitySpecHandle, FEntry> Entries;
+		uint32 Generation = 0;
+
+		void Reset()
+		{
+			Owner.Reset();
+			Filter.Reset();
+			Entries.Reset();
+		}
+	};
+
+	mutable FAbilitySpecDebugCache AbilitySpecDebugCache;
+
+	/**
+	 * Previous attribute snapshot with formatted lines per attribute.
+	 * Lines are only reformatted if the value, base value or mod list of an attribute changed.
+	 */
+	struct FAttributeDebugCache
+	{
+	public:
+		struct FModLine
+		{
+			FString Text;
+			bool bQualifies = false;
+		};
+
+		struct FEntry
+		{
+			bool bInitialized = false;
+			float Value = 0.f;
+			float BaseValue = 0.f;
+			uint32 ModListHash = 0;
+
+			/** World time of the last value change or -1 if the value never changed since the first snapshot */
+			double LastChangeTime = -1.0;
+			float LastChangeDelta = 0.f;
+
+			FString Line;
+			TArray<FModLine> ModLines;
+
+			/** @returns if any of the values changed and the lines must be rebuilt */
+			bool Update(float NewValue, float NewBaseValue, uint32 NewModListHash, double Now);
+		};
+
+		TWeakObjectPtr<const UAbilitySystemComponent> Owner;
+		/** Attributes that have aggregator mods */
+		TMap<FGameplayAttribute, FEntry> ModifiedAttributes;
+		/** All attributes of spawned attribute sets */
+		TMap<FGameplayAttribute, FEntry> AllAttributes;
+		TMap<TWeakObjectPtr<const UClass>, TArray<FGameplayAttribute>> SetClassAttributes;
+
+		const TArray<FGameplayAttribute>& GetAttributesOfSetClass(const UClass* SetClass);
+
+		void Reset()
+		{
+			Owner.Reset();
+			ModifiedAttributes.Reset();
+			AllAttributes.Reset();
+		}
+	};
+
+	mutable FAttributeDebugCache AttributeDebugCache;
+
 	static void DrawBackground(
 		FGameplayDebuggerCanvasContext& CanvasContext,
 		const FVector2D& BackgroundLocation,
@@ -72,7 +223,7 @@ protected:
 	static void GetAttributeAggregatorSnapshot(
 		UOUUAbilitySystemComponent* AbilitySystem,
 		const FGameplayAttribute& Attribute,
-		FAggregator SnapshotAggregator);
+		FAggregator& OutSnapshotAggregator);
 	void DrawTitle(FAbilitySystemComponentDebugInfo& Info, const FString& DebugTitle) const;
 	void DrawDebugHeader(FAbilitySystemComponentDebugInfo& Info, const UOUUAbilitySystemComponent* AbilitySystem) const;
 
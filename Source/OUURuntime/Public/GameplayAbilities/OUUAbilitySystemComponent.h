@@ -4,6 +4,7 @@
 
 #include "AbilitySystemComponent.h"
 #include "Templates/CircularArrayAdaptor.h"
+#include "UObject/ObjectKey.h"
 
 #include "OUUAbilitySystemComponent.generated.h"
 
@@ -51,6 +52,23 @@ public:
 	float EventMagnitude = 0.f;
 };
 
+/**
+ * Filter for queries of the gameplay event history of UOUUAbilitySystemComponent.
+ * All set conditions must match for an event to be included.
+ */
+struct OUURUNTIME_API FOUUGameplayEventHistoryQuery
+{
+public:
+	/** Events must match this tag (incl. child tags unless bExactTagMatch is set). Ignored if invalid. */
+	FGameplayTag EventTag;
+	bool bExactTagMatch = false;
+
+	/** Events must have been instigated by this actor. Ignored if not set. */
+	TOptional<const AActor*> Instigator;
+
+	bool Matches(const FOUUGameplayEventData& Event) const;
+};
+
 /**
  * Custom ability system component that provides friend access to FGameplayDebuggerCategory_OUUAbilities
  * (required to access some of the protected members of the parent class)
@@ -68,7 +86,25 @@ public:
 	int32 HandleGameplayEvent(FGameplayTag EventTag, const FGameplayEventData* Payload) override;
 	// --
 
+	/**
+	 * @returns pointers to all events in the gameplay event history that match the query (oldest to newest).
+	 * Uses the secondary indices by tag and instigator, so only matching entries are visited.
+	 * The pointers are invalidated by the next gameplay event.
+	 */
+	TArray<const FOUUGameplayEventData*> QueryGameplayEventHistory(const FOUUGameplayEventHistoryQuery& Query) const;
+
+	/**
+	 * Write all events matching the query to a file.
+	 * @param	bJson	If true the file is written as JSON array, otherwise as CSV with a header row.
+	 */
+	bool DumpGameplayEventHistoryToFile(
+		const FOUUGameplayEventHistoryQuery& Query,
+		const FString& FilePath,
+		bool bJson) const;
+
 protected:
+	static constexpr int32 GameplayEventHistorySize = 50;
+
 	int32 EventCounter = 0;
 
 	/**
@@ -82,5 +118,17 @@ protected:
 	 * Circular buffer adapter for the gameplay event history.
 	 * Use this to access the history elements!
 	 */
-	TCircularArrayAdaptor<FOUUGameplayEventData> CircularGameplayEventHistory{GameplayEventHistory, 50};
+	TCircularArrayAdaptor<FOUUGameplayEventData> CircularGameplayEventHistory{
+		GameplayEventHistory,
+		GameplayEventHistorySize};
+
+	/**
+	 * Secondary indices of the gameplay event history.
+	 * Contain the event numbers of all events in the history in ascending order.
+	 */
+	TMap<FGameplayTag, TArray<int32>> GameplayEventHistoryByTag;
+	TMap<FObjectKey, TArray<int32>> GameplayEventHistoryByInstigator;
+
+	const FOUUGameplayEventData* FindGameplayEventInHistory(int32 EventNumber) const;
+	void AddToGameplayEventHistory(const FOUUGameplayEventData& Event);
 };
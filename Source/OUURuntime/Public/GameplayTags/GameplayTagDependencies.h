@@ -72,8 +72,18 @@ public:
 	virtual void RemoveDependency(TScriptInterface<IGameplayTagDependencyInterface> Dependency);
 
 	TMap<FGameplayTag, const UObject*> GetImmediateTagSources() const;
+
+	// Objects that introduce tags via their own tags, i.e. this object or any direct or indirect dependency.
+	// Served from an index that is maintained when own tags are broadcast or dependencies change.
 	void GetOriginalTagSources(TMap<FGameplayTag, TSet<const UObject*>>& InOutResult) const;
 
+	// Objects that introduce the exact tag via their own tags. Hash lookup in the maintained index.
+	TArray<const UObject*> GetOriginalTagSources(const FGameplayTag& Tag) const;
+
+	// Same result as GetOriginalTagSources() but walks the whole dependency graph instead of using the index.
+	// Only intended for debugging and validation of the index.
+	void RecomputeOriginalTagSources(TMap<FGameplayTag, TSet<const UObject*>>& InOutResult) const;
+
 private:
 	enum class EGameplayTagDependencyGetMode
 	{
@@ -94,6 +104,15 @@ private:
 	// a change call.
 	TArray<TWeakInterfacePtr<IGameplayTagDependencyInterface>> ImmediateDependants;
 
+	// Source object -> number of dependency paths via which the source contributes a tag
+	using FTagSourceCounts = TMap<TWeakObjectPtr<const UObject>, int32>;
+	using FTagSourceIndex = TMap<FGameplayTag, FTagSourceCounts>;
+
+	// Original sources of all tags. Contains the own tags of this object and the indices of all dependencies.
+	// Dependencies that become invalid without being removed are not subtracted, so remove dependencies before
+	// destroying them.
+	FTagSourceIndex OriginalTagSources;
+
 	FGameplayTagDependencyMulticastEvent OnTagsChanged;
 
 	void UpdateCachedTags(EGameplayTagDependencyGetMode Mode);
@@ -105,4 +124,10 @@ private:
 		bool bUseCache,
 		bool bUse2ndLevelCache) const;
 	void BroadcastTagsChanged_Recursive(const FGameplayTagContainer& AllTagsBefore);
+	// Is Other a direct or indirect dependency of this object?
+	bool DependsOn_Recursive(
+		const IGameplayTagDependencyInterface* Other,
+		TSet<const IGameplayTagDependencyInterface*>& Visited) const;
+	// Add the source count changes (multiplied by Factor) to this object and all dependants
+	void ApplyTagSourceDelta_Recursive(const FTagSourceIndex& Delta, int32 Factor);
 };
@@ -0,0 +1,136 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Logging/MessageLogSeverity.h"
+#include "Logging/MessageLogToken.h"
+#include "UObject/ObjectKey.h"
+
+class FTokenizedMessage;
+class IMessageToken;
+
+/**
+ * Collects message log messages and adds all of them to a single new message log page at once.
+ * Adding messages one by one via FMessageLog flushes the log listing for every message, which gets very slow for
+ * validators that report thousands of issues.
+ *
+ * Messages can be added with a context object or asset, in which case they are grouped by that context:
+ * - All messages and tokens referencing the same object/asset share one interned token instance.
+ * - Identical messages are collapsed into one message with a repeat count.
+ * - The message log listing does not support nesting, so each group starts with a summary line that links the
+ *	 context and lists the message counts, followed by at most MaxMessagesPerGroup unique messages.
+ * Messages without context are committed after all groups (also collapsed).
+ *
+ * Example:
+ *	FMessageLogBatch Batch(GetMessageLogName(EMessageLogName::AssetCheck), INVTEXT("My Validation"));
+ *	Batch.AddForObject(Asset, EMessageLogSeverity::Error, TEXT("references missing asset"), MissingPath);
+ *	Batch.Commit();
+ */
+class OUURUNTIME_API FMessageLogBatch
+{
+public:
+	FMessageLogBatch(FName InMessageLogName, const FText& InPageLabel);
+	/** Commits all messages that were not committed yet */
+	~FMessageLogBatch();
+
+	UE_NONCOPYABLE(FMessageLogBatch);
+
+	/** Maximum number of unique messages per context group. Remaining messages are summarized in a single line. */
+	int32 MaxMessagesPerGroup = 100;
+
+	/** Add a message without context */
+	void AddMessage(EMessageLogSeverity Severity, const TArray<FMessageLogToken>& Tokens);
+
+	/** Add a message that is grouped with all other messages of the same context object */
+	void AddObjectMessage(
+		const UObject* ContextObject,
+		EMessageLogSeverity Severity,
+		const TArray<FMessageLogToken>& Tokens);
+
+	/** Add a message that is grouped with all other messages of the same context asset */
+	void AddAssetMessage(
+		const FString& ContextAssetName,
+		EMessageLogSeverity Severity,
+		const TArray<FMessageLogToken>& Tokens);
+
+	/** Add a message without context from a list of tokenizable arguments (see FMessageLogToken::CreateList) */
+	template <typename... ArgTypes>
+	FORCEINLINE void Add(EMessageLogSeverity Severity, ArgTypes... Args)
+	{
+		AddMessage(Severity, FMessageLogToken::CreateList(Args...));
+	}
+
+	/** Add a message with context object from a list of tokenizable arguments */
+	template <typename... ArgTypes>
+	FORCEINLINE void AddForObject(const UObject* ContextObject, EMessageLogSeverity Severity, ArgTypes... Args)
+	{
+		AddObjectMessage(ContextObject, Severity, FMessageLogToken::CreateList(Args...));
+	}
+
+	/** @returns the number of added messages including collapsed duplicates */
+	FORCEINLINE int32 Num() const { return NumMessages; }
+	FORCEINLINE bool IsEmpty() const { return NumMessages == 0; }
+	int32 NumWithSeverity(EMessageLogSeverity Severity) const;
+	/** @returns the number of messages after collapsing identical messages of the same context */
+	int32 NumUniqueMessages() const;
+	/** @returns the number of distinct object/asset tokens shared by all messages */
+	FORCEINLINE int32 NumInternedTokens() const { return InternedObjectTokens.Num() + InternedAssetTokens.Num(); }
+
+	/** Build the native messages in the order in which they would be committed. Does not reset the batch. */
+	TArray<TSharedRef<FTokenizedMessage>> BuildMessages() const;
+
+	/**
+	 * Add all collected messages to a new page of the message log and reset the batch.
+	 * Does not create a page if the batch is empty.
+	 * @returns the number of native messages added to the message log
+	 */
+	int32 Commit();
+
+	/** Discard all collected messages */
+	void Reset();
+
+private:
+	struct FMessage
+	{
+		EMessageLogSeverity Severity = EMessageLogSeverity::Info;
+		TArray<TSharedRef<IMessageToken>> Tokens;
+		int32 Count = 1;
+	};
+
+	struct FGroup
+	{
+		/** Object or asset token of the context. Invalid for the group of messages without context. */
+		TSharedPtr<IMessageToken> ContextToken;
+		TArray<FMessage> Messages;
+		/** Identity key of the message severity and tokens -> index in Messages */
+		TMap<FString, int32> MessageIndices;
+		int32 NumMessages = 0;
+		int32 NumErrors = 0;
+		int32 NumWarnings = 0;
+	};
+
+	FName MessageLogName;
+	FText PageLabel;
+
+	/** Index 0 is the group of messages without context, which is committed last. */
+	TArray<FGroup> Groups;
+	TMap<FObjectKey, int32> ObjectGroupIndices;
+	TMap<FString, int32> AssetGroupIndices;
+
+	TMap<FObjectKey, TSharedRef<IMessageToken>> InternedObjectTokens;
+	TMap<FString, TSharedRef<IMessageToken>> InternedAssetTokens;
+
+	int32 NumMessages = 0;
+	/** Message counts indexed by severity */
+	int32 NumMessagesPerSeverity[5] = {};
+
+	TSharedRef<IMessageToken> GetObjectToken(const UObject* Object);
+	TSharedRef<IMessageToken> GetAssetToken(const FString& AssetName);
+
+	/** Convert a token to a native token. Object and asset tokens without label override are interned. */
+	TSharedRef<IMessageToken> ToNativeToken(const FMessageLogToken& Token);
+
+	void AddMessageToGroup(int32 GroupIdx, EMessageLogSeverity Severity, const TArray<FMessageLogToken>& Tokens);
+};
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Lock order validation is compiled out of shipping builds by default.
+ * Define OUU_WITH_LOCK_ORDER_VALIDATION=0/1 in your target rules to override.
+ */
+#ifndef OUU_WITH_LOCK_ORDER_VALIDATION
+	#define OUU_WITH_LOCK_ORDER_VALIDATION (!UE_BUILD_SHIPPING)
+#endif
+
+#if OUU_WITH_LOCK_ORDER_VALIDATION
+
+namespace OUU::Runtime
+{
+	/** A lock order cycle that was detected by FLockOrderValidator */
+	struct FLockOrderViolation
+	{
+		/**
+		 * Locks that form the cycle. Every lock was acquired while the previous lock in the list was held,
+		 * the first lock while the last lock was held.
+		 */
+		TArray<const void*> Cycle;
+
+		/** Human readable description of the cycle including the call stacks that recorded each lock order */
+		FString Report;
+	};
+
+	/**
+	 * Debug utility that detects potential deadlocks caused by inconsistent lock acquisition order.
+	 *
+	 * Every time a thread acquires a lock while holding other locks, the order "held lock -> acquired lock" is
+	 * recorded in a global graph together with the call stack of the acquisition. As soon as a new order closes a
+	 * cycle in that graph, the cycle is reported. This happens even if the locks never actually deadlocked, e.g.
+	 * because the conflicting code paths did not run concurrently (yet).
+	 *
+	 * TRWLockedVariable and TScopedMultiRWLock report their locks automatically. Other locks can be reported via
+	 * OnLockAcquired() / OnLockReleased() / OnLockDestroyed() using any unique address as lock identity.
+	 * Lock identity is the lock instance, so locks must report their destruction to prevent false positives when
+	 * the memory is reused for another lock.
+	 *
+	 * Only available if OUU_WITH_LOCK_ORDER_VALIDATION is enabled.
+	 */
+	class OUURUNTIME_API FLockOrderValidator
+	{
+	public:
+		using FViolationHandler = TFunction<void(const FLockOrderViolation&)>;
+
+		static FLockOrderValidator& Get();
+
+		/** Must be called before the calling thread starts waiting for the lock */
+		void OnLockAcquired(const void* Lock);
+		void OnLockReleased(const void* Lock);
+		/** Forget all recorded orders of the lock */
+		void OnLockDestroyed(const void* Lock);
+
+		/** @returns if Second was acquired while First was held at any point in time */
+		bool HasRecordedOrder(const void* First, const void* Second) const;
+
+		/** Forget all recorded lock orders. Locks that are currently held are not affected. */
+		void Reset();
+
+		/**
+		 * Replace the function that is called for every detected lock order violation. The default handler (if null)
+		 * logs the report as error.
+		 * @returns the previous handler
+		 */
+		FViolationHandler SetViolationHandler(FViolationHandler InHandler);
+
+	private:
+		struct FOrderEdge
+		{
+			const void* SecondLock = nullptr;
+			uint32 ThreadId = 0;
+			TArray<uint64> CallStack;
+		};
+
+		mutable FCriticalSection CriticalSection;
+		/** Recorded lock orders: First lock -> all locks acquired while it was held */
+		TMap<const void*, TArray<FOrderEdge>> OrderEdges;
+		/** All locks that are part of any recorded order */
+		TSet<const void*> OrderedLocks;
+		FViolationHandler ViolationHandler;
+
+		const FOrderEdge* FindEdge(const void* First, const void* Second) const;
+
+		/** @returns the path of locks from Start to Target (both inclusive) or an empty array if there is none */
+		TArray<const void*> FindPath(const void* Start, const void* Target) const;
+
+		FString CreateReport(const TArray<const void*>& Cycle) const;
+	};
+} // namespace OUU::Runtime
+
+	#define OUU_LOCK_ORDER_ACQUIRED(Lock)  OUU::Runtime::FLockOrderValidator::Get().OnLockAcquired(Lock)
+	#define OUU_LOCK_ORDER_RELEASED(Lock)  OUU::Runtime::FLockOrderValidator::Get().OnLockReleased(Lock)
+	#define OUU_LOCK_ORDER_DESTROYED(Lock) OUU::Runtime::FLockOrderValidator::Get().OnLockDestroyed(Lock)
+
+#else
+
+	#define OUU_LOCK_ORDER_ACQUIRED(Lock)
+	#define OUU_LOCK_ORDER_RELEASED(Lock)
+	#define OUU_LOCK_ORDER_DESTROYED(Lock)
+
+#endif
@@ -0,0 +1,131 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Internationalization/Regex.h"
+
+/**
+ * Set of string patterns that are all matched against a string at once.
+ *
+ * Exact, prefix, substring and glob patterns are compiled into a single shared automaton:
+ * Literal characters form a trie, so patterns with common prefixes (e.g. folder paths) share states, and glob
+ * wildcards are additional edges within the same trie. Matching runs the automaton once over the input string,
+ * so the cost mostly depends on the length of the string and not on the number of patterns.
+ *
+ * Regex patterns can't be merged without losing the information which of them matched, so they are compiled once
+ * when added and evaluated one after another.
+ *
+ * Adding patterns is not thread-safe. Matching is const and may be called from multiple threads at once.
+ */
+class OUURUNTIME_API FOUUPatternSet
+{
+public:
+	enum class EPatternType : uint8
+	{
+		/** The whole string must be equal to the pattern */
+		Exact,
+		/** The string must start with the pattern */
+		Prefix,
+		/** The string must contain the pattern */
+		Substring,
+		/**
+		 * The whole string must match the pattern, where * matches any sequence of characters and ? matches any single
+		 * character. Same semantics as FString::MatchesWildcard().
+		 */
+		Glob,
+		/** The regex must match a non-empty part of the string. Empty matches are ignored like in RegexUtils. */
+		Regex
+	};
+
+	explicit FOUUPatternSet(ESearchCase::Type InSearchCase = ESearchCase::CaseSensitive);
+
+	/** @returns the index of the new pattern that identifies it in match results */
+	int32 AddPattern(EPatternType Type, const FString& Pattern);
+
+	FORCEINLINE int32 AddExact(const FString& Pattern) { return AddPattern(EPatternType::Exact, Pattern); }
+	FORCEINLINE int32 AddPrefix(const FString& Pattern) { return AddPattern(EPatternType::Prefix, Pattern); }
+	FORCEINLINE int32 AddSubstring(const FString& Pattern) { return AddPattern(EPatternType::Substring, Pattern); }
+	FORCEINLINE int32 AddGlob(const FString& Pattern) { return AddPattern(EPatternType::Glob, Pattern); }
+	FORCEINLINE int32 AddRegex(const FString& Pattern) { return AddPattern(EPatternType::Regex, Pattern); }
+
+	/** @returns if at least one pattern matches the string. Stops at the first match. */
+	bool MatchesAny(FStringView String) const;
+
+	/**
+	 * Find all patterns that match the string.
+	 * @param	OutPatternIndices	Indices of all matching patterns in ascending order. Reset before matching.
+	 */
+	void MatchAll(FStringView String, TArray<int32>& OutPatternIndices) const;
+	TArray<int32> MatchAll(FStringView String) const;
+
+	FORCEINLINE int32 Num() const { return Patterns.Num(); }
+	FORCEINLINE bool IsEmpty() const { return Patterns.Num() == 0; }
+	FORCEINLINE EPatternType GetPatternType(int32 PatternIndex) const { return Patterns[PatternIndex].Type; }
+	FORCEINLINE const FString& GetPattern(int32 PatternIndex) const { return Patterns[PatternIndex].Pattern; }
+	FORCEINLINE ESearchCase::Type GetSearchCase() const { return SearchCase; }
+
+	/** @returns the number of states of the automaton. Mostly interesting for profiling. */
+	FORCEINLINE int32 NumStates() const { return Nodes.Num(); }
+
+	/** Remove all patterns. */
+	void Reset();
+
+private:
+	struct FPatternInfo
+	{
+		FString Pattern;
+		EPatternType Type;
+	};
+
+	struct FEdge
+	{
+		TCHAR Char;
+		int32 Node;
+	};
+
+	struct FNode
+	{
+		/** Literal character transitions sorted by character */
+		TArray<FEdge> LiteralEdges;
+		/** Transition for a ? wildcard */
+		int32 AnyCharEdge = INDEX_NONE;
+		/** Transition for a * wildcard. Taken without consuming a character. */
+		int32 AnyStringEdge = INDEX_NONE;
+		/** Nodes behind a * wildcard consume any character without changing the state */
+		bool bSelfLoop = false;
+
+		/** Patterns that match if the string ends in this state */
+		TArray<int32> FullMatchPatterns;
+		/** Patterns that match as soon as this state is reached, regardless of the remaining characters */
+		TArray<int32> PrefixMatchPatterns;
+
+		int32 FindLiteralEdge(TCHAR Char) const;
+		FORCEINLINE bool HasTransitions() const
+		{
+			return bSelfLoop || LiteralEdges.Num() > 0 || AnyCharEdge != INDEX_NONE || AnyStringEdge != INDEX_NONE;
+		}
+	};
+
+	ESearchCase::Type SearchCase;
+	TArray<FPatternInfo> Patterns;
+	/** Automaton for all non-regex patterns. Node 0 is the start state. */
+	TArray<FNode> Nodes;
+	/** Compiled regex patterns with their pattern indices */
+	TArray<TPair<int32, FRegexPattern>> RegexPatterns;
+
+	FORCEINLINE TCHAR FoldCase(TCHAR Char) const
+	{
+		return SearchCase == ESearchCase::IgnoreCase ? FChar::ToLower(Char) : Char;
+	}
+
+	void AddAutomatonPattern(EPatternType Type, const FString& Pattern, int32 PatternIndex);
+
+	/**
+	 * Report all matching patterns to the callback (possibly more than once) until the callback returns true.
+	 * @returns if the callback requested to stop
+	 */
+	template <typename CallbackType>
+	bool ForEachMatch(FStringView String, CallbackType&& Callback) const;
+};
@@ -2,13 +2,12 @@
 
 #pragma once
 
+#include "Internationalization/Regex.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Templates/StringUtils.h"
 
 #include "RegexUtils.generated.h"
 
-class FRegexMatcher;
-
 /** A single regex match */
 USTRUCT(BlueprintType)
 struct OUURUNTIME_API FRegexMatch
@@ -117,22 +116,183 @@ public:
 		int32 GroupCount,
 		const FString& TestString);
 
+	/** Replace the first match of the pattern with the literal replace string */
 	UFUNCTION(BlueprintPure, Category = "Open Unreal Utilities|Regex")
 	static FString ReplaceFirstRegexMatch(
 		const FString& RegexPattern,
 		const FString& InputString,
 		const FString& ReplaceString);
 
+	/** Replace all matches of the pattern with the literal replace string */
 	UFUNCTION(BlueprintPure, Category = "Open Unreal Utilities|Regex")
 	static FString ReplaceAllRegexMatches(
 		const FString& RegexPattern,
 		const FString& InputString,
 		const FString& ReplaceString);
+
+	/**
+	 * Replace all matches of the pattern with a replacement template that may reference capture groups:
+	 * $0-$99 or ${N} for numbered groups, ${name} for named groups (?<name>...) and $$ for a literal $.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Open Unreal Utilities|Regex")
+	static FString ReplaceAllRegexMatchesWithTemplate(
+		const FString& RegexPattern,
+		const FString& InputString,
+		const FString& ReplaceTemplate);
 };
 
 namespace OUU::Runtime
 {
 	using RegexUtils = URegexFunctionLibrary;
+
+	/**
+	 * Lazily evaluated range of all non-empty matches of a regex pattern in a string.
+	 * All matches are found with a single matcher, so iterating is linear in the input length.
+	 * Match strings are exposed as views into the input string, which must outlive the range.
+	 *
+	 * Example:
+	 *	for (const auto& Match : OUU::Runtime::RegexMatches(TEXT("(\\w+)=(\\d+)"), Input))
+	 *	{
+	 *		FStringView Key = Match.GetCaptureGroup(1);
+	 *	}
+	 */
+	class OUURUNTIME_API FRegexMatchRange
+	{
+	public:
+		/** Current match of the range. Only valid until the iterator is advanced. */
+		class OUURUNTIME_API FMatch
+		{
+		public:
+			int32 GetBeginning() const { return Beginning; }
+			int32 GetEnding() const { return Ending; }
+			FStringView GetView() const { return FStringView(*Range->Input + Beginning, Ending - Beginning); }
+
+			int32 GetCaptureGroupBeginning(int32 GroupIndex) const;
+			int32 GetCaptureGroupEnding(int32 GroupIndex) const;
+			/** @returns the capture group string or an empty view if the group did not participate in the match */
+			FStringView GetCaptureGroup(int32 GroupIndex) const;
+
+			/** Copy the match into a blueprint compatible match struct */
+			FRegexMatch ToRegexMatch() const;
+			/**
+			 * Copy the match and capture groups into a blueprint compatible struct.
+			 * @param	NumGroups	Number of groups including group 0 (the whole match)
+			 */
+			FRegexGroups ToRegexGroups(int32 NumGroups) const;
+
+		private:
+			friend FRegexMatchRange;
+			FRegexMatchRange* Range = nullptr;
+			int32 Beginning = INDEX_NONE;
+			int32 Ending = INDEX_NONE;
+		};
+
+		class OUURUNTIME_API FIterator
+		{
+		public:
+			explicit FIterator(FRegexMatchRange* InRange) : Range(InRange) {}
+
+			const FMatch& operator*() const { return Range->CurrentMatch; }
+			const FMatch* operator->() const { return &Range->CurrentMatch; }
+			FIterator& operator++();
+			bool operator!=(const FIterator& Other) const { return Range != Other.Range; }
+			bool operator==(const FIterator& Other) const { return Range == Other.Range; }
+
+		private:
+			// nullptr for end iterators and exhausted ranges
+			FRegexMatchRange* Range = nullptr;
+		};
+
+		FRegexMatchRange(const FRegexPattern& Pattern, const FString& InInput);
+		FRegexMatchRange(const FString& Pattern, const FString& InInput);
+		// Match views point into the input, so it must not be a temporary
+		FRegexMatchRange(const FRegexPattern& Pattern, FString&& InInput) = delete;
+		FRegexMatchRange(const FString& Pattern, FString&& InInput) = delete;
+
+		FRegexMatchRange(const FRegexMatchRange&) = delete;
+		FRegexMatchRange& operator=(const FRegexMatchRange&) = delete;
+
+		/** Begin iteration. The range can only be iterated once. */
+		FIterator begin();
+		FIterator end() { return FIterator(nullptr); }
+
+	private:
+		const FString& Input;
+		FRegexMatcher Matcher;
+		FMatch CurrentMatch;
+		bool bStarted = false;
+
+		/** Advance to the next non-empty match. @returns false if there are no more matches. */
+		bool FindNext();
+	};
+
+	/**
+	 * Regex replacement string that is parsed once and can be applied to many matches.
+	 * Supports $0-$99 or ${N} for numbered groups, ${name} for named groups (?<name>...) and $$ for a literal $.
+	 * A $ that is not followed by a valid group reference is kept as literal character.
+	 */
+	class OUURUNTIME_API FRegexReplaceTemplate
+	{
+	public:
+		/**
+		 * @param	Template	Replacement string with group references
+		 * @param	Pattern		Pattern string this template is used with. Only needed to resolve named groups.
+		 */
+		explicit FRegexReplaceTemplate(const FString& Template, const FString& Pattern = FString());
+
+		/** Create a template that inserts the string as-is without resolving group references */
+		static FRegexReplaceTemplate Literal(const FString& String);
+
+		/** Append the replacement for a match to the result string */
+		void AppendReplacement(const FRegexMatchRange::FMatch& Match, FString& OutResult) const;
+
+	private:
+		struct FSegment
+		{
+			FString Literal;
+			int32 GroupIndex = INDEX_NONE;
+		};
+
+		TArray<FSegment> Segments;
+
+		FRegexReplaceTemplate() = default;
+	};
+
+	using FRegexReplaceFunc = TFunctionRef<void(const FRegexMatchRange::FMatch& Match, FString& OutResult)>;
+
+	/**
+	 * Replace regex matches in a single pass over the input.
+	 * @param	MaxReplacements		Maximum number of matches to replace. Negative values replace all matches.
+	 */
+	OUURUNTIME_API FString RegexReplace(
+		const FString& Pattern,
+		const FString& Input,
+		const FRegexReplaceTemplate& Replacement,
+		int32 MaxReplacements = INDEX_NONE);
+
+	/**
+	 * Replace regex matches in a single pass over the input with computed replacements.
+	 * @param	AppendReplacement	Called for every match. Must append the replacement to the result string.
+	 * @param	MaxReplacements		Maximum number of matches to replace. Negative values replace all matches.
+	 */
+	OUURUNTIME_API FString RegexReplace(
+		const FString& Pattern,
+		const FString& Input,
+		FRegexReplaceFunc AppendReplacement,
+		int32 MaxReplacements = INDEX_NONE);
+
+	/** @returns a lazily evaluated range of all non-empty matches of the pattern in the input string */
+	FORCEINLINE FRegexMatchRange RegexMatches(const FString& Pattern, const FString& Input)
+	{
+		return FRegexMatchRange(Pattern, Input);
+	}
+	FORCEINLINE FRegexMatchRange RegexMatches(const FRegexPattern& Pattern, const FString& Input)
+	{
+		return FRegexMatchRange(Pattern, Input);
+	}
+	// Match views point into the input, so it must not be a temporary
+	FRegexMatchRange RegexMatches(const FString& Pattern, FString&& Input) = delete;
+	FRegexMatchRange RegexMatches(const FRegexPattern& Pattern, FString&& Input) = delete;
 } // namespace OUU::Runtime
 
 class UE_DEPRECATED(5.0, "FRegexUtils has been deprecated in favor of OUU::Runtime::RegexUtils.") FRegexUtils :
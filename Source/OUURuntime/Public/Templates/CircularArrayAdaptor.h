@@ -3,18 +3,36 @@
 #pragma once
 
 #include "Containers/Array.h"
+#include "Containers/ArrayView.h"
 #include "ReferenceWrapper.h"
 
-template <class ChildClass, typename ElementType, typename AllocatorType>
+/**
+ * Ring buffer on top of an array. Index 0 is always the oldest element.
+ * The elements are stored in at most two contiguous spans (see GetHeadSpan() and GetTailSpan()), which should be
+ * preferred over index based access for loops over all elements.
+ * Bounds checks of the per-element access are only performed in builds with DO_GUARD_SLOW.
+ * @tparam	bInPowerOfTwoCapacity	If true, the capacity must be a power of two, so ring indices can be wrapped with
+ *									a bit mask.
+ */
+template <class ChildClass, typename ElementType, typename AllocatorType, bool bInPowerOfTwoCapacity = false>
 class TCircularArrayAdaptor_Base
 {
 public:
 	using SizeType = typename AllocatorType::SizeType;
 	using ArrayType = TArray<ElementType, AllocatorType>;
 
+	static constexpr bool bPowerOfTwoCapacity = bInPowerOfTwoCapacity;
+
 	TCircularArrayAdaptor_Base(ArrayType& InArrayReference, SizeType InArrayMax) :
 		StorageReference(InArrayReference), ArrayMax(InArrayMax)
 	{
+		if constexpr (bPowerOfTwoCapacity)
+		{
+			checkf(
+				FMath::IsPowerOfTwo(InArrayMax),
+				TEXT("Capacity %i of power of two circular array is not a power of two"),
+				static_cast<int32>(InArrayMax));
+		}
 	}
 
 	TCircularArrayAdaptor_Base(const TCircularArrayAdaptor_Base& Other) :
@@ -43,9 +61,9 @@ public:
 			GetStorage().AddUninitialized(1);
 		}
 		ArrayType& ArrayReference = GetStorage();
-		check(ArrayReference.IsValidIndex(WriteIndex));
-		ArrayReference[WriteIndex] = Element;
-		WriteIndex = (WriteIndex + 1) % ArrayMax;
+		checkSlow(ArrayReference.IsValidIndex(WriteIndex));
+		ArrayReference.GetData()[WriteIndex] = Element;
+		WriteIndex = WrapStorageIndex(WriteIndex + 1);
 	}
 
 	SizeType Num() const { return GetStorage().Num(); }
@@ -72,10 +90,35 @@ public:
 
 	const ArrayType& GetStorage() const { return StorageReference.Get(); }
 
-	bool IsValidIndex(SizeType Index) { return GetStorage().IsValidIndex(GetWrappedRingIndex(Index)); }
+	bool IsValidIndex(SizeType Index) const { return Index >= 0 && Index < Num(); }
+
+	FORCEINLINE ElementType& operator[](SizeType Index) { return GetStorage().GetData()[GetWrappedRingIndex(Index)]; }
+	FORCEINLINE const ElementType& operator[](SizeType Index) const
+	{
+		return GetStorage().GetData()[GetWrappedRingIndex(Index)];
+	}
+
+	/** Contiguous elements from the oldest element up to the end of the storage. */
+	FORCEINLINE TArrayView<ElementType> GetHeadSpan()
+	{
+		const int32 OldestIndex = GetOldestStorageIndex();
+		return TArrayView<ElementType>(GetStorage().GetData() + OldestIndex, Num() - OldestIndex);
+	}
+	FORCEINLINE TArrayView<const ElementType> GetHeadSpan() const
+	{
+		const int32 OldestIndex = GetOldestStorageIndex();
+		return TArrayView<const ElementType>(GetStorage().GetData() + OldestIndex, Num() - OldestIndex);
+	}
 
-	ElementType& operator[](SizeType Index) { return GetStorage()[GetWrappedRingIndex(Index)]; }
-	const ElementType& operator[](SizeType Index) const { return GetStorage()[GetWrappedRingIndex(Index)]; }
+	/** Contiguous elements from the start of the storage up to the newest element. Empty until the ring wrapped. */
+	FORCEINLINE TArrayView<ElementType> GetTailSpan()
+	{
+		return TArrayView<ElementType>(GetStorage().GetData(), GetOldestStorageIndex());
+	}
+	FORCEINLINE TArrayView<const ElementType> GetTailSpan() const
+	{
+		return TArrayView<const ElementType>(GetStorage().GetData(), GetOldestStorageIndex());
+	}
 
 	void Reset()
 	{
@@ -83,14 +126,68 @@ public:
 		WriteIndex = 0;
 	}
 
+	/**
+	 * Iterates the head span and then the tail span without any index wrapping or bounds checks per element.
+	 * Bidirectional, so it can be used with ReverseRange().
+	 */
+	template <typename IteratedElementType>
+	class TSpanIterator
+	{
+	public:
+		TSpanIterator(TArrayView<IteratedElementType> Head, TArrayView<IteratedElementType> Tail, int32 InIndex) :
+			Ptr(InIndex < Head.Num() ? Head.GetData() + InIndex : Tail.GetData() + (InIndex - Head.Num())),
+			HeadEnd(Head.GetData() + Head.Num()), TailBegin(Tail.GetData()), HeadNum(Head.Num()), Index(InIndex)
+		{
+		}
+
+		FORCEINLINE IteratedElementType& operator*() const { return *Ptr; }
+		FORCEINLINE IteratedElementType* operator->() const { return Ptr; }
+
+		FORCEINLINE TSpanIterator& operator++()
+		{
+			++Index;
+			if (++Ptr == HeadEnd)
+			{
+				Ptr = TailBegin;
+			}
+			return *this;
+		}
+
+		FORCEINLINE TSpanIterator& operator--()
+		{
+			// Stepping back from the first tail element (or from end() if the tail is empty) re-enters the head span
+			if (Index-- == HeadNum)
+			{
+				Ptr = HeadEnd - 1;
+			}
+			else
+			{
+				--Ptr;
+			}
+			return *this;
+		}
+
+		FORCEINLINE int32 GetIndex() const { return Index; }
+
+		FORCEINLINE bool operator==(const TSpanIterator& Other) const { return Index == Other.Index; }
+		FORCEINLINE bool operator!=(const TSpanIterator& Other) const { return Index != Other.Index; }
+
+	private:
+		IteratedElementType* Ptr;
+		IteratedElementType* HeadEnd;
+		IteratedElementType* TailBegin;
+		int32 HeadNum;
+		int32 Index;
+	};
+
 	// Iterators
-	using TIterator = TIndexedContainerIterator<TCircularArrayAdaptor_Base, ElementType, SizeType>;
-	using TConstIterator = TIndexedContainerIterator<const TCircularArrayAdaptor_Base, const ElementType, SizeType>;
+	using TIterator = TSpanIterator<ElementType>;
+	using TConstIterator = TSpanIterator<const ElementType>;
 
-	FORCEINLINE TIterator begin() { return TIterator(*this, 0); }
-	FORCEINLINE TConstIterator begin() const { return TConstIterator(*this, 0); }
-	FORCEINLINE TIterator end() { return TIterator(*this, Num()); }
-	FORCEINLINE TConstIterator end() const { return TConstIterator(*this, Num()); }
+	FORCEINLINE TIterator begin() { return TIterator(GetHeadSpan(), GetTailSpan(), 0); }
+	FORCEINLINE TConstIterator begin() const { return TConstIterator(GetHeadSpan(), GetTailSpan(), 0); }
+	FORCEINLINE TIterator end() { return TIterator(GetHeadSpan(), GetTailSpan(), Num()); }
+	FORCEINLINE TConstIterator end() const { return TConstIterator(GetHeadSpan(), GetTailSpan(), Num()); }
 
 protected:
 	TReferenceWrapper<ArrayType> StorageReference;
@@ -99,39 +196,70 @@ protected:
 
 	bool IsPreWrap() const { return Num() < ArrayMax; }
 
-	int32 GetWrappedRingIndex(int32 Index) const
+	/** Storage index of the element with ring index 0 */
+	FORCEINLINE int32 GetOldestStorageIndex() const { return IsPreWrap() ? 0 : WriteIndex; }
+
+	/** Wrap a storage index in [0, 2 * ArrayMax) to [0, ArrayMax) */
+	FORCEINLINE int32 WrapStorageIndex(int32 StorageIndex) const
 	{
-		checkf(
+		if constexpr (bPowerOfTwoCapacity)
+		{
+			return StorageIndex & (ArrayMax - 1);
+		}
+		else
+		{
+			return (StorageIndex >= ArrayMax) ? (StorageIndex - ArrayMax) : StorageIndex;
+		}
+	}
+
+	FORCEINLINE int32 GetWrappedRingIndex(int32 Index) const
+	{
+		checkfSlow(
 			GetStorage().IsValidIndex(Index),
 			TEXT("%i is an invalid index for storage with size %i. "
 				 "You must stick to indices >= 0 and < Num just like with regular arrays!"),
 			Index,
 			Num());
-		const int32 RingIndex = (WriteIndex + Index);
-		const int32 WrappedRingIndex = (RingIndex >= Num()) ? (RingIndex - Num()) : RingIndex;
-		return WrappedRingIndex;
+		if constexpr (bPowerOfTwoCapacity)
+		{
+			return WrapStorageIndex(GetOldestStorageIndex() + Index);
+		}
+		else
+		{
+			const int32 RingIndex = (WriteIndex + Index);
+			const int32 WrappedRingIndex = (RingIndex >= Num()) ? (RingIndex - Num()) : RingIndex;
+			return WrappedRingIndex;
+		}
 	}
 };
 
-template <typename ElementType, typename AllocatorType = FDefaultAllocator>
+template <typename ElementType, typename AllocatorType = FDefaultAllocator, bool bPowerOfTwoCapacity = false>
 class TCircularArrayAdaptor :
-	public TCircularArrayAdaptor_Base<TCircularArrayAdaptor<ElementType, AllocatorType>, ElementType, AllocatorType>
+	public TCircularArrayAdaptor_Base<
+		TCircularArrayAdaptor<ElementType, AllocatorType, bPowerOfTwoCapacity>,
+		ElementType,
+		AllocatorType,
+		bPowerOfTwoCapacity>
 {
 public:
-	using SelfType = TCircularArrayAdaptor<ElementType, AllocatorType>;
-	using Super = TCircularArrayAdaptor_Base<SelfType, ElementType, AllocatorType>;
+	using SelfType = TCircularArrayAdaptor<ElementType, AllocatorType, bPowerOfTwoCapacity>;
+	using Super = TCircularArrayAdaptor_Base<SelfType, ElementType, AllocatorType, bPowerOfTwoCapacity>;
 	using ArrayType = typename Super::ArrayType;
 
 	TCircularArrayAdaptor(ArrayType& InArrayReference, int32 InArrayMax) : Super(InArrayReference, InArrayMax) {}
 };
 
-template <typename ElementType, typename AllocatorType = FDefaultAllocator>
+template <typename ElementType, typename AllocatorType = FDefaultAllocator, bool bPowerOfTwoCapacity = false>
 class TCircularArray :
-	public TCircularArrayAdaptor_Base<TCircularArray<ElementType, AllocatorType>, ElementType, AllocatorType>
+	public TCircularArrayAdaptor_Base<
+		TCircularArray<ElementType, AllocatorType, bPowerOfTwoCapacity>,
+		ElementType,
+		AllocatorType,
+		bPowerOfTwoCapacity>
 {
 public:
-	using SelfType = TCircularArray<ElementType, AllocatorType>;
-	using Super = TCircularArrayAdaptor_Base<SelfType, ElementType, AllocatorType>;
+	using SelfType = TCircularArray<ElementType, AllocatorType, bPowerOfTwoCapacity>;
+	using Super = TCircularArrayAdaptor_Base<SelfType, ElementType, AllocatorType, bPowerOfTwoCapacity>;
 	using ArrayType = typename Super::ArrayType;
 
 	TCircularArray() : Super(Storage, 32), Storage({}) { Super::StorageReference = Storage; }
@@ -166,3 +294,11 @@ public:
 private:
 	ArrayType Storage;
 };
+
+/** Circular array adaptor that wraps indices with a bit mask. The capacity must be a power of two. */
+template <typename ElementType, typename AllocatorType = FDefaultAllocator>
+using TCircularArrayAdaptor_Pow2 = TCircularArrayAdaptor<ElementType, AllocatorType, true>;
+
+/** Circular array that wraps indices with a bit mask. The capacity must be a power of two. */
+template <typename ElementType, typename AllocatorType = FDefaultAllocator>
+using TCircularArray_Pow2 = TCircularArray<ElementType, AllocatorType, true>;
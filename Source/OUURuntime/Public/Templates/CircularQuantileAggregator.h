@@ -0,0 +1,330 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/RandomStream.h"
+
+namespace OUU::Runtime::Private::CircularQuantileAggregator
+{
+	/** Nearest-rank index of a quantile in a sorted list of NumSamples elements */
+	FORCEINLINE int32 GetQuantileRank(double Quantile, int32 NumSamples)
+	{
+		return FMath::Clamp(FMath::CeilToInt(Quantile * NumSamples) - 1, 0, NumSamples - 1);
+	}
+} // namespace OUU::Runtime::Private::CircularQuantileAggregator
+
+/**
+ * Ring buffer that tracks order statistics (min/max/median/percentiles) of the last N samples.
+ * Useful e.g. for p50/p95/p99 frame times over the last X frames.
+ *
+ * Samples are kept in an order statistic tree (treap with subtree sizes) whose nodes are the slots of the ring, so
+ * adding a sample and evicting the oldest one are O(log N) and quantile lookups are O(log N) without sorting.
+ * Quantiles use the nearest-rank method, i.e. they always return one of the stored samples.
+ */
+template <typename InElementType>
+class TCircularQuantileAggregator
+{
+public:
+	using ElementType = InElementType;
+
+	explicit TCircularQuantileAggregator(int32 InMaxNum = 32) : MaxNum(InMaxNum)
+	{
+		check(MaxNum > 0);
+		Nodes.Reserve(MaxNum);
+	}
+
+	void Add(ElementType Element)
+	{
+		const int32 Slot = WriteIndex;
+		if (Nodes.Num() < MaxNum)
+		{
+			Nodes.AddDefaulted();
+		}
+		else
+		{
+			Root = Erase(Root, Slot);
+		}
+
+		FNode& Node = Nodes[Slot];
+		Node.Value = Element;
+		Node.Priority = RandomStream.GetUnsignedInt();
+		Node.Left = INDEX_NONE;
+		Node.Right = INDEX_NONE;
+		Node.Size = 1;
+
+		int32 Lower, Upper;
+		Split(Root, Slot, OUT Lower, OUT Upper);
+		Root = Merge(Merge(Lower, Slot), Upper);
+
+		WriteIndex = (WriteIndex + 1 >= MaxNum) ? 0 : WriteIndex + 1;
+	}
+
+	FORCEINLINE int32 Num() const { return Nodes.Num(); }
+	FORCEINLINE int32 GetMaxNum() const { return MaxNum; }
+	FORCEINLINE bool HasData() const { return Nodes.Num() > 0; }
+
+	ElementType Last() const
+	{
+		check(HasData());
+		return Nodes[(WriteIndex == 0 ? Nodes.Num() : WriteIndex) - 1].Value;
+	}
+
+	ElementType Oldest() const
+	{
+		check(HasData());
+		return Nodes[Nodes.Num() < MaxNum ? 0 : WriteIndex].Value;
+	}
+
+	/** @returns the K-th smallest sample (0 = min) */
+	ElementType GetKthSmallest(int32 K) const
+	{
+		check(K >= 0 && K < Num());
+		int32 Current = Root;
+		while (true)
+		{
+			const FNode& Node = Nodes[Current];
+			const int32 LeftSize = GetSize(Node.Left);
+			if (K < LeftSize)
+			{
+				Current = Node.Left;
+			}
+			else if (K == LeftSize)
+			{
+				return Node.Value;
+			}
+			else
+			{
+				K -= LeftSize + 1;
+				Current = Node.Right;
+			}
+		}
+	}
+
+	/** @returns the nearest-rank quantile for InQuantile in [0, 1] (e.g. 0.95 for p95) or 0 if there is no data. */
+	ElementType Quantile(double InQuantile) const
+	{
+		if (!HasData())
+			return 0;
+		return GetKthSmallest(OUU::Runtime::Private::CircularQuantileAggregator::GetQuantileRank(InQuantile, Num()));
+	}
+
+	ElementType Median() const { return Quantile(0.5); }
+	ElementType Min() const { return HasData() ? GetKthSmallest(0) : 0; }
+	ElementType Max() const { return HasData() ? GetKthSmallest(Num() - 1) : 0; }
+
+	void Reset()
+	{
+		Nodes.Reset();
+		Root = INDEX_NONE;
+		WriteIndex = 0;
+	}
+
+private:
+	struct FNode
+	{
+		ElementType Value = {};
+		uint32 Priority = 0;
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+		int32 Size = 1;
+	};
+
+	/** Tree nodes. The node index is the slot of the sample in the ring. */
+	TArray<FNode> Nodes;
+	int32 Root = INDEX_NONE;
+	int32 WriteIndex = 0;
+	int32 MaxNum = 0;
+	FRandomStream RandomStream{0x5EED};
+
+	FORCEINLINE int32 GetSize(int32 NodeIndex) const { return NodeIndex == INDEX_NONE ? 0 : Nodes[NodeIndex].Size; }
+
+	FORCEINLINE void UpdateSize(int32 NodeIndex)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		Node.Size = 1 + GetSize(Node.Left) + GetSize(Node.Right);
+	}
+
+	/** Samples are ordered by value. Equal values are ordered by slot, so every node has a unique key. */
+	FORCEINLINE bool IsLess(int32 A, int32 B) const
+	{
+		const ElementType& ValueA = Nodes[A].Value;
+		const ElementType& ValueB = Nodes[B].Value;
+		return ValueA < ValueB || (!(ValueB < ValueA) && A < B);
+	}
+
+	/** Split the subtree into nodes that are less than the key node and all others */
+	void Split(int32 Tree, int32 KeyNode, int32& OutLower, int32& OutUpper)
+	{
+		if (Tree == INDEX_NONE)
+		{
+			OutLower = INDEX_NONE;
+			OutUpper = INDEX_NONE;
+			return;
+		}
+		FNode& Node = Nodes[Tree];
+		if (IsLess(Tree, KeyNode))
+		{
+			Split(Node.Right, KeyNode, OUT Node.Right, OUT OutUpper);
+			OutLower = Tree;
+		}
+		else
+		{
+			Split(Node.Left, KeyNode, OUT OutLower, OUT Node.Left);
+			OutUpper = Tree;
+		}
+		UpdateSize(Tree);
+	}
+
+	/** Merge two subtrees. All nodes of Lower must be less than all nodes of Upper. */
+	int32 Merge(int32 Lower, int32 Upper)
+	{
+		if (Lower == INDEX_NONE)
+			return Upper;
+		if (Upper == INDEX_NONE)
+			return Lower;
+
+		if (Nodes[Lower].Priority > Nodes[Upper].Priority)
+		{
+			Nodes[Lower].Right = Merge(Nodes[Lower].Right, Upper);
+			UpdateSize(Lower);
+			return Lower;
+		}
+		Nodes[Upper].Left = Merge(Lower, Nodes[Upper].Left);
+		UpdateSize(Upper);
+		return Upper;
+	}
+
+	/** Remove the key node from the subtree and return the new subtree root */
+	int32 Erase(int32 Tree, int32 KeyNode)
+	{
+		check(Tree != INDEX_NONE);
+		if (Tree == KeyNode)
+			return Merge(Nodes[Tree].Left, Nodes[Tree].Right);
+
+		if (IsLess(KeyNode, Tree))
+		{
+			Nodes[Tree].Left = Erase(Nodes[Tree].Left, KeyNode);
+		}
+		else
+		{
+			Nodes[Tree].Right = Erase(Nodes[Tree].Right, KeyNode);
+		}
+		UpdateSize(Tree);
+		return Tree;
+	}
+};
+
+/**
+ * Ring buffer that sorts the last N samples into fixed-size buckets between a min and max value.
+ * Adding a sample is O(1), quantile estimates are O(NumBuckets) and accurate up to the bucket width for samples inside
+ * the value range. Samples outside of the range are counted in separate underflow/overflow buckets.
+ */
+template <typename InElementType>
+class TCircularHistogramAggregator
+{
+public:
+	using ElementType = InElementType;
+
+	TCircularHistogramAggregator(int32 InMaxNum, ElementType InMinValue, ElementType InMaxValue, int32 InNumBuckets) :
+		MaxNum(InMaxNum), MinValue(InMinValue), MaxValue(InMaxValue), NumBuckets(InNumBuckets)
+	{
+		check(MaxNum > 0 && NumBuckets > 0 && MinValue < MaxValue);
+		BucketWidth = (static_cast<double>(MaxValue) - static_cast<double>(MinValue)) / NumBuckets;
+		// First and last entry are the underflow and overflow buckets
+		BucketCounts.SetNumZeroed(NumBuckets + 2);
+		SampleBuckets.Reserve(MaxNum);
+	}
+
+	void Add(ElementType Element)
+	{
+		const int32 Bucket = GetStorageBucket(Element);
+		if (SampleBuckets.Num() < MaxNum)
+		{
+			SampleBuckets.Add(Bucket);
+		}
+		else
+		{
+			BucketCounts[SampleBuckets[WriteIndex]]--;
+			SampleBuckets[WriteIndex] = Bucket;
+		}
+		BucketCounts[Bucket]++;
+		WriteIndex = (WriteIndex + 1 >= MaxNum) ? 0 : WriteIndex + 1;
+	}
+
+	FORCEINLINE int32 Num() const { return SampleBuckets.Num(); }
+	FORCEINLINE int32 GetMaxNum() const { return MaxNum; }
+	FORCEINLINE bool HasData() const { return SampleBuckets.Num() > 0; }
+
+	FORCEINLINE int32 GetNumBuckets() const { return NumBuckets; }
+	FORCEINLINE double GetBucketWidth() const { return BucketWidth; }
+	FORCEINLINE int32 GetBucketCount(int32 BucketIndex) const { return BucketCounts[BucketIndex + 1]; }
+	FORCEINLINE int32 GetUnderflowCount() const { return BucketCounts[0]; }
+	FORCEINLINE int32 GetOverflowCount() const { return BucketCounts.Last(); }
+
+	ElementType GetBucketLowerBound(int32 BucketIndex) const
+	{
+		return static_cast<ElementType>(static_cast<double>(MinValue) + BucketIndex * BucketWidth);
+	}
+
+	/**
+	 * @returns an estimate of the nearest-rank quantile for InQuantile in [0, 1] interpolated within the bucket that
+	 * contains the sample, MinValue/MaxValue for samples outside of the range or 0 if there is no data.
+	 */
+	ElementType Quantile(double InQuantile) const
+	{
+		if (!HasData())
+			return 0;
+
+		const int32 Rank = OUU::Runtime::Private::CircularQuantileAggregator::GetQuantileRank(InQuantile, Num());
+		int32 NumBefore = 0;
+		for (int32 StorageBucket = 0; StorageBucket < BucketCounts.Num(); StorageBucket++)
+		{
+			const int32 Count = BucketCounts[StorageBucket];
+			if (Rank < NumBefore + Count)
+			{
+				if (StorageBucket == 0)
+					return MinValue;
+				if (StorageBucket == BucketCounts.Num() - 1)
+					return MaxValue;
+
+				const double Alpha = (Rank - NumBefore + 0.5) / Count;
+				return static_cast<ElementType>(
+					static_cast<double>(MinValue) + (StorageBucket - 1 + Alpha) * BucketWidth);
+			}
+			NumBefore += Count;
+		}
+		return MaxValue;
+	}
+
+	ElementType Median() const { return Quantile(0.5); }
+
+	void Reset()
+	{
+		SampleBuckets.Reset();
+		FMemory::Memzero(BucketCounts.GetData(), BucketCounts.Num() * sizeof(int32));
+		WriteIndex = 0;
+	}
+
+private:
+	/** Bucket index of every sample in the ring */
+	TArray<int32> SampleBuckets;
+	/** Number of samples per bucket including the underflow and overflow buckets */
+	TArray<int32> BucketCounts;
+	int32 WriteIndex = 0;
+	int32 MaxNum = 0;
+	ElementType MinValue;
+	ElementType MaxValue;
+	int32 NumBuckets = 0;
+	double BucketWidth = 0.0;
+
+	FORCEINLINE int32 GetStorageBucket(ElementType Element) const
+	{
+		if (Element < MinValue)
+			return 0;
+		if (!(Element < MaxValue))
+			return NumBuckets + 1;
+		const int32 Bucket = static_cast<int32>((static_cast<double>(Element) - MinValue) / BucketWidth);
+		return FMath::Min(Bucket, NumBuckets - 1) + 1;
+	}
+};
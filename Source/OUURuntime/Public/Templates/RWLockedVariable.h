@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Misc/LockOrderValidator.h"
 #include "Misc/ScopeRWLock.h"
 #include "Traits/ConditionalType.h"
 
@@ -11,6 +12,14 @@
  */
 class FRWLockedVariable_Base
 {
+public:
+#if OUU_WITH_LOCK_ORDER_VALIDATION
+	~FRWLockedVariable_Base() { OUU_LOCK_ORDER_DESTROYED(&Lock); }
+#endif
+
+	/** The lock guarding the variable. Its address identifies the variable in FLockOrderValidator. */
+	FORCEINLINE const FRWLock& GetLock() const { return Lock; }
+
 protected:
 	template <typename...>
 	friend class TScopedMultiRWLock;
@@ -89,8 +98,26 @@ public:
 	friend class TRWLockedVariable;
 
 	TScopedRWLockedVariableRef(TScopedRWLockedVariableRef&& Other) noexcept :
-		VariableRef(Other.VariableRef), Lock(Other.Lock), LockType(Other.LockType)
+		VariableRef(Other.VariableRef), Lock(Other.Lock)
 	{
+		// The lock is released by the new owner
+		Other.Lock = nullptr;
+	}
+
+	~TScopedRWLockedVariableRef()
+	{
+		if (!Lock)
+			return;
+
+		if constexpr (bIsWriteLock)
+		{
+			Lock->WriteUnlock();
+		}
+		else
+		{
+			Lock->ReadUnlock();
+		}
+		OUU_LOCK_ORDER_RELEASED(Lock);
 	}
 
 	VariableType& Get() const { return VariableRef; }
@@ -153,19 +180,24 @@ public:
 	bool operator>(const VariableType& OtherVariableValueRef) const { return Get() > OtherVariableValueRef; }
 
 private:
-	TScopedRWLockedVariableRef(VariableType& InVariableRef, FRWLock& InLock) :
-		VariableRef(InVariableRef), Lock(InLock), LockType()
+	TScopedRWLockedVariableRef(VariableType& InVariableRef, FRWLock& InLock) : VariableRef(InVariableRef), Lock(&InLock)
 	{
+		OUU_LOCK_ORDER_ACQUIRED(Lock);
+		if constexpr (bIsWriteLock)
+		{
+			Lock->WriteLock();
+		}
+		else
+		{
+			Lock->ReadLock();
+		}
 	}
 
 	// Reference to the variable value
 	VariableType& VariableRef;
 
-	// Reference to the lock
-	FRWLock& Lock;
-
-	// LockType for RWScopeLocks
-	FRWScopeLockType LockType;
+	// The held lock. Null after the lock ownership was moved to another reference.
+	FRWLock* Lock;
 };
 
 #undef ASSERT_CONST_REF_CANT
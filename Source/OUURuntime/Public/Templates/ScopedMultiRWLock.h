@@ -6,6 +6,7 @@
 
 // ReSharper disable once CppUnusedIncludeDirective
 #include "Misc/EngineVersionComparison.h"
+#include "Misc/LockOrderValidator.h"
 #include "Templates/RWLockedVariable.h"
 #include "Traits/ConditionalType.h"
 
@@ -129,16 +130,15 @@ public:
 		// Add pointers to the locks to the array
 		VisitTupleElements([&](FScopedMultiRWLockRef_Base& LockRef) { LockPointers.Add(&LockRef); }, LockReferences);
 
-		// Sort locks by memory address
+		// Sort locks by memory address of the locks (not of the references, which would keep the argument order)
 		LockPointers.Sort([](const FScopedMultiRWLockRef_Base& Left, const FScopedMultiRWLockRef_Base& Right) -> bool {
-			const FScopedMultiRWLockRef_Base* LeftPtr = &Left;
-			const FScopedMultiRWLockRef_Base* RightPtr = &Right;
-			return LeftPtr < RightPtr;
+			return &Left.RWLockVariable_Base_Ref.Lock < &Right.RWLockVariable_Base_Ref.Lock;
 		});
 
 		// Go through all sorted locks and acquire the appropriate lock
 		for (const FScopedMultiRWLockRef_Base* LockRef : LockPointers)
 		{
+			OUU_LOCK_ORDER_ACQUIRED(&LockRef->RWLockVariable_Base_Ref.Lock);
 			if (LockRef->bIsWriteLock)
 			{
 				LockRef->RWLockVariable_Base_Ref.Lock.WriteLock();
@@ -163,6 +163,7 @@ public:
 			{
 				LockRef->RWLockVariable_Base_Ref.Lock.ReadUnlock();
 			}
+			OUU_LOCK_ORDER_RELEASED(&LockRef->RWLockVariable_Base_Ref.Lock);
 		}
 	}
 
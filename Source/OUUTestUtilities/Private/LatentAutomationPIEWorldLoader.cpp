@@ -5,6 +5,7 @@
 #if WITH_AUTOMATION_WORKER
 	#include "Engine/Engine.h"
 	#include "Engine/World.h"
+	#include "EngineUtils.h"
 	#include "GameFramework/GameStateBase.h"
 	#include "LogOpenUnrealUtilities.h"
 	#include "Misc/PackageName.h"
@@ -41,6 +42,62 @@ namespace OUU::TestUtilities
 			return TestWorld;
 		}
 
+		/** PIE session that is reused by all loaders with a shared session */
+		struct FSharedPIESession
+		{
+			FString MapName;
+			TWeakObjectPtr<UWorld> World;
+			/** Actors (and their classes) that existed after the map was loaded */
+			TMap<TWeakObjectPtr<AActor>, const UClass*> BaselineActors;
+			FDelegateHandle PostTestingHandle;
+		};
+
+		FSharedPIESession& GetSharedSession()
+		{
+			static FSharedPIESession SharedSession;
+			return SharedSession;
+		}
+
+		/**
+		 * Compare the surviving actors against the baseline actors.
+		 * @returns a description of all actor count changes per class or an empty string if the world is unchanged
+		 */
+		FString DescribeWorldPollution(UWorld& World, const FSharedPIESession& SharedSession)
+		{
+			TMap<const UClass*, int32> ClassCountDeltas;
+			int32 NumSurvivingBaselineActors = 0;
+			for (TActorIterator<AActor> It(&World); It; ++It)
+			{
+				if (SharedSession.BaselineActors.Contains(*It))
+				{
+					NumSurvivingBaselineActors++;
+				}
+				else
+				{
+					ClassCountDeltas.FindOrAdd(It->GetClass())++;
+				}
+			}
+			if (NumSurvivingBaselineActors != SharedSession.BaselineActors.Num())
+			{
+				for (const auto& BaselineEntry : SharedSession.BaselineActors)
+				{
+					if (!IsValid(BaselineEntry.Key.Get()))
+					{
+						ClassCountDeltas.FindOrAdd(BaselineEntry.Value)--;
+					}
+				}
+			}
+
+			FString Result;
+			for (const auto& DeltaEntry : ClassCountDeltas)
+			{
+				if (DeltaEntry.Value != 0)
+				{
+					Result += FString::Printf(TEXT(" %+i %s"), DeltaEntry.Value, *GetNameSafe(DeltaEntry.Key));
+				}
+			}
+			return Result;
+		}
 	} // namespace Private
 
 	FLatentAutomationPIEWorldLoader::FLatentAutomationPIEWorldLoader(
@@ -63,6 +120,13 @@ namespace OUU::TestUtilities
 			MapLoadedDelegate.Unbind();
 		}
 
+		bLastLoadShared = bUseSharedSession && TryResetSharedSession();
+		if (bLastLoadShared)
+		{
+			Done.Execute();
+			return;
+		}
+
 		AutomationOpenMap(MapName, true /* force reload */);
 		MapLoadedDelegate = Done;
 
@@ -80,6 +144,9 @@ namespace OUU::TestUtilities
 	// ReSharper disable once CppMemberFunctionMayBeStatic
 	void FLatentAutomationPIEWorldLoader::ClosePIE()
 	{
+		if (bUseSharedSession)
+			return;
+
 	#if WITH_EDITOR
 		if (GUnrealEd)
 		{
@@ -88,6 +155,33 @@ namespace OUU::TestUtilities
 	#endif
 	}
 
+	void FLatentAutomationPIEWorldLoader::SetUseSharedSession(bool bInUseSharedSession)
+	{
+		bUseSharedSession = bInUseSharedSession;
+	}
+
+	void FLatentAutomationPIEWorldLoader::AddResetHook(FResetHook ResetHook) { ResetHooks.Add(MoveTemp(ResetHook)); }
+
+	void FLatentAutomationPIEWorldLoader::ClearResetHooks() { ResetHooks.Empty(); }
+
+	void FLatentAutomationPIEWorldLoader::CloseSharedSession()
+	{
+		auto& SharedSession = Private::GetSharedSession();
+		const bool bWasOpen = SharedSession.World.IsValid() && SharedSession.World == Private::GetAnyGameWorld();
+		if (SharedSession.PostTestingHandle.IsValid())
+		{
+			FAutomationTestFramework::Get().PostTestingEvent.Remove(SharedSession.PostTestingHandle);
+		}
+		SharedSession = Private::FSharedPIESession();
+
+	#if WITH_EDITOR
+		if (bWasOpen && GUnrealEd)
+		{
+			GUnrealEd->RequestEndPlayMap();
+		}
+	#endif
+	}
+
 	bool FLatentAutomationPIEWorldLoader::IsGameStartComplete() const
 	{
 		const UWorld* TestWorld = GetLoadedWorld();
@@ -124,6 +218,10 @@ namespace OUU::TestUtilities
 						// Ignore all errors that occured during map load up to this point
 						OwningSpec.ClearExecutionInfo();
 					}
+					if (bUseSharedSession)
+					{
+						StartSharedSession();
+					}
 					MapLoadedDelegate.Execute();
 					MapLoadedDelegate.Unbind();
 					return;
@@ -138,6 +236,76 @@ namespace OUU::TestUtilities
 			MapLoadedDelegate.Unbind();
 		}
 	}
+
+	bool FLatentAutomationPIEWorldLoader::TryResetSharedSession()
+	{
+		auto& SharedSession = Private::GetSharedSession();
+		UWorld* World = GetLoadedWorld();
+		if (SharedSession.MapName != MapName || !World || SharedSession.World != World || !IsGameStartComplete())
+			return false;
+
+		// Destroy all actors that were spawned by previous tests
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (!SharedSession.BaselineActors.Contains(*It))
+			{
+				It->Destroy();
+			}
+		}
+
+		for (const FResetHook& ResetHook : ResetHooks)
+		{
+			if (!ResetHook(*World))
+			{
+				UE_LOG(
+					LogOpenUnrealUtilities,
+					Warning,
+					TEXT("Failed to reset shared PIE world %s. Loading the map again."),
+					*World->GetName());
+				return false;
+			}
+		}
+
+		// Only actors that could not be destroyed, destroyed baseline actors and actors spawned by reset hooks remain
+
+		const FString WorldPollution = Private::DescribeWorldPollution(*World, SharedSession);
+		if (!WorldPollution.IsEmpty())
+		{
+			UE_LOG(
+				LogOpenUnrealUtilities,
+				Warning,
+				TEXT("Shared PIE world %s is polluted after reset (actor count changes per class:%s). "
+					 "Loading the map again."),
+				*World->GetName(),
+				*WorldPollution);
+			return false;
+		}
+
+		return true;
+	}
+
+	void FLatentAutomationPIEWorldLoader::StartSharedSession()
+	{
+		UWorld* World = GetLoadedWorld();
+		if (!World)
+			return;
+
+		auto& SharedSession = Private::GetSharedSession();
+		SharedSession.MapName = MapName;
+		SharedSession.World = World;
+		SharedSession.BaselineActors.Reset();
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			SharedSession.BaselineActors.Add(*It, It->GetClass());
+		}
+
+		if (!SharedSession.PostTestingHandle.IsValid())
+		{
+			// Close the shared session together with the test run
+			SharedSession.PostTestingHandle = FAutomationTestFramework::Get().PostTestingEvent.AddStatic(
+				&FLatentAutomationPIEWorldLoader::CloseSharedSession);
+		}
+	}
 } // namespace OUU::TestUtilities
 
 #endif
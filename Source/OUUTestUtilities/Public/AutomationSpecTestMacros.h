@@ -29,4 +29,6 @@
 #define SPEC_TEST_NOT_NULL(Actual)                             TestNotNull(TEXT(PREPROCESSOR_TO_STRING(Actual)), Actual)
 #define SPEC_TEST_ARRAYS_EQUAL(Actual, Expected)               TestArraysEqual(*this, TEXT(PREPROCESSOR_TO_STRING(Actual vs Expected)), Actual, Expected)
 #define SPEC_TEST_ARRAYS_MATCH_UNORDERED(Actual, Expected)     TestUnorderedArraysMatch(*this, TEXT(PREPROCESSOR_TO_STRING(Actual vs Expected)), Actual, Expected)
+#define SPEC_TEST_SETS_EQUAL(Actual, Expected)                 TestSetsEqual(*this, TEXT(PREPROCESSOR_TO_STRING(Actual vs Expected)), Actual, Expected)
+#define SPEC_TEST_MAPS_EQUAL(Actual, Expected)                 TestMapsEqual(*this, TEXT(PREPROCESSOR_TO_STRING(Actual vs Expected)), Actual, Expected)
 // clang-format on
@@ -7,8 +7,11 @@
 
 #if WITH_AUTOMATION_WORKER
 
+	#include "Async/ParallelFor.h"
 	#include "LogOpenUnrealUtilities.h"
+	#include "OUUTestMacros.h"
 	#include "Templates/IsEnumClass.h"
+	#include "Templates/StringUtils.h"
 	#include "Templates/UnrealTypeTraits.h"
 
 namespace OUU::TestUtilities::Private
@@ -63,6 +66,23 @@ namespace OUU::TestUtilities::Private
 		Result.InitFromString(s);
 		return Result;
 	}
+
+	/** String representation of a parameter value for test names. Enum classes without LexToString use integers. */
+	template <typename T>
+	FString ParameterValueToString(const T& Value)
+	{
+		static_assert(
+			TModels<CLexToStringConvertible, T>::Value || TIsEnumClass<T>::Value,
+			"Parameter values must be string convertible with LexToString()");
+		if constexpr (TModels<CLexToStringConvertible, T>::Value)
+		{
+			return LexToString(Value);
+		}
+		else
+		{
+			return LexToString(static_cast<int64>(Value));
+		}
+	}
 } // namespace OUU::TestUtilities::Private
 
 /**
@@ -138,4 +158,178 @@ public:
 	}
 };
 
+/**
+ * Named list of values for one parameter of a TAutomationTestParameterMatrix.
+ */
+template <typename InValueType>
+struct TAutomationTestParameterAxis
+{
+	using ValueType = InValueType;
+
+	FString Name;
+	TArray<ValueType> Values;
+	/** String representations of the values used for test names */
+	TArray<FString> ValueStrings;
+
+	TAutomationTestParameterAxis(const FString& InName, TArray<ValueType> InValues) :
+		Name(InName), Values(MoveTemp(InValues))
+	{
+		ValueStrings.Reserve(Values.Num());
+		for (const ValueType& Value : Values)
+		{
+			ValueStrings.Add(OUU::TestUtilities::Private::ParameterValueToString(Value));
+		}
+	}
+
+	/** Parse the values once from a delimited string, e.g. "8;64;512". The value strings are used for test names. */
+	static TAutomationTestParameterAxis FromString(
+		const FString& InName,
+		const FString& InValuesString,
+		const FString& InDelimiter = TEXT(";"))
+	{
+		TAutomationTestParameterAxis Result(InName, {});
+		InValuesString.ParseIntoArray(Result.ValueStrings, *InDelimiter);
+		Result.Values.Reserve(Result.ValueStrings.Num());
+		for (const FString& ValueString : Result.ValueStrings)
+		{
+			Result.Values.Add(OUU::TestUtilities::Private::ParseValue<ValueType>(ValueString));
+		}
+		return Result;
+	}
+};
+
+/**
+ * Cartesian product of typed parameter lists for data driven automation tests.
+ * All combinations, their test names and a lookup from test command to combination are built once on construction,
+ * so tests do not have to parse parameter strings for every test run.
+ *
+ * Test names consist of the axis names and value strings, e.g. "PoolSize=64 SpawnRate=10", and stay stable as long
+ * as the axes do not change. The test names double as test commands.
+ *
+ * Usage in complex automation tests (one test instance per combination):
+ *	static const auto& GetPoolMatrix()
+ *	{
+ *		static const auto Matrix = MakeAutomationTestParameterMatrix(
+ *			TAutomationTestParameterAxis<int32>(TEXT("PoolSize"), {8, 64, 512}),
+ *			TAutomationTestParameterAxis<int32>(TEXT("SpawnRate"), {1, 10}));
+ *		return Matrix;
+ *	}
+ *	OUU_IMPLEMENT_COMPLEX_AUTOMATION_TEST_BEGIN(PoolPerformance, DEFAULT_OUU_TEST_FLAGS)
+ *	OUU_COMPLEX_AUTOMATION_TESTCASE_MATRIX(GetPoolMatrix())
+ *	OUU_IMPLEMENT_COMPLEX_AUTOMATION_TEST_END(PoolPerformance)
+ *	{
+ *		const auto* Combination = GetPoolMatrix().FindCombination(Parameters);
+ *		...
+ *	}
+ *
+ * Alternatively ForEach() runs all combinations in a single test, optionally in parallel.
+ */
+template <typename... ParameterTypes>
+class TAutomationTestParameterMatrix
+{
+public:
+	using FCombination = TTuple<ParameterTypes...>;
+	static constexpr int32 NumAxes = sizeof...(ParameterTypes);
+	static_assert(NumAxes > 0, "A parameter matrix requires at least one axis");
+
+	explicit TAutomationTestParameterMatrix(const TAutomationTestParameterAxis<ParameterTypes>&... Axes)
+	{
+		Build(TMakeIntegerSequence<uint32, NumAxes>(), Axes...);
+	}
+
+	FORCEINLINE int32 Num() const { return Combinations.Num(); }
+
+	FORCEINLINE const FCombination& GetCombination(int32 CombinationIndex) const
+	{
+		return Combinations[CombinationIndex];
+	}
+
+	FORCEINLINE const FString& GetTestName(int32 CombinationIndex) const { return TestNames[CombinationIndex]; }
+
+	/** @returns the combination of a test command created by GetTests() or nullptr */
+	const FCombination* FindCombination(const FString& TestCommand) const
+	{
+		const int32* CombinationIndex = TestCommandIndices.Find(TestCommand);
+		if (!CombinationIndex)
+		{
+			UE_LOG(
+				LogOpenUnrealUtilities,
+				Error,
+				TEXT("Test command '%s' is not part of the parameter matrix"),
+				*TestCommand);
+			return nullptr;
+		}
+		return &Combinations[*CombinationIndex];
+	}
+
+	/** Add all combinations as test cases of a complex automation test */
+	void GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+	{
+		OutBeautifiedNames.Append(TestNames);
+		OutTestCommands.Append(TestNames);
+	}
+
+	/**
+	 * Call Func(CombinationIndex, Parameters...) for every combination.
+	 * If the test is thread-safe, independent combinations run concurrently on worker threads. In that case Func must
+	 * not report to the automation test directly, but store its results (e.g. indexed by CombinationIndex), so they
+	 * can be checked on the calling thread afterwards.
+	 */
+	template <typename FuncType>
+	void ForEach(FuncType&& Func, bool bThreadSafe = false) const
+	{
+		ParallelFor(
+			Combinations.Num(),
+			[&](int32 CombinationIndex) { Combinations[CombinationIndex].ApplyAfter(Func, CombinationIndex); },
+			bThreadSafe ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	}
+
+private:
+	TArray<FCombination> Combinations;
+	TArray<FString> TestNames;
+	TMap<FString, int32> TestCommandIndices;
+
+	template <uint32... AxisIndices>
+	void Build(TIntegerSequence<uint32, AxisIndices...>, const TAutomationTestParameterAxis<ParameterTypes>&... Axes)
+	{
+		const int32 AxisSizes[] = {Axes.Values.Num()...};
+		int32 NumCombinations = 1;
+		for (const int32 AxisSize : AxisSizes)
+		{
+			NumCombinations *= AxisSize;
+		}
+
+		Combinations.Reserve(NumCombinations);
+		TestNames.Reserve(NumCombinations);
+		TestCommandIndices.Reserve(NumCombinations);
+		for (int32 CombinationIndex = 0; CombinationIndex < NumCombinations; CombinationIndex++)
+		{
+			// The last axis changes fastest
+			int32 ValueIndices[NumAxes];
+			int32 Remainder = CombinationIndex;
+			for (int32 Axis = NumAxes - 1; Axis >= 0; Axis--)
+			{
+				ValueIndices[Axis] = Remainder % AxisSizes[Axis];
+				Remainder /= AxisSizes[Axis];
+			}
+
+			Combinations.Emplace(Axes.Values[ValueIndices[AxisIndices]]...);
+
+			const TArray<FString> NameParts = {
+				FString::Printf(TEXT("%s=%s"), *Axes.Name, *Axes.ValueStrings[ValueIndices[AxisIndices]])...};
+			// Dots would create sub-categories in the test hierarchy
+			FString TestName = EscapeTestName(FString::Join(NameParts, TEXT(" ")));
+			TestCommandIndices.Add(TestName, CombinationIndex);
+			TestNames.Add(MoveTemp(TestName));
+		}
+	}
+};
+
+template <typename... ParameterTypes>
+TAutomationTestParameterMatrix<ParameterTypes...> MakeAutomationTestParameterMatrix(
+	const TAutomationTestParameterAxis<ParameterTypes>&... Axes)
+{
+	return TAutomationTestParameterMatrix<ParameterTypes...>(Axes...);
+}
+
 #endif
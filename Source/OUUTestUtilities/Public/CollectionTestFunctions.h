@@ -4,35 +4,197 @@
 
 #include "Misc/AutomationTest.h"
 #include "Templates/StringUtils.h"
+#include "Traits/ConditionalType.h"
 
 #if WITH_AUTOMATION_WORKER
 
 /** Functions used within other functions declared in this file. */
 namespace OUU::TestUtilities::Private
 {
+	/** Default number of differing elements listed per category in collection comparison errors */
+	constexpr int32 DefaultMaxReportedElements = 10;
+
+	/** Concept for types that can be hashed with GetTypeHash() */
+	struct CGetTypeHashable
+	{
+		template <typename T>
+		auto Requires(const T& Val) -> decltype(GetTypeHash(Val));
+	};
+
+	/** Occurrences of an element in the expected and actual collection */
+	struct FElementCount
+	{
+		int32 NumExpected = 0;
+		int32 NumActual = 0;
+		/** Whether the element was already listed as missing or extra */
+		bool bReported = false;
+	};
+
+	/** Map key funcs that hash and compare the pointed-to elements, so elements do not have to be copied */
 	template <typename ElementType>
-	void AddArrayValueError(
-		FAutomationTestBase& AutomationTest,
-		const FString& What,
-		int32 Idx,
-		const ElementType& ActualValue,
-		const ElementType& ExpectedValue)
-	{
-		AutomationTest.AddError(
-			FString::Printf(
-				TEXT("%s: The two arrays have different values at index %i (expected %s, but it was %s)."),
-				*What,
-				Idx,
-				*LexToString(ExpectedValue),
-				*LexToString(ActualValue)),
-			1);
+	struct TElementPointerKeyFuncs : BaseKeyFuncs<TPair<const ElementType*, FElementCount>, const ElementType*, false>
+	{
+		static FORCEINLINE const ElementType* GetSetKey(const TPair<const ElementType*, FElementCount>& Element)
+		{
+			return Element.Key;
+		}
+		static FORCEINLINE bool Matches(const ElementType* A, const ElementType* B) { return *A == *B; }
+		static FORCEINLINE uint32 GetKeyHash(const ElementType* Key) { return GetTypeHash(*Key); }
+	};
+
+	/**
+	 * Counts occurrences of equal elements in two collections.
+	 * O(1) per element for hashable types, falls back to a linear search for other types.
+	 */
+	template <typename ElementType>
+	class TElementCounter
+	{
+	public:
+		static constexpr bool bIsHashable = TModels<CGetTypeHashable, ElementType>::Value;
+
+		FElementCount& FindOrAdd(const ElementType& Element)
+		{
+			if constexpr (bIsHashable)
+			{
+				return Counts.FindOrAdd(&Element);
+			}
+			else
+			{
+				for (auto& Entry : Counts)
+				{
+					if (*Entry.Key == Element)
+						return Entry.Value;
+				}
+				return Counts.Emplace_GetRef(&Element, FElementCount()).Value;
+			}
+		}
+
+		const FElementCount* Find(const ElementType& Element) const
+		{
+			if constexpr (bIsHashable)
+			{
+				return Counts.Find(&Element);
+			}
+			else
+			{
+				for (auto& Entry : Counts)
+				{
+					if (*Entry.Key == Element)
+						return &Entry.Value;
+				}
+				return nullptr;
+			}
+		}
+
+	private:
+		using FHashedCounts =
+			TMap<const ElementType*, FElementCount, FDefaultSetAllocator, TElementPointerKeyFuncs<ElementType>>;
+		using FLinearCounts = TArray<TPair<const ElementType*, FElementCount>>;
+		typename TConditionalType<bIsHashable, FHashedCounts, FLinearCounts>::Type Counts;
+	};
+
+	/** An element that is contained in one collection more often than in the other */
+	template <typename ElementType>
+	struct TCollectionDiffEntry
+	{
+		const ElementType* Element = nullptr;
+		int32 Count = 0;
+	};
+
+	/** Missing and extra elements of an actual collection compared to an expected collection, ignoring order */
+	template <typename ElementType>
+	struct TMultisetDiff
+	{
+		TElementCounter<ElementType> Counter;
+		/** In order of first occurrence in the expected collection */
+		TArray<TCollectionDiffEntry<ElementType>> Missing;
+		/** In order of first occurrence in the actual collection */
+		TArray<TCollectionDiffEntry<ElementType>> Extra;
+		int32 NumMissing = 0;
+		int32 NumExtra = 0;
+
+		FORCEINLINE bool IsEmpty() const { return Missing.Num() == 0 && Extra.Num() == 0; }
+
+		template <typename ActualRangeType, typename ExpectedRangeType>
+		TMultisetDiff(const ActualRangeType& Actual, const ExpectedRangeType& Expected)
+		{
+			for (const ElementType& Element : Expected)
+			{
+				Counter.FindOrAdd(Element).NumExpected++;
+			}
+			for (const ElementType& Element : Actual)
+			{
+				Counter.FindOrAdd(Element).NumActual++;
+			}
+
+			// Every distinct element is only listed at its first occurrence
+			for (const ElementType& Element : Expected)
+			{
+				FElementCount& Count = Counter.FindOrAdd(Element);
+				if (Count.NumExpected > Count.NumActual && !Count.bReported)
+				{
+					const int32 NumMissingElements = Count.NumExpected - Count.NumActual;
+					Missing.Add({&Element, NumMissingElements});
+					NumMissing += NumMissingElements;
+					Count.bReported = true;
+				}
+			}
+			for (const ElementType& Element : Actual)
+			{
+				FElementCount& Count = Counter.FindOrAdd(Element);
+				if (Count.NumActual > Count.NumExpected && !Count.bReported)
+				{
+					const int32 NumExtraElements = Count.NumActual - Count.NumExpected;
+					Extra.Add({&Element, NumExtraElements});
+					NumExtra += NumExtraElements;
+					Count.bReported = true;
+				}
+			}
+		}
+	};
+
+	template <typename ElementType>
+	void AppendDiffEntries(
+		FString& InOutReport,
+		const TCHAR* Label,
+		const TArray<TCollectionDiffEntry<ElementType>>& Entries,
+		int32 MaxReportedElements)
+	{
+		const int32 NumReported = FMath::Clamp(MaxReportedElements, 0, Entries.Num());
+		for (int32 i = 0; i < NumReported; i++)
+		{
+			InOutReport += FString::Printf(TEXT("\n\t%s: %s"), Label, *LexToString(*Entries[i].Element));
+			if (Entries[i].Count > 1)
+			{
+				InOutReport += FString::Printf(TEXT(", %i times"), Entries[i].Count);
+			}
+		}
+		if (Entries.Num() > NumReported)
+		{
+			InOutReport += FString::Printf(TEXT("\n\t... and %i more %s"), Entries.Num() - NumReported, Label);
+		}
+	}
+
+	template <typename ElementType>
+	void AppendMultisetDiff(FString& InOutReport, const TMultisetDiff<ElementType>& Diff, int32 MaxReportedElements)
+	{
+		AppendDiffEntries(InOutReport, TEXT("missing"), Diff.Missing, MaxReportedElements);
+		AppendDiffEntries(InOutReport, TEXT("extra"), Diff.Extra, MaxReportedElements);
+	}
+
+	template <typename ElementType>
+	FString ElementToString(const ElementType* Element)
+	{
+		return Element ? LexToString(*Element) : TEXT("<none>");
 	}
 } // namespace OUU::TestUtilities::Private
 
 /**
  * Test if two arrays are equal.
  * This check does not have any functional difference to an arrays equality check via operator==(),
- * but this function has more verbose output because it compares individual array elements.
+ * but this function has more verbose output: It reports the first differing index, the number of differing
+ * positions and which elements are missing, extra or only moved to another position (capped at MaxReportedElements
+ * per category).
  */
 template <typename ElementType, typename AllocatorType>
 void TestArraysEqual(
@@ -40,110 +202,204 @@ void TestArraysEqual(
 	const FString& What,
 	const TArray<ElementType, AllocatorType>& ActualArray,
 	const TArray<ElementType, AllocatorType>& ExpectedArray,
-	const bool bPrintEntireArrayOnError = false)
+	const bool bPrintEntireArrayOnError = false,
+	const int32 MaxReportedElements = OUU::TestUtilities::Private::DefaultMaxReportedElements)
 {
-	auto ConditionalPrintEntireArrayContents = [&]() {
-		if (bPrintEntireArrayOnError)
-		{
-			AutomationTest.AddError(
-				FString::Printf(TEXT("%s: Expected array: %s"), *What, *ArrayToString(ExpectedArray)));
-			AutomationTest.AddError(FString::Printf(TEXT("%s: Actual array: %s"), *What, *ArrayToString(ActualArray)));
-		}
-	};
+	using namespace OUU::TestUtilities::Private;
+
+	if (ActualArray == ExpectedArray)
+		return;
 
-	// Quick initial test: Compare element counts
 	const int32 ActualNum = ActualArray.Num();
 	const int32 ExpectedNum = ExpectedArray.Num();
-	if (ActualNum != ExpectedNum)
-	{
-		AutomationTest.AddError(
-			FString::Printf(
-				TEXT("%s: The two arrays have different length (expected %i, but it was %i)."),
-				*What,
-				ExpectedNum,
-				ActualNum),
-			1);
-		ConditionalPrintEntireArrayContents();
-		return;
-	}
+	const int32 CommonNum = FMath::Min(ActualNum, ExpectedNum);
 
-	// More thorough test: Compare individual elements for equal values at the same index
-	for (int32 i = 0; i < ActualNum; i++)
+	int32 FirstDifference = CommonNum;
+	int32 NumDifferentPositions = FMath::Abs(ActualNum - ExpectedNum);
+	for (int32 i = 0; i < CommonNum; i++)
 	{
 		if (ActualArray[i] != ExpectedArray[i])
 		{
-			OUU::TestUtilities::Private::AddArrayValueError(AutomationTest, What, i, ActualArray[i], ExpectedArray[i]);
-			ConditionalPrintEntireArrayContents();
-			return;
+			FirstDifference = FMath::Min(FirstDifference, i);
+			NumDifferentPositions++;
 		}
 	}
 
-	ensureMsgf(
-		ActualArray == ExpectedArray,
-		TEXT("If the two arrays did not match, we should have gotten an error before."));
+	FString Report = FString::Printf(
+		TEXT("%s: The two arrays differ at %i positions (expected %i elements, but it was %i). "
+			 "First difference at index %i (expected %s, but it was %s)."),
+		*What,
+		NumDifferentPositions,
+		ExpectedNum,
+		ActualNum,
+		FirstDifference,
+		*ElementToString(ExpectedArray.IsValidIndex(FirstDifference) ? &ExpectedArray[FirstDifference] : nullptr),
+		*ElementToString(ActualArray.IsValidIndex(FirstDifference) ? &ActualArray[FirstDifference] : nullptr));
+
+	const TMultisetDiff<ElementType> Diff(ActualArray, ExpectedArray);
+	// Moved elements are at a different position but are not missing from or extra in the actual array
+	TArray<TCollectionDiffEntry<ElementType>> Moved;
+	for (int32 i = 0; i < CommonNum; i++)
+	{
+		if (ActualArray[i] != ExpectedArray[i] && Diff.Counter.Find(ActualArray[i])->NumExpected > 0)
+		{
+			Moved.Add({&ActualArray[i], 1});
+		}
+	}
+	if (Diff.IsEmpty())
+	{
+		Report += TEXT(" The arrays contain the same elements in a different order.");
+	}
+	AppendMultisetDiff(Report, Diff, MaxReportedElements);
+	AppendDiffEntries(Report, TEXT("moved"), Moved, MaxReportedElements);
+	AutomationTest.AddError(Report, 1);
+
+	if (bPrintEntireArrayOnError)
+	{
+		AutomationTest.AddError(FString::Printf(TEXT("%s: Expected array: %s"), *What, *ArrayToString(ExpectedArray)));
+		AutomationTest.AddError(FString::Printf(TEXT("%s: Actual array: %s"), *What, *ArrayToString(ActualArray)));
+	}
 }
 
 /**
- * Test if two unordered arrays have matching elements.
- * Iterates several times over array to match array items, so it's pretty expensive.
- * However this allows to give quite detailed feedback which elements are missing from either array.
+ * Test if two unordered arrays have matching elements, i.e. contain the same elements with the same number of
+ * occurrences. O(n) for elements that support GetTypeHash(), O(n^2) otherwise.
+ * Errors list the missing and extra elements with their counts (capped at MaxReportedElements per category).
  */
 template <typename ElementType, typename AllocatorType>
 void TestUnorderedArraysMatch(
 	FAutomationTestBase& AutomationTest,
 	const FString& What,
 	const TArray<ElementType, AllocatorType>& ActualArray,
-	const TArray<ElementType, AllocatorType>& ExpectedArray)
+	const TArray<ElementType, AllocatorType>& ExpectedArray,
+	const int32 MaxReportedElements = OUU::TestUtilities::Private::DefaultMaxReportedElements)
 {
-	// Quick initial test: Compare element counts
-	const int32 ActualNum = ActualArray.Num();
-	const int32 ExpectedNum = ExpectedArray.Num();
-	if (ActualNum != ExpectedNum)
-	{
-		AutomationTest.AddError(
-			FString::Printf(
-				TEXT("%s: The two arrays have different length (expected %i, but it was %i)."),
-				*What,
-				ExpectedNum,
-				ActualNum),
-			1);
+	using namespace OUU::TestUtilities::Private;
+
+	const TMultisetDiff<ElementType> Diff(ActualArray, ExpectedArray);
+	if (Diff.IsEmpty())
 		return;
+
+	FString Report = FString::Printf(
+		TEXT("%s: The two arrays do not contain the same elements "
+			 "(%i missing, %i extra, expected %i elements, but it was %i)."),
+		*What,
+		Diff.NumMissing,
+		Diff.NumExtra,
+		ExpectedArray.Num(),
+		ActualArray.Num());
+	AppendMultisetDiff(Report, Diff, MaxReportedElements);
+	AutomationTest.AddError(Report, 1);
+}
+
+/**
+ * Test if two sets contain the same elements.
+ * Errors list the missing and extra elements (capped at MaxReportedElements per category).
+ */
+template <typename ElementType, typename KeyFuncs, typename AllocatorType>
+void TestSetsEqual(
+	FAutomationTestBase& AutomationTest,
+	const FString& What,
+	const TSet<ElementType, KeyFuncs, AllocatorType>& ActualSet,
+	const TSet<ElementType, KeyFuncs, AllocatorType>& ExpectedSet,
+	const int32 MaxReportedElements = OUU::TestUtilities::Private::DefaultMaxReportedElements)
+{
+	using namespace OUU::TestUtilities::Private;
+
+	TArray<TCollectionDiffEntry<ElementType>> Missing, Extra;
+	for (const ElementType& Element : ExpectedSet)
+	{
+		if (!ActualSet.Contains(KeyFuncs::GetSetKey(Element)))
+		{
+			Missing.Add({&Element, 1});
+		}
 	}
-	TArray<ElementType, AllocatorType> ActualArrayCopy = ActualArray;
-	TArray<ElementType, AllocatorType> ExpectedArrayCopy = ExpectedArray;
-	for (int32 i = ExpectedArrayCopy.Num() - 1; i >= 0; --i)
+	for (const ElementType& Element : ActualSet)
 	{
-		const auto& Value = ExpectedArrayCopy[i];
-		int32 j = ActualArrayCopy.Find(Value);
-		if (j == INDEX_NONE)
+		if (!ExpectedSet.Contains(KeyFuncs::GetSetKey(Element)))
 		{
-			AutomationTest.AddError(
-				FString::Printf(
-					TEXT("%s: The value %s from the expected array was not found in the actual array"),
-					*What,
-					*LexToString(Value)),
-				1);
-			return;
+			Extra.Add({&Element, 1});
 		}
-
-		ExpectedArrayCopy.RemoveAtSwap(i);
-		ActualArrayCopy.RemoveAtSwap(j);
 	}
+	if (Missing.Num() == 0 && Extra.Num() == 0)
+		return;
+
+	FString Report = FString::Printf(
+		TEXT("%s: The two sets do not contain the same elements "
+			 "(%i missing, %i extra, expected %i elements, but it was %i)."),
+		*What,
+		Missing.Num(),
+		Extra.Num(),
+		ExpectedSet.Num(),
+		ActualSet.Num());
+	AppendDiffEntries(Report, TEXT("missing"), Missing, MaxReportedElements);
+	AppendDiffEntries(Report, TEXT("extra"), Extra, MaxReportedElements);
+	AutomationTest.AddError(Report, 1);
+}
+
+/**
+ * Test if two maps contain the same keys with equal values.
+ * Errors list the missing keys, extra keys and keys with different values (capped at MaxReportedElements per
+ * category).
+ */
+template <typename KeyType, typename ValueType, typename SetAllocator, typename KeyFuncs>
+void TestMapsEqual(
+	FAutomationTestBase& AutomationTest,
+	const FString& What,
+	const TMap<KeyType, ValueType, SetAllocator, KeyFuncs>& ActualMap,
+	const TMap<KeyType, ValueType, SetAllocator, KeyFuncs>& ExpectedMap,
+	const int32 MaxReportedElements = OUU::TestUtilities::Private::DefaultMaxReportedElements)
+{
+	using namespace OUU::TestUtilities::Private;
 
-	if (ActualArrayCopy.Num() > 0)
+	TArray<TCollectionDiffEntry<KeyType>> Missing, Extra;
+	TArray<FString> DifferentValues;
+	int32 NumDifferentValues = 0;
+	for (const auto& ExpectedEntry : ExpectedMap)
 	{
-		AutomationTest.AddError(
-			FString::Printf(
-				TEXT("%s: The actual array contains %i that could not be matched to the expected array"),
-				*What,
-				ActualArrayCopy.Num()),
-			1);
-		return;
+		const ValueType* ActualValue = ActualMap.Find(ExpectedEntry.Key);
+		if (!ActualValue)
+		{
+			Missing.Add({&ExpectedEntry.Key, 1});
+		}
+		else if (!(*ActualValue == ExpectedEntry.Value))
+		{
+			if (NumDifferentValues++ < MaxReportedElements)
+			{
+				DifferentValues.Add(FString::Printf(
+					TEXT("\n\tdifferent value: %s (expected %s, but it was %s)"),
+					*LexToString(ExpectedEntry.Key),
+					*LexToString(ExpectedEntry.Value),
+					*LexToString(*ActualValue)));
+			}
+		}
 	}
+	for (const auto& ActualEntry : ActualMap)
+	{
+		if (!ExpectedMap.Contains(ActualEntry.Key))
+		{
+			Extra.Add({&ActualEntry.Key, 1});
+		}
+	}
+	if (Missing.Num() == 0 && Extra.Num() == 0 && NumDifferentValues == 0)
+		return;
 
-	ensureMsgf(
-		ActualArrayCopy.Num() == 0 && ExpectedArrayCopy.Num() == 0,
-		TEXT("If we didn't find all values in both arrays, we should have gotten an error before."));
+	FString Report = FString::Printf(
+		TEXT("%s: The two maps are not equal (%i missing keys, %i extra keys, %i different values)."),
+		*What,
+		Missing.Num(),
+		Extra.Num(),
+		NumDifferentValues);
+	AppendDiffEntries(Report, TEXT("missing"), Missing, MaxReportedElements);
+	AppendDiffEntries(Report, TEXT("extra"), Extra, MaxReportedElements);
+	Report += FString::Join(DifferentValues, TEXT(""));
+	if (NumDifferentValues > DifferentValues.Num())
+	{
+		Report += FString::Printf(
+			TEXT("\n\t... and %i more different values"),
+			NumDifferentValues - DifferentValues.Num());
+	}
+	AutomationTest.AddError(Report, 1);
 }
 
 #endif
@@ -31,10 +31,23 @@ namespace OUU::TestUtilities
 	 *             }
 	 *         }
 	 *     }
+	 *
+	 * Shared sessions (opt-in via SetUseSharedSession):
+	 * All loaders with a shared session reuse the PIE session of the same map instead of reloading the map for every
+	 * test. Before a shared world is handed to the next test, it is reset:
+	 * - All actors spawned since the map was loaded are destroyed
+	 * - All reset hooks are executed (e.g. to reset subsystems or actors that were modified by tests)
+	 * - The surviving actors are compared to the actors after the initial load to detect world pollution,
+	 *   e.g. destroyed map actors or actors spawned by reset hooks
+	 * If a reset hook fails or the world is polluted, the map is loaded from scratch.
+	 * Shared sessions stay open until CloseSharedSession() is called or the test run is complete.
 	 */
 	class OUUTESTUTILITIES_API FLatentAutomationPIEWorldLoader
 	{
 	public:
+		/** Resets a shared world for the next test. Return false if the world could not be reset. */
+		using FResetHook = TFunction<bool(UWorld& World)>;
+
 		FLatentAutomationPIEWorldLoader(
 			FAutomationSpecBase& OwningSpec,
 			const FString& MapName = TEXT("/OpenUnrealUtilities/Runtime/EmptyWorld"),
@@ -47,17 +60,37 @@ namespace OUU::TestUtilities
 		UWorld* GetLoadedWorld() const;
 
 		// Close PIE (if in editor). Put this in your test cleanup, otherwise the PIE window remains open.
+		// Does not close shared sessions.
 		void ClosePIE();
 
+		// Opt-in to reuse a PIE session of the same map across tests (see class docs)
+		void SetUseSharedSession(bool bInUseSharedSession);
+		void AddResetHook(FResetHook ResetHook);
+		void ClearResetHooks();
+
+		// Whether the last LatentLoad() reused the shared session instead of loading the map
+		FORCEINLINE bool WasLastLoadShared() const { return bLastLoadShared; }
+
+		// Close PIE if there is a shared session.
+		// Called automatically after all tests of a test run completed.
+		static void CloseSharedSession();
+
 	private:
 		FAutomationSpecBase& OwningSpec;
 		FDoneDelegate MapLoadedDelegate;
 		const FString MapName;
 		bool bIgnoreLoadErrors;
+		bool bUseSharedSession = false;
+		bool bLastLoadShared = false;
+		TArray<FResetHook> ResetHooks;
 
 		bool IsGameStartComplete() const;
 
 		void Update_MapLoaded();
+
+		// Reset the world of the shared session for the next test. Returns false if the map must be loaded again.
+		bool TryResetSharedSession();
+		void StartSharedSession();
 	};
 } // namespace OUU::TestUtilities
 
@@ -87,6 +87,12 @@ FORCEINLINE FString OUUTESTUTILITIES_API EscapeTestName(const FString& InTestNam
 		OutTestCommands.Add(TestCaseString);                                                                           \
 		OutBeautifiedNames.Add(DisplayName);
 
+	/**
+	 * Adds all combinations of a TAutomationTestParameterMatrix as test-cases.
+	 * Use this inline after OUU_IMPLEMENT_COMPLEX_AUTOMATION_TEST_BEGIN()
+	 */
+	#define OUU_COMPLEX_AUTOMATION_TESTCASE_MATRIX(Matrix) (Matrix).GetTests(OutBeautifiedNames, OutTestCommands);
+
 	/**
 	 * End the header of a complex automation test definition.
 	 * After this comes the test function body in curly brackets.
@@ -27,6 +27,7 @@ public class OUUTests : OUUModuleRules
 			"OUURuntime",
 			"OUUBlueprintRuntime",
 			"OUUUMG",
+			"OUUDeveloper",
 			"OUUTestUtilities"
 		});
 
@@ -0,0 +1,138 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Dom/JsonObject.h"
+	#include "LogOpenUnrealUtilitiesLibrary.h"
+	#include "Serialization/JsonReader.h"
+	#include "Serialization/JsonSerializer.h"
+
+BEGIN_DEFINE_SPEC(
+	FLogOpenUnrealUtilitiesLibrarySpec,
+	"OpenUnrealUtilities.BlueprintRuntime.Logging.LogOpenUnrealUtilitiesLibrary",
+	DEFAULT_OUU_TEST_FLAGS)
+END_DEFINE_SPEC(FLogOpenUnrealUtilitiesLibrarySpec)
+void FLogOpenUnrealUtilitiesLibrarySpec::Define()
+{
+	Describe("ParseFormatFieldNames", [this]() {
+		It("should return all argument names in the order of first occurrence", [this]() {
+			const TArray<FString> FieldNames =
+				ULogOpenUnrealUtilitiesLibrary::ParseFormatFieldNames(TEXT("{Actor} took {Damage} from {Instigator}"));
+			const TArray<FString> Expected = {TEXT("Actor"), TEXT("Damage"), TEXT("Instigator")};
+			SPEC_TEST_ARRAYS_EQUAL(FieldNames, Expected);
+		});
+
+		It("should return each argument only once", [this]() {
+			const TArray<FString> FieldNames =
+				ULogOpenUnrealUtilitiesLibrary::ParseFormatFieldNames(TEXT("{A} {B} {A}"));
+			const TArray<FString> Expected = {TEXT("A"), TEXT("B")};
+			SPEC_TEST_ARRAYS_EQUAL(FieldNames, Expected);
+		});
+
+		It("should ignore empty and unterminated arguments", [this]() {
+			const TArray<FString> FieldNames =
+				ULogOpenUnrealUtilitiesLibrary::ParseFormatFieldNames(TEXT("{} {Open {Closed}"));
+			const TArray<FString> Expected = {TEXT("Closed")};
+			SPEC_TEST_ARRAYS_EQUAL(FieldNames, Expected);
+		});
+	});
+
+	Describe("FormatStructuredMessage", [this]() {
+		It("should replace arguments with the values of the fields with the same name", [this]() {
+			const FString Message = ULogOpenUnrealUtilitiesLibrary::FormatStructuredMessage(
+				TEXT("{Actor} took {Damage} damage from {Instigator}. Ouch, {Actor}!"),
+				{TEXT("Actor"), TEXT("Instigator"), TEXT("Damage")},
+				{TEXT("Player"), TEXT("Enemy"), TEXT("42")});
+			SPEC_TEST_EQUAL(Message, FString(TEXT("Player took 42 damage from Enemy. Ouch, Player!")));
+		});
+
+		It("should keep arguments without matching field and unterminated braces", [this]() {
+			const FString Message = ULogOpenUnrealUtilitiesLibrary::FormatStructuredMessage(
+				TEXT("{A} {Unknown} {} {A"),
+				{TEXT("A")},
+				{TEXT("1")});
+			SPEC_TEST_EQUAL(Message, FString(TEXT("1 {Unknown} {} {A")));
+		});
+
+		It("should match argument names case sensitively", [this]() {
+			const FString Message =
+				ULogOpenUnrealUtilitiesLibrary::FormatStructuredMessage(TEXT("{value}"), {TEXT("Value")}, {TEXT("1")});
+			SPEC_TEST_EQUAL(Message, FString(TEXT("{value}")));
+		});
+	});
+
+	Describe("MakeStructuredLogLine", [this]() {
+		It("should write a single line JSON object with the message and all fields", [this]() {
+			const FString Line = ULogOpenUnrealUtilitiesLibrary::MakeStructuredLogLine(
+				TEXT("LogOUUTests_StructuredLog"),
+				EOUUBlueprintLogVerbosity::Warning,
+				TEXT("Player took 42 damage"),
+				{TEXT("Actor"), TEXT("Damage")},
+				{TEXT("Player"), TEXT("42")});
+			SPEC_TEST_FALSE(Line.Contains(TEXT("\n")));
+
+			TSharedPtr<FJsonObject> JsonObject;
+			SPEC_TEST_TRUE(FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), JsonObject));
+			if (!JsonObject.IsValid())
+				return;
+
+			SPEC_TEST_EQUAL(JsonObject->GetStringField(TEXT("category")), FString(TEXT("LogOUUTests_StructuredLog")));
+			SPEC_TEST_EQUAL(JsonObject->GetStringField(TEXT("verbosity")), FString(TEXT("Warning")));
+			SPEC_TEST_EQUAL(JsonObject->GetStringField(TEXT("message")), FString(TEXT("Player took 42 damage")));
+			SPEC_TEST_TRUE(JsonObject->HasTypedField<EJson::String>(TEXT("time")));
+			SPEC_TEST_TRUE(JsonObject->HasTypedField<EJson::Number>(TEXT("frame")));
+
+			const TSharedPtr<FJsonObject>* FieldsObject = nullptr;
+			SPEC_TEST_TRUE(JsonObject->TryGetObjectField(TEXT("fields"), FieldsObject));
+			if (!FieldsObject)
+				return;
+
+			SPEC_TEST_EQUAL((*FieldsObject)->Values.Num(), 2);
+			SPEC_TEST_EQUAL((*FieldsObject)->GetStringField(TEXT("Actor")), FString(TEXT("Player")));
+			SPEC_TEST_EQUAL((*FieldsObject)->GetStringField(TEXT("Damage")), FString(TEXT("42")));
+		});
+
+		It("should escape special characters in values", [this]() {
+			const FString Value = TEXT("Line \"one\"\nLine two");
+			const FString Line = ULogOpenUnrealUtilitiesLibrary::MakeStructuredLogLine(
+				NAME_None,
+				EOUUBlueprintLogVerbosity::Log,
+				Value,
+				{TEXT("Value")},
+				{Value});
+			SPEC_TEST_FALSE(Line.Contains(TEXT("\n")));
+
+			TSharedPtr<FJsonObject> JsonObject;
+			SPEC_TEST_TRUE(FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), JsonObject));
+			if (!JsonObject.IsValid())
+				return;
+
+			SPEC_TEST_EQUAL(JsonObject->GetStringField(TEXT("message")), Value);
+			SPEC_TEST_EQUAL(JsonObject->GetObjectField(TEXT("fields"))->GetStringField(TEXT("Value")), Value);
+		});
+	});
+
+	Describe("IsLogCategoryActive", [this]() {
+		It("should use the default verbosity Log for new categories", [this]() {
+			const FName Category = TEXT("LogOUUTests_BlueprintLogCategory");
+			SPEC_TEST_TRUE(ULogOpenUnrealUtilitiesLibrary::IsLogCategoryActive(
+				Category,
+				EOUUBlueprintLogVerbosity::Warning));
+			SPEC_TEST_TRUE(
+				ULogOpenUnrealUtilitiesLibrary::IsLogCategoryActive(Category, EOUUBlueprintLogVerbosity::Log));
+			SPEC_TEST_FALSE(ULogOpenUnrealUtilitiesLibrary::IsLogCategoryActive(
+				Category,
+				EOUUBlueprintLogVerbosity::VeryVerbose));
+		});
+
+		It("should always be true for fatal messages", [this]() {
+			SPEC_TEST_TRUE(ULogOpenUnrealUtilitiesLibrary::IsLogCategoryActive(
+				TEXT("LogOUUTests_BlueprintLogCategory"),
+				EOUUBlueprintLogVerbosity::Fatal));
+		});
+	});
+}
+
+#endif
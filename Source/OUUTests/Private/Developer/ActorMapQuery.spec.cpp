@@ -0,0 +1,209 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "ActorMapWindow/OUUActorMapWindow.h"
+	#include "AutomationTestWorld.h"
+	#include "Engine/StaticMeshActor.h"
+	#include "EngineUtils.h"
+
+using namespace OUU::Developer::ActorMapWindow;
+
+BEGIN_DEFINE_SPEC(
+	FActorMapQuerySpec,
+	"OpenUnrealUtilities.Developer.ActorMapWindow.ActorQuery",
+	DEFAULT_OUU_TEST_FLAGS)
+	TSharedPtr<FOUUAutomationTestWorld> TestWorld;
+
+	/** Spawn NumActors actors, every StaticMeshActorStride-th of which is a static mesh actor */
+	int32 SpawnActors(int32 NumActors, int32 StaticMeshActorStride)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		int32 NumStaticMeshActors = 0;
+		for (int32 i = 0; i < NumActors; i++)
+		{
+			if (i % StaticMeshActorStride == 0)
+			{
+				TestWorld->World->SpawnActor<AStaticMeshActor>(SpawnParameters);
+				NumStaticMeshActors++;
+			}
+			else
+			{
+				TestWorld->World->SpawnActor<AActor>(SpawnParameters);
+			}
+		}
+		return NumStaticMeshActors;
+	}
+
+	/** @returns if the class or any of its parent classes below ExitClass has the given name */
+	static bool ClassHasNameUncached(const UClass* Class, const UClass* ExitClass, const FString& ClassName)
+	{
+		for (; Class != nullptr && Class != ExitClass; Class = Class->GetSuperClass())
+		{
+			if (Class->GetName().Equals(ClassName, ESearchCase::IgnoreCase))
+				return true;
+		}
+		return false;
+	}
+
+	/** Reference implementation of the class filters of FActorQuery without any memoization */
+	static bool MatchesClassFiltersUncached(
+		const AActor* Actor,
+		const FString& ActorClassName,
+		const FString& ComponentClassName)
+	{
+		if (ActorClassName.IsEmpty() && ComponentClassName.IsEmpty())
+			return false;
+
+		if (!ActorClassName.IsEmpty()
+			&& !ClassHasNameUncached(Actor->GetClass(), AActor::StaticClass(), ActorClassName))
+			return false;
+
+		if (!ComponentClassName.IsEmpty())
+		{
+			bool bAtLeastOneComponentMatches = false;
+			for (const UActorComponent* Component : Actor->GetComponents())
+			{
+				bAtLeastOneComponentMatches |= IsValid(Component)
+					&& ClassHasNameUncached(Component->GetClass(), UActorComponent::StaticClass(), ComponentClassName);
+			}
+			if (!bAtLeastOneComponentMatches)
+				return false;
+		}
+		return true;
+	}
+
+	static TArray<FString> GetActorNames(const TArray<AActor*>& Actors)
+	{
+		TArray<FString> Names;
+		for (const AActor* Actor : Actors)
+		{
+			Names.Add(GetNameSafe(Actor));
+		}
+		Names.Sort();
+		return Names;
+	}
+END_DEFINE_SPEC(FActorMapQuerySpec)
+
+void FActorMapQuerySpec::Define()
+{
+	BeforeEach([this]() {
+		TestWorld = MakeShared<FOUUAutomationTestWorld>("FActorMapQuerySpec");
+		TestWorld->CreateWorld("ActorQuery");
+	});
+
+	AfterEach([this]() {
+		TestWorld->DestroyWorld();
+		TestWorld.Reset();
+	});
+
+	Describe("FActorQuery", [this]() {
+		It("should match the same actors as an uncached query after the class filters changed", [this]() {
+			SpawnActors(60, 3);
+
+			// Pairs of actor and component class names that are applied one after another to the same query
+			const TArray<TPair<FString, FString>> ClassFilters = {
+				{TEXT("StaticMeshActor"), TEXT("")},
+				{TEXT("Pawn"), TEXT("")},
+				{TEXT("StaticMeshActor"), TEXT("PrimitiveComponent")},
+				{TEXT("staticmeshactor"), TEXT("SkeletalMeshComponent")},
+				{TEXT(""), TEXT("MeshComponent")},
+				{TEXT(""), TEXT("SceneComponent")},
+				{TEXT("StaticMeshActor"), TEXT("")}};
+
+			FActorQuery Query;
+			for (const auto& ClassFilter : ClassFilters)
+			{
+				Query.ActorClassName = ClassFilter.Key;
+				Query.ComponentClassName = ClassFilter.Value;
+
+				TArray<AActor*> ExpectedActors;
+				for (AActor* Actor : TActorRange<AActor>(TestWorld->World))
+				{
+					if (MatchesClassFiltersUncached(Actor, ClassFilter.Key, ClassFilter.Value))
+					{
+						ExpectedActors.Add(Actor);
+					}
+				}
+
+				SPEC_TEST_ARRAYS_EQUAL(
+					GetActorNames(Query.ExecuteQuery(TestWorld->World).Actors),
+					GetActorNames(ExpectedActors));
+			}
+		});
+	});
+
+	Describe("FActorQueryBatch", [this]() {
+		It("should match actor and component classes including their parent classes", [this]() {
+			const int32 NumStaticMeshActors = SpawnActors(100, 4);
+
+			const TSharedPtr<FActorQuery> ActorClassQuery = MakeShared<FActorQuery>();
+			ActorClassQuery->ActorClassName = TEXT("StaticMeshActor");
+			const TSharedPtr<FActorQuery> ComponentClassQuery = MakeShared<FActorQuery>();
+			ComponentClassQuery->ComponentClassName = TEXT("MeshComponent");
+			FActorQueryBatch::ExecuteAndCacheQueries(TestWorld->World, {ActorClassQuery, ComponentClassQuery});
+
+			SPEC_TEST_EQUAL(ActorClassQuery->CachedQueryResult.Actors.Num(), NumStaticMeshActors);
+			SPEC_TEST_EQUAL(ComponentClassQuery->CachedQueryResult.Actors.Num(), NumStaticMeshActors);
+		});
+
+		It("should return the same results as executing each query on its own", [this]() {
+			SpawnActors(100, 3);
+
+			auto MakeQuery = [](const TCHAR* NameFilter, const TCHAR* NameRegexPattern, const TCHAR* ActorClassName) {
+				const TSharedPtr<FActorQuery> Query = MakeShared<FActorQuery>();
+				Query->NameFilter = NameFilter;
+				Query->NameRegexPattern = NameRegexPattern;
+				Query->ActorClassName = ActorClassName;
+				return Query;
+			};
+			// Actor names have no x, so this only matches if empty regex matches are accepted
+			const TSharedPtr<FActorQuery> EmptyRegexMatchQuery = MakeQuery(TEXT(""), TEXT("x*"), TEXT(""));
+			const TArray<TSharedPtr<FActorQuery>> Queries = {
+				EmptyRegexMatchQuery,
+				MakeQuery(TEXT("STATICMESH"), TEXT(""), TEXT("")),
+				MakeQuery(TEXT(""), TEXT("_\\d*[02468]$"), TEXT("")),
+				MakeQuery(TEXT("actor"), TEXT("_1\\d$"), TEXT("StaticMeshActor")),
+				MakeQuery(TEXT("mesh"), TEXT("Static"), TEXT("Actor"))};
+			FActorQueryBatch::ExecuteAndCacheQueries(TestWorld->World, Queries);
+
+			SPEC_TEST_EQUAL(EmptyRegexMatchQuery->CachedQueryResult.Actors.Num(), 0);
+			for (const TSharedPtr<FActorQuery>& Query : Queries)
+			{
+				const TArray<FString> BatchedNames = GetActorNames(Query->CachedQueryResult.Actors);
+				const TArray<FString> SingleNames = GetActorNames(Query->ExecuteQuery(TestWorld->World).Actors);
+				SPEC_TEST_ARRAYS_EQUAL(BatchedNames, SingleNames);
+			}
+		});
+
+		It("should query 100k actors in a single pass", [this]() {
+			constexpr int32 NumActors = 100000;
+			constexpr int32 NumPasses = 10;
+			const int32 NumStaticMeshActors = SpawnActors(NumActors, 10);
+
+			const TSharedPtr<FActorQuery> Query = MakeShared<FActorQuery>();
+			Query->ActorClassName = TEXT("StaticMeshActor");
+			Query->ComponentClassName = TEXT("StaticMeshComponent");
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumPasses; i++)
+			{
+				FActorQueryBatch::ExecuteAndCacheQueries(TestWorld->World, {Query});
+			}
+			const double AverageTime = (FPlatformTime::Seconds() - StartTime) / NumPasses;
+
+			SPEC_TEST_EQUAL(Query->CachedQueryResult.Actors.Num(), NumStaticMeshActors);
+			AddInfo(FString::Printf(
+				TEXT("Actor query pass over %i actors took %.3f ms on average (%i passes, %i matches)"),
+				NumActors,
+				AverageTime * 1000.0,
+				NumPasses,
+				Query->CachedQueryResult.Actors.Num()));
+		});
+	});
+}
+
+#endif
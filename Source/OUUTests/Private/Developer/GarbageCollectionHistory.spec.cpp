@@ -0,0 +1,133 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "GarbageCollectionHistory.h"
+	#include "GarbageCollectionHistoryTests.h"
+	#include "UObject/StrongObjectPtr.h"
+
+BEGIN_DEFINE_SPEC(
+	FGarbageCollectionHistorySpec,
+	"OpenUnrealUtilities.Developer.GarbageCollectionHistory",
+	DEFAULT_OUU_TEST_FLAGS)
+	const UClass* LeakingClass = nullptr;
+	const UClass* TransientClass = nullptr;
+
+	const FGarbageCollectionHistory::FLeakSuspect* FindSuspect(
+		const TArray<FGarbageCollectionHistory::FLeakSuspect>& Suspects,
+		const UClass* Class)
+	{
+		const FString ClassName = Class->GetPathName();
+		return Suspects.FindByPredicate([&](const auto& Suspect) { return Suspect.ClassName == ClassName; });
+	}
+END_DEFINE_SPEC(FGarbageCollectionHistorySpec)
+
+void FGarbageCollectionHistorySpec::Define()
+{
+	BeforeEach([this]() {
+		LeakingClass = UGarbageCollectionHistory_LeakingTestObject::StaticClass();
+		TransientClass = UGarbageCollectionHistory_TransientTestObject::StaticClass();
+	});
+
+	Describe("FindLeakSuspects", [this]() {
+		It("should flag classes with linearly growing counts", [this]() {
+			FGarbageCollectionHistory History(16);
+			for (int32 i = 0; i < 10; i++)
+			{
+				History.AddSample({{LeakingClass, 10 + i * 3}, {TransientClass, 5}}, i * 6.0);
+			}
+
+			const auto Suspects = History.FindLeakSuspects(8, 1.0, 0.9);
+			SPEC_TEST_EQUAL(Suspects.Num(), 1);
+			const auto* Suspect = FindSuspect(Suspects, LeakingClass);
+			if (SPEC_TEST_NOT_NULL(Suspect))
+			{
+				SPEC_TEST_EQUAL(Suspect->FirstCount, 10);
+				SPEC_TEST_EQUAL(Suspect->LastCount, 37);
+				SPEC_TEST_EQUAL_TOLERANCE(Suspect->GrowthPerPass, 3.0, 0.001);
+				// 3 objects every 6 seconds
+				SPEC_TEST_EQUAL_TOLERANCE(Suspect->GrowthPerMinute, 30.0, 0.001);
+				SPEC_TEST_EQUAL_TOLERANCE(Suspect->Linearity, 1.0, 0.001);
+			}
+		});
+
+		It("should not flag classes with fewer samples than the min number of passes", [this]() {
+			FGarbageCollectionHistory History(16);
+			for (int32 i = 0; i < 5; i++)
+			{
+				History.AddSample({{LeakingClass, i * 10}}, i);
+			}
+			SPEC_TEST_EQUAL(History.FindLeakSuspects(8, 1.0, 0.9).Num(), 0);
+		});
+
+		It("should not flag classes with spiky counts", [this]() {
+			FGarbageCollectionHistory History(16);
+			const TArray<int32> Counts = {10, 50, 10, 12, 60, 9, 11, 70, 10, 14};
+			for (int32 i = 0; i < Counts.Num(); i++)
+			{
+				History.AddSample({{LeakingClass, Counts[i]}}, i);
+			}
+			SPEC_TEST_EQUAL(History.FindLeakSuspects(8, 1.0, 0.8).Num(), 0);
+		});
+
+		It("should only evaluate the most recent samples after the history wrapped", [this]() {
+			FGarbageCollectionHistory History(8);
+			// Growth first, then constant for a full history
+			for (int32 i = 0; i < 8; i++)
+			{
+				History.AddSample({{LeakingClass, i * 10}}, i);
+			}
+			SPEC_TEST_EQUAL(History.FindLeakSuspects(8, 1.0, 0.9).Num(), 1);
+			for (int32 i = 0; i < 8; i++)
+			{
+				History.AddSample({{LeakingClass, 100}}, 8 + i);
+			}
+			SPEC_TEST_EQUAL(History.FindLeakSuspects(8, 1.0, 0.9).Num(), 0);
+		});
+	});
+
+	Describe("AddSample", [this]() {
+		It("should stop tracking classes without live objects for the entire history", [this]() {
+			FGarbageCollectionHistory History(4);
+			History.AddSample({{LeakingClass, 1}}, 0.0);
+			SPEC_TEST_EQUAL(History.NumTrackedClasses(), 1);
+			for (int32 i = 1; i <= 4; i++)
+			{
+				History.AddSample({}, i);
+			}
+			SPEC_TEST_EQUAL(History.NumTrackedClasses(), 0);
+		});
+	});
+
+	Describe("SampleLiveObjects", [this]() {
+		It("should detect objects that are kept alive across garbage collection passes", [this]() {
+			FGarbageCollectionHistory History(16);
+			TArray<TStrongObjectPtr<UObject>> LeakedObjects;
+			for (int32 Pass = 0; Pass < 10; Pass++)
+			{
+				for (int32 i = 0; i < 5; i++)
+				{
+					LeakedObjects.Emplace(NewObject<UGarbageCollectionHistory_LeakingTestObject>());
+					NewObject<UGarbageCollectionHistory_TransientTestObject>();
+				}
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+				History.SampleLiveObjects();
+			}
+
+			const auto Suspects = History.FindLeakSuspects(8, 1.0, 0.9);
+			const auto* LeakSuspect = FindSuspect(Suspects, LeakingClass);
+			if (SPEC_TEST_NOT_NULL(LeakSuspect))
+			{
+				SPEC_TEST_EQUAL_TOLERANCE(LeakSuspect->GrowthPerPass, 5.0, 0.001);
+			}
+			SPEC_TEST_NULL(FindSuspect(Suspects, TransientClass));
+
+			LeakedObjects.Empty();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		});
+	});
+}
+
+#endif
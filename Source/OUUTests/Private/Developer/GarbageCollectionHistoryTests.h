@@ -0,0 +1,19 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "GarbageCollectionHistoryTests.generated.h"
+
+UCLASS(HideDropdown, Hidden)
+class UGarbageCollectionHistory_LeakingTestObject : public UObject
+{
+	GENERATED_BODY()
+};
+
+UCLASS(HideDropdown, Hidden)
+class UGarbageCollectionHistory_TransientTestObject : public UObject
+{
+	GENERATED_BODY()
+};
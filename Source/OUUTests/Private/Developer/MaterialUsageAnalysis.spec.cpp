@@ -0,0 +1,176 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "MaterialUsageAnalysis.h"
+
+using namespace OUU::Developer::MaterialUsageAnalysis;
+
+BEGIN_DEFINE_SPEC(
+	FMaterialUsageAccumulatorSpec,
+	"OpenUnrealUtilities.Developer.MaterialUsageAnalysis.MaterialUsageAccumulator",
+	DEFAULT_OUU_TEST_FLAGS)
+	const FSoftObjectPath MeshA = FSoftObjectPath(TEXT("/Game/OUUTests/SM_MeshA.SM_MeshA"));
+	const FSoftObjectPath MeshB = FSoftObjectPath(TEXT("/Game/OUUTests/SK_MeshB.SK_MeshB"));
+	const FSoftObjectPath Material1 = FSoftObjectPath(TEXT("/Game/OUUTests/M_Material1.M_Material1"));
+	const FSoftObjectPath Material2 = FSoftObjectPath(TEXT("/Game/OUUTests/M_Material2.M_Material2"));
+
+	static FPrimitiveUsage MakeUsage(
+		const FSoftObjectPath& Mesh,
+		TArray<FSoftObjectPath> Materials,
+		EPrimitiveUsageType Type,
+		int32 NumInstances,
+		bool bCanBeInstanced)
+	{
+		FPrimitiveUsage Usage;
+		Usage.Mesh = Mesh;
+		Usage.Materials = MoveTemp(Materials);
+		Usage.Type = Type;
+		Usage.NumInstances = NumInstances;
+		Usage.bCanBeInstanced = bCanBeInstanced;
+		return Usage;
+	}
+
+	static const FMaterialUsageAccumulator::FCombinationStats* FindCombination(
+		const FMaterialUsageAccumulator& Accumulator,
+		const FSoftObjectPath& Mesh,
+		const TArray<FSoftObjectPath>& Materials)
+	{
+		for (const auto* Stats : Accumulator.GetSortedCombinations())
+		{
+			if (Stats->Mesh == Mesh && Stats->Materials == Materials)
+				return Stats;
+		}
+		return nullptr;
+	}
+END_DEFINE_SPEC(FMaterialUsageAccumulatorSpec)
+
+void FMaterialUsageAccumulatorSpec::Define()
+{
+	Describe("AddLevelUsages", [this]() {
+		It("should merge usages of the same mesh and materials across levels", [this]() {
+			FMaterialUsageAccumulator Accumulator;
+			Accumulator.AddLevelUsages(
+				TEXT("LevelA"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true),
+				 MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, false),
+				 MakeUsage(MeshA, {Material1, Material2}, EPrimitiveUsageType::StaticMesh, 1, true)});
+			Accumulator.AddLevelUsages(
+				TEXT("LevelB"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::InstancedStaticMesh, 10, true)});
+
+			SPEC_TEST_EQUAL(Accumulator.NumCombinations(), 2);
+			const auto* Stats = FindCombination(Accumulator, MeshA, {Material1});
+			SPEC_TEST_NOT_NULL(Stats);
+			if (!Stats)
+				return;
+
+			SPEC_TEST_EQUAL(Stats->NumInstances, 12);
+			SPEC_TEST_EQUAL(Stats->NumInstances_Possible, 11);
+			SPEC_TEST_EQUAL(Stats->NumStaticMeshComponents, 3);
+			SPEC_TEST_EQUAL(Stats->NumSkinnedMeshComponents, 0);
+			SPEC_TEST_EQUAL(Stats->NumOtherComponents, 0);
+			SPEC_TEST_EQUAL(Stats->NumLevels, 2);
+		});
+
+		It("should count primitives, instances and combinations per level", [this]() {
+			FMaterialUsageAccumulator Accumulator;
+			Accumulator.AddLevelUsages(
+				TEXT("LevelA"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true),
+				 MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true),
+				 MakeUsage(MeshB, {Material2}, EPrimitiveUsageType::SkinnedMesh, 1, false)});
+			Accumulator.AddLevelUsages(
+				TEXT("LevelB"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::InstancedStaticMesh, 10, true)});
+
+			const TArray<FMaterialUsageAccumulator::FLevelStats>& Levels = Accumulator.GetLevelStats();
+			SPEC_TEST_EQUAL(Levels.Num(), 2);
+			if (Levels.Num() != 2)
+				return;
+
+			SPEC_TEST_EQUAL(Levels[0].Level, FString(TEXT("LevelA")));
+			SPEC_TEST_EQUAL(Levels[0].NumPrimitives, 3);
+			SPEC_TEST_EQUAL(Levels[0].NumInstances, 3);
+			SPEC_TEST_EQUAL(Levels[0].NumCombinations, 2);
+			SPEC_TEST_EQUAL(Levels[1].Level, FString(TEXT("LevelB")));
+			SPEC_TEST_EQUAL(Levels[1].NumPrimitives, 1);
+			SPEC_TEST_EQUAL(Levels[1].NumInstances, 10);
+			SPEC_TEST_EQUAL(Levels[1].NumCombinations, 1);
+		});
+
+		It("should merge consecutive chunks of the same level", [this]() {
+			FMaterialUsageAccumulator Accumulator;
+			Accumulator.AddLevelUsages(
+				TEXT("LevelA"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true)});
+			Accumulator.AddLevelUsages(
+				TEXT("LevelA"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true)});
+
+			SPEC_TEST_EQUAL(Accumulator.GetLevelStats().Num(), 1);
+			const auto* Stats = FindCombination(Accumulator, MeshA, {Material1});
+			SPEC_TEST_NOT_NULL(Stats);
+			if (!Stats)
+				return;
+
+			SPEC_TEST_EQUAL(Stats->NumInstances, 2);
+			SPEC_TEST_EQUAL(Stats->NumLevels, 1);
+		});
+	});
+
+	Describe("GetSortedCombinations", [this]() {
+		It("should sort the combinations by descending instance count", [this]() {
+			FMaterialUsageAccumulator Accumulator;
+			Accumulator.AddLevelUsages(
+				TEXT("LevelA"),
+				{MakeUsage(MeshB, {Material2}, EPrimitiveUsageType::SkinnedMesh, 1, false),
+				 MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::InstancedStaticMesh, 20, true),
+				 MakeUsage(MeshA, {Material2}, EPrimitiveUsageType::StaticMesh, 5, true)});
+
+			TArray<int32> NumInstances;
+			for (const auto* Stats : Accumulator.GetSortedCombinations())
+			{
+				NumInstances.Add(Stats->NumInstances);
+			}
+			const TArray<int32> Expected = {20, 5, 1};
+			SPEC_TEST_ARRAYS_EQUAL(NumInstances, Expected);
+		});
+	});
+
+	Describe("Reset", [this]() {
+		It("should discard all combinations and levels", [this]() {
+			FMaterialUsageAccumulator Accumulator;
+			Accumulator.AddLevelUsages(
+				TEXT("LevelA"),
+				{MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true)});
+			Accumulator.Reset();
+
+			SPEC_TEST_EQUAL(Accumulator.NumCombinations(), 0);
+			SPEC_TEST_EQUAL(Accumulator.GetLevelStats().Num(), 0);
+		});
+
+		It("should accumulate the same usages from scratch after a reset", [this]() {
+			FMaterialUsageAccumulator Accumulator;
+			const TArray<FPrimitiveUsage> Usages = {
+				MakeUsage(MeshA, {Material1}, EPrimitiveUsageType::StaticMesh, 1, true)};
+			Accumulator.AddLevelUsages(TEXT("LevelA"), Usages);
+			Accumulator.AddLevelUsages(TEXT("LevelB"), Usages);
+			Accumulator.Reset();
+			Accumulator.AddLevelUsages(TEXT("LevelA"), Usages);
+
+			SPEC_TEST_EQUAL(Accumulator.GetLevelStats().Num(), 1);
+			const auto* Stats = FindCombination(Accumulator, MeshA, {Material1});
+			SPEC_TEST_NOT_NULL(Stats);
+			if (!Stats)
+				return;
+
+			SPEC_TEST_EQUAL(Stats->NumInstances, 1);
+			SPEC_TEST_EQUAL(Stats->NumLevels, 1);
+		});
+	});
+}
+
+#endif
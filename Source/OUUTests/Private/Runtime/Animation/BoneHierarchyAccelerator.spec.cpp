@@ -0,0 +1,208 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Animation/BoneHierarchyAccelerator.h"
+
+using namespace OUU::Runtime::Animation;
+
+BEGIN_DEFINE_SPEC(
+	FBoneHierarchyAcceleratorSpec,
+	"OpenUnrealUtilities.Runtime.Animation.BoneHierarchyAccelerator",
+	DEFAULT_OUU_TEST_FLAGS)
+	static constexpr int32 NumTestBones = 500;
+	FReferenceSkeleton ReferenceSkeleton;
+
+	/** Create a random tree in which each bone is attached to one of the previous 8 bones. */
+	void BuildTestSkeleton(int32 NumBones)
+	{
+		ReferenceSkeleton = FReferenceSkeleton();
+		FReferenceSkeletonModifier Modifier(ReferenceSkeleton, nullptr);
+		FRandomStream RandomStream(42);
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; BoneIndex++)
+		{
+			const int32 ParentIndex =
+				BoneIndex == 0 ? INDEX_NONE : RandomStream.RandRange(FMath::Max(0, BoneIndex - 8), BoneIndex - 1);
+			const FString BoneName = FString::Printf(TEXT("Bone_%i"), BoneIndex);
+			Modifier.Add(FMeshBoneInfo(*BoneName, BoneName, ParentIndex), FTransform::Identity);
+		}
+	}
+
+	template <typename RangeType>
+	static TArray<int32> ToArray(const RangeType& Range)
+	{
+		TArray<int32> Result;
+		for (const int32 BoneIndex : Range)
+		{
+			Result.Add(BoneIndex);
+		}
+		return Result;
+	}
+END_DEFINE_SPEC(FBoneHierarchyAcceleratorSpec)
+void FBoneHierarchyAcceleratorSpec::Define()
+{
+	BeforeEach([this]() { BuildTestSkeleton(NumTestBones); });
+
+	It("should have the same parents and depths as the reference skeleton", [this]() {
+		const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+		SPEC_TEST_EQUAL(Hierarchy.Num(), ReferenceSkeleton.GetNum());
+		for (int32 BoneIndex = 0; BoneIndex < Hierarchy.Num(); BoneIndex++)
+		{
+			SPEC_TEST_EQUAL(Hierarchy.GetParentIndex(BoneIndex), ReferenceSkeleton.GetParentIndex(BoneIndex));
+			SPEC_TEST_EQUAL(Hierarchy.GetDepth(BoneIndex), ReferenceSkeleton.GetDepthBetweenBones(BoneIndex, 0));
+		}
+		SPEC_TEST_EQUAL(Hierarchy.GetSubtreeSize(0), NumTestBones);
+	});
+
+	Describe("IsAncestorOf", [this]() {
+		It("should match the bone chains of all bones", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			int32 NumMismatches = 0;
+			for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex++)
+			{
+				const TArray<int32> Ancestors =
+					ToArray(TBoneChainRange(ReferenceSkeleton, BoneIndex, EBoneChainLeaf::Exclude));
+				for (int32 OtherIndex = 0; OtherIndex < NumTestBones; OtherIndex++)
+				{
+					if (Hierarchy.IsAncestorOf(OtherIndex, BoneIndex) != Ancestors.Contains(OtherIndex))
+					{
+						NumMismatches++;
+					}
+				}
+			}
+			SPEC_TEST_EQUAL(NumMismatches, 0);
+		});
+
+		It("should not treat bones as their own ancestors", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			SPEC_TEST_FALSE(Hierarchy.IsAncestorOf(0, 0));
+			SPEC_TEST_TRUE(Hierarchy.IsSameOrAncestorOf(0, 0));
+		});
+
+		It("should not report ancestors across separate root bones", [this]() {
+			FBoneHierarchyAccelerator Hierarchy;
+			Hierarchy.Build(TArray<int32>{INDEX_NONE, 0, INDEX_NONE, 2, 3});
+			SPEC_TEST_TRUE(Hierarchy.IsAncestorOf(0, 1));
+			SPEC_TEST_TRUE(Hierarchy.IsAncestorOf(2, 4));
+			SPEC_TEST_FALSE(Hierarchy.IsAncestorOf(0, 3));
+			SPEC_TEST_FALSE(Hierarchy.IsAncestorOf(1, 2));
+			SPEC_TEST_EQUAL(Hierarchy.GetDepth(4), 2);
+		});
+	});
+
+	Describe("GetAncestorAtDepth", [this]() {
+		It("should return the bone at the given depth of the bone chain", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			int32 NumMismatches = 0;
+			for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex++)
+			{
+				const TArray<int32> Chain = ToArray(TBoneChainRange(ReferenceSkeleton, BoneIndex));
+				for (int32 Depth = 0; Depth < Chain.Num(); Depth++)
+				{
+					if (Hierarchy.GetAncestorAtDepth(BoneIndex, Depth) != Chain[Depth])
+					{
+						NumMismatches++;
+					}
+				}
+				SPEC_TEST_EQUAL(Hierarchy.GetAncestorAtDepth(BoneIndex, Chain.Num()), INDEX_NONE);
+			}
+			SPEC_TEST_EQUAL(NumMismatches, 0);
+		});
+	});
+
+	Describe("GetBoneChain", [this]() {
+		It("should contain the same bones as TBoneChainRange in root to leaf order", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex += 7)
+			{
+				SPEC_TEST_ARRAYS_EQUAL(
+					ToArray(Hierarchy.GetBoneChain(BoneIndex)),
+					ToArray(TBoneChainRange(ReferenceSkeleton, BoneIndex)));
+				SPEC_TEST_ARRAYS_EQUAL(
+					ToArray(Hierarchy.GetBoneChain(BoneIndex, EBoneChainLeaf::Exclude)),
+					ToArray(TBoneChainRange(ReferenceSkeleton, BoneIndex, EBoneChainLeaf::Exclude)));
+			}
+		});
+
+		It("should contain the same bones as TBoneChainRange in leaf to root order", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			constexpr auto LeafToRoot = EBoneChainDirection::LeafToRoot;
+			for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex += 7)
+			{
+				SPEC_TEST_ARRAYS_EQUAL(
+					ToArray(Hierarchy.GetBoneChain<LeafToRoot>(BoneIndex)),
+					ToArray(TBoneChainRange<LeafToRoot>(ReferenceSkeleton, BoneIndex)));
+				SPEC_TEST_ARRAYS_EQUAL(
+					ToArray(Hierarchy.GetBoneChain<LeafToRoot>(BoneIndex, EBoneChainLeaf::Exclude)),
+					ToArray(TBoneChainRange<LeafToRoot>(ReferenceSkeleton, BoneIndex, EBoneChainLeaf::Exclude)));
+			}
+		});
+
+		It("should support random access in iteration order", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			const int32 LeafIndex = NumTestBones - 1;
+			const auto Chain = Hierarchy.GetBoneChain<EBoneChainDirection::LeafToRoot>(LeafIndex);
+			if (SPEC_TEST_EQUAL(Chain.Num(), Hierarchy.GetDepth(LeafIndex) + 1))
+			{
+				SPEC_TEST_EQUAL(Chain[0], LeafIndex);
+				SPEC_TEST_EQUAL(Chain[1], Hierarchy.GetParentIndex(LeafIndex));
+				SPEC_TEST_EQUAL(Chain[Chain.Num() - 1], 0);
+			}
+		});
+
+		It("should be empty when excluding the leaf of a root bone", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+			SPEC_TEST_TRUE(Hierarchy.GetBoneChain(0, EBoneChainLeaf::Exclude).IsEmpty());
+		});
+	});
+
+	It("should answer ancestor queries faster than iterating bone chains", [this]() {
+		constexpr int32 CandidateStride = 5;
+
+		const double BuildStartTime = FPlatformTime::Seconds();
+		const FBoneHierarchyAccelerator Hierarchy(ReferenceSkeleton);
+		const double BuildTime = FPlatformTime::Seconds() - BuildStartTime;
+
+		int32 NumAcceleratedAncestors = 0;
+		const double AcceleratedStartTime = FPlatformTime::Seconds();
+		for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex++)
+		{
+			for (int32 CandidateIndex = 0; CandidateIndex < NumTestBones; CandidateIndex += CandidateStride)
+			{
+				NumAcceleratedAncestors += Hierarchy.IsAncestorOf(CandidateIndex, BoneIndex) ? 1 : 0;
+			}
+		}
+		const double AcceleratedTime = FPlatformTime::Seconds() - AcceleratedStartTime;
+
+		int32 NumChainAncestors = 0;
+		const double ChainStartTime = FPlatformTime::Seconds();
+		for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex++)
+		{
+			for (int32 CandidateIndex = 0; CandidateIndex < NumTestBones; CandidateIndex += CandidateStride)
+			{
+				for (const int32 ParentIndex : TBoneChainRange(ReferenceSkeleton, BoneIndex, EBoneChainLeaf::Exclude))
+				{
+					if (ParentIndex == CandidateIndex)
+					{
+						NumChainAncestors++;
+						break;
+					}
+				}
+			}
+		}
+		const double ChainTime = FPlatformTime::Seconds() - ChainStartTime;
+
+		SPEC_TEST_EQUAL(NumAcceleratedAncestors, NumChainAncestors);
+		AddInfo(FString::Printf(
+			TEXT("%i ancestor checks on %i bones: accelerator %.3f ms (+%.3f ms build), bone chain ranges %.3f ms"),
+			NumTestBones * (NumTestBones / CandidateStride),
+			NumTestBones,
+			AcceleratedTime * 1000.0,
+			BuildTime * 1000.0,
+			ChainTime * 1000.0));
+	});
+}
+
+#endif
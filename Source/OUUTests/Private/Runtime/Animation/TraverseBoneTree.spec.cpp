@@ -0,0 +1,184 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Animation/TraverseBoneTree.h"
+
+	#include <atomic>
+
+using namespace OUU::Runtime::Animation;
+
+BEGIN_DEFINE_SPEC(
+	FTraverseBoneTreeSpec,
+	"OpenUnrealUtilities.Runtime.Animation.TraverseBoneTree",
+	DEFAULT_OUU_TEST_FLAGS)
+	static constexpr int32 NumTestBones = 300;
+	USkeleton* Skeleton = nullptr;
+
+	/** Create a skeleton with a random tree in which each bone is attached to one of the previous 8 bones. */
+	void BuildTestSkeleton()
+	{
+		Skeleton = NewObject<USkeleton>(GetTransientPackage());
+		FReferenceSkeletonModifier Modifier(Skeleton);
+		FRandomStream RandomStream(42);
+		for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex++)
+		{
+			const int32 ParentIndex =
+				BoneIndex == 0 ? INDEX_NONE : RandomStream.RandRange(FMath::Max(0, BoneIndex - 8), BoneIndex - 1);
+			const FString BoneName = FString::Printf(TEXT("Bone_%i"), BoneIndex);
+			Modifier.Add(FMeshBoneInfo(*BoneName, BoneName, ParentIndex), FTransform::Identity);
+		}
+	}
+
+	/** Skip the children of every 7th bone */
+	static ETraverseBoneTreeAction SkipSomeBones(int32 BoneIndex)
+	{
+		return (BoneIndex % 7 == 6) ? ETraverseBoneTreeAction::SkipChildBones
+									: ETraverseBoneTreeAction::ContinueWithChildBones;
+	}
+
+	/** Values that depend on the values of all parent bones, so they can only be computed root to leaf */
+	static int32 ComputeValue(const TArray<int32>& Values, int32 ParentIndex, int32 BoneIndex)
+	{
+		return (ParentIndex == INDEX_NONE ? 0 : Values[ParentIndex] * 31) + BoneIndex;
+	}
+END_DEFINE_SPEC(FTraverseBoneTreeSpec)
+void FTraverseBoneTreeSpec::Define()
+{
+	BeforeEach([this]() { BuildTestSkeleton(); });
+
+	AfterEach([this]() { Skeleton = nullptr; });
+
+	Describe("TraverseBoneTree", [this]() {
+		It("should visit the bones of a bone hierarchy in the same order as the bones of the skeleton", [this]() {
+			TArray<int32> SkeletonOrder, HierarchyOrder;
+			TraverseBoneTree(Skeleton, [&](int32 BoneIndex) {
+				SkeletonOrder.Add(BoneIndex);
+				return SkipSomeBones(BoneIndex);
+			});
+			const FBoneHierarchyAccelerator Hierarchy(Skeleton->GetReferenceSkeleton());
+			TraverseBoneTree(Hierarchy, [&](int32 BoneIndex) {
+				HierarchyOrder.Add(BoneIndex);
+				return SkipSomeBones(BoneIndex);
+			});
+			SPEC_TEST_ARRAYS_EQUAL(SkeletonOrder, HierarchyOrder);
+		});
+	});
+
+	Describe("ParallelTraverseBoneTree", [this]() {
+		It("should visit the same bones as the serial traversal", [this]() {
+			TArray<int32> SerialVisits, ParallelVisits;
+			SerialVisits.SetNumZeroed(NumTestBones);
+			ParallelVisits.SetNumZeroed(NumTestBones);
+
+			TraverseBoneTree(Skeleton, [&](int32 BoneIndex) {
+				SerialVisits[BoneIndex]++;
+				return SkipSomeBones(BoneIndex);
+			});
+			ParallelTraverseBoneTree(Skeleton, [&](int32 BoneIndex) {
+				ParallelVisits[BoneIndex]++;
+				return SkipSomeBones(BoneIndex);
+			});
+
+			SPEC_TEST_ARRAYS_EQUAL(SerialVisits, ParallelVisits);
+		});
+
+		It("should process parent bones before their children", [this]() {
+			const FReferenceSkeleton& ReferenceSkeleton = Skeleton->GetReferenceSkeleton();
+			TArray<int32> SerialValues, ParallelValues;
+			SerialValues.Init(INDEX_NONE, NumTestBones);
+			ParallelValues.Init(INDEX_NONE, NumTestBones);
+
+			TraverseBoneTree(Skeleton, [&](int32 BoneIndex) {
+				const int32 ParentIndex = ReferenceSkeleton.GetParentIndex(BoneIndex);
+				SerialValues[BoneIndex] = ComputeValue(SerialValues, ParentIndex, BoneIndex);
+				return ETraverseBoneTreeAction::ContinueWithChildBones;
+			});
+
+			std::atomic<bool> bParentWasProcessed = true;
+			ParallelTraverseBoneTree(Skeleton, [&](int32 BoneIndex) {
+				const int32 ParentIndex = ReferenceSkeleton.GetParentIndex(BoneIndex);
+				if (ParentIndex != INDEX_NONE && ParallelValues[ParentIndex] == INDEX_NONE)
+				{
+					bParentWasProcessed = false;
+				}
+				ParallelValues[BoneIndex] = ComputeValue(ParallelValues, ParentIndex, BoneIndex);
+				return ETraverseBoneTreeAction::ContinueWithChildBones;
+			});
+
+			SPEC_TEST_TRUE(bParentWasProcessed.load());
+			SPEC_TEST_ARRAYS_EQUAL(SerialValues, ParallelValues);
+		});
+
+		It("should produce the same results on every run", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(Skeleton->GetReferenceSkeleton());
+			auto RunTraversal = [&Hierarchy](EParallelForFlags Flags) {
+				TArray<int32> Values;
+				Values.Init(INDEX_NONE, NumTestBones);
+				ParallelTraverseBoneTree(
+					Hierarchy,
+					[&](int32 BoneIndex) {
+						Values[BoneIndex] = ComputeValue(Values, Hierarchy.GetParentIndex(BoneIndex), BoneIndex);
+						return SkipSomeBones(BoneIndex);
+					},
+					ROOT_BONE_IDX,
+					Flags);
+				return Values;
+			};
+
+			const TArray<int32> SingleThreadValues = RunTraversal(EParallelForFlags::ForceSingleThread);
+			for (int32 Run = 0; Run < 5; Run++)
+			{
+				SPEC_TEST_ARRAYS_EQUAL(RunTraversal(EParallelForFlags::None), SingleThreadValues);
+			}
+		});
+
+		It("should not visit bones below the depth at which the traversal was stopped", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(Skeleton->GetReferenceSkeleton());
+			constexpr int32 StopBoneIndex = 20;
+			const int32 StopDepth = Hierarchy.GetDepth(StopBoneIndex);
+
+			TArray<int32> Visits;
+			Visits.SetNumZeroed(NumTestBones);
+			ParallelTraverseBoneTree(Hierarchy, [&](int32 BoneIndex) {
+				Visits[BoneIndex]++;
+				return BoneIndex == StopBoneIndex ? ETraverseBoneTreeAction::Stop
+												  : ETraverseBoneTreeAction::ContinueWithChildBones;
+			});
+
+			int32 NumInvalidVisits = 0;
+			for (int32 BoneIndex = 0; BoneIndex < NumTestBones; BoneIndex++)
+			{
+				const bool bShouldBeVisited = Hierarchy.GetDepth(BoneIndex) <= StopDepth;
+				NumInvalidVisits += (Visits[BoneIndex] == (bShouldBeVisited ? 1 : 0)) ? 0 : 1;
+			}
+			SPEC_TEST_EQUAL(NumInvalidVisits, 0);
+		});
+
+		It("should only visit the subtree of the start bone", [this]() {
+			const FBoneHierarchyAccelerator Hierarchy(Skeleton->GetReferenceSkeleton());
+			constexpr int32 StartBoneIndex = 10;
+
+			std::atomic<int32> NumVisits = 0;
+			std::atomic<int32> NumVisitsOutsideSubtree = 0;
+			ParallelTraverseBoneTree(
+				Hierarchy,
+				[&](int32 BoneIndex) {
+					++NumVisits;
+					if (!Hierarchy.IsSameOrAncestorOf(StartBoneIndex, BoneIndex))
+					{
+						++NumVisitsOutsideSubtree;
+					}
+					return ETraverseBoneTreeAction::ContinueWithChildBones;
+				},
+				StartBoneIndex);
+
+			SPEC_TEST_EQUAL(NumVisits.load(), Hierarchy.GetSubtreeSize(StartBoneIndex));
+			SPEC_TEST_EQUAL(NumVisitsOutsideSubtree.load(), 0);
+		});
+	});
+}
+
+#endif
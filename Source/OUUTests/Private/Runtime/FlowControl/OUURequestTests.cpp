@@ -183,6 +183,78 @@ OUU_IMPLEMENT_SIMPLE_AUTOMATION_TEST(OnStatusChanged, DEFAULT_OUU_TEST_FLAGS)
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+OUU_IMPLEMENT_SIMPLE_AUTOMATION_TEST(StateEnterTimes, DEFAULT_OUU_TEST_FLAGS)
+{
+	// Arrange
+	const FOUURequestTestEnvironment Env;
+	Env.Request->bResetAfterCompletion = true;
+
+	// Act
+	Env.Request->Raise();
+	Env.Request->Cancel();
+	Env.Request->Raise();
+	Env.Request->Complete(true);
+
+	// Assert
+	const double PendingTime = Env.Request->GetStateEnterTime(EOUURequestState::Pending);
+	const double SuccessfulTime = Env.Request->GetStateEnterTime(EOUURequestState::Successful);
+	TestTrue("Pending time was recorded", PendingTime > 0.0);
+	TestTrue("Successful time is after pending time", SuccessfulTime >= PendingTime);
+	const double IdleTime = Env.Request->GetStateEnterTime(EOUURequestState::Idle);
+	TestTrue("Idle time is after successful time", IdleTime >= SuccessfulTime);
+	TestEqual("Canceled time of the previous raise", Env.Request->GetStateEnterTime(EOUURequestState::Canceled), 0.0);
+	TestEqual("Latency", Env.Request->GetLatency(), SuccessfulTime - PendingTime);
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+OUU_IMPLEMENT_SIMPLE_AUTOMATION_TEST(RaiseAndWaitNative, DEFAULT_OUU_TEST_FLAGS)
+{
+	// Arrange
+	const FOUURequestTestEnvironment Env;
+	Env.Request->bResetAfterCompletion = true;
+	TArray<EOUURequestState> CallbackStates;
+	auto Callback = FOnRequestStatusChangedNative::FDelegate::CreateLambda(
+		[&CallbackStates](UOUURequest* Request, EOUURequestState State) { CallbackStates.Add(State); });
+
+	// Act
+	Env.Request->RaiseAndWaitNative(Callback);
+	Env.Request->Complete(false);
+	Env.Request->Raise();
+	Env.Request->Complete(true);
+
+	// Assert
+	TestArraysEqual(*this, "Callback states", CallbackStates, TArray<EOUURequestState>{EOUURequestState::Failed});
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+OUU_IMPLEMENT_SIMPLE_AUTOMATION_TEST(IsValidStateTransition, DEFAULT_OUU_TEST_FLAGS)
+{
+	TestTrue("Idle -> Pending", UOUURequest::IsValidStateTransition(EOUURequestState::Idle, EOUURequestState::Pending));
+	TestFalse(
+		"Idle -> Successful",
+		UOUURequest::IsValidStateTransition(EOUURequestState::Idle, EOUURequestState::Successful));
+	TestTrue(
+		"Pending -> Canceled",
+		UOUURequest::IsValidStateTransition(EOUURequestState::Pending, EOUURequestState::Canceled));
+	TestFalse(
+		"Pending -> Idle",
+		UOUURequest::IsValidStateTransition(EOUURequestState::Pending, EOUURequestState::Idle));
+	TestTrue("Failed -> Idle", UOUURequest::IsValidStateTransition(EOUURequestState::Failed, EOUURequestState::Idle));
+	TestFalse(
+		"Failed -> Successful",
+		UOUURequest::IsValidStateTransition(EOUURequestState::Failed, EOUURequestState::Successful));
+
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Request Queue tests
 //////////////////////////////////////////////////////////////////////////
@@ -381,6 +453,33 @@ OUU_IMPLEMENT_COMPLEX_AUTOMATION_TEST_END(RaiseRequest_Complete)
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+OUU_IMPLEMENT_SIMPLE_AUTOMATION_TEST(LatencyHistogram, DEFAULT_OUU_TEST_FLAGS)
+{
+	// Arrange
+	UOUURequestQueue* RequestQueue = NewObject<UOUURequestQueue>();
+	RequestQueue->bRecordLatencyHistogram = true;
+	RequestQueue->LatencyHistogramNumSamples = 2;
+
+	// Act
+	RequestQueue->RaiseNewRequest()->Complete(true);
+	RequestQueue->RaiseNewRequest()->Cancel();
+	RequestQueue->RaiseNewRequest()->Complete(false);
+	RequestQueue->RaiseNewRequest()->Complete(true);
+
+	// Assert
+	const TCircularHistogramAggregator<double>* LatencyHistogram = RequestQueue->GetLatencyHistogram();
+	if (TestNotNull("LatencyHistogram", LatencyHistogram))
+	{
+		// Canceled requests are not recorded and the histogram only keeps the most recent samples
+		TestEqual("Num recorded latencies", LatencyHistogram->Num(), 2);
+		TestTrue("Median latency is inside the histogram range", LatencyHistogram->Median() < 1.0);
+	}
+
+	return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 	#undef OUU_TEST_CATEGORY
@@ -0,0 +1,205 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "GameplayTags/SampleGameplayTags.h"
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "AutomationTestWorld.h"
+	#include "GameplayAbilities/OUUAbilitySystemComponent.h"
+	#include "HAL/FileManager.h"
+	#include "Misc/FileHelper.h"
+	#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(
+	FOUUAbilitySystemComponentSpec,
+	"OpenUnrealUtilities.Runtime.GameplayAbilities.OUUAbilitySystemComponent",
+	DEFAULT_OUU_TEST_FLAGS)
+	/** Number of events sent in each test. Must be larger than the history size. */
+	static constexpr int32 NumEvents = 173;
+
+	/** Independent record of all sent events to compute the expected query results. */
+	struct FSentEvent
+	{
+		int32 EventNumber;
+		FGameplayTag EventTag;
+		const AActor* Instigator;
+	};
+
+	TSharedPtr<FOUUAutomationTestWorld> TestWorld;
+	UOUUAbilitySystemComponent* AbilitySystem = nullptr;
+	AActor* InstigatorA = nullptr;
+	AActor* InstigatorB = nullptr;
+	AActor* EvictedInstigator = nullptr;
+	TArray<FSentEvent> SentEvents;
+
+	void SendEvent(const FGameplayTag& EventTag, const AActor* Instigator)
+	{
+		FGameplayEventData Payload;
+		Payload.EventTag = EventTag;
+		Payload.Instigator = Instigator;
+		AbilitySystem->HandleGameplayEvent(EventTag, &Payload);
+		SentEvents.Add({SentEvents.Num() + 1, EventTag, Instigator});
+	}
+
+	/**
+	 * The first event uses a tag and instigator that are never used again, so they are only referenced by events that
+	 * were evicted from the history at the end. The other events cycle through parent and child tags.
+	 */
+	void SendAllEvents()
+	{
+		SendEvent(FSampleGameplayTags::Baz::Get(), EvictedInstigator);
+		const TArray<FGameplayTag> Tags = {
+			FSampleGameplayTags::Bar::Get(),
+			FSampleGameplayTags::Bar::Beta::Get(),
+			FSampleGameplayTags::Bar::Gamma::Get(),
+			FSampleGameplayTags::Foo::Get()};
+		for (int32 i = 1; i < NumEvents; i++)
+		{
+			SendEvent(Tags[i % Tags.Num()], (i % 3 == 0) ? InstigatorB : InstigatorA);
+		}
+	}
+
+	/** @returns the number of events in the history */
+	int32 GetHistorySize() const { return AbilitySystem->QueryGameplayEventHistory({}).Num(); }
+
+	TArray<int32> QueryEventNumbers(const FOUUGameplayEventHistoryQuery& Query) const
+	{
+		TArray<int32> Result;
+		for (const FOUUGameplayEventData* Event : AbilitySystem->QueryGameplayEventHistory(Query))
+		{
+			Result.Add(Event->EventNumber);
+		}
+		return Result;
+	}
+
+	/** @returns the event numbers of the newest events that are expected to still be in the history */
+	TArray<int32> GetExpectedEventNumbers(TFunctionRef<bool(const FSentEvent&)> Predicate) const
+	{
+		TArray<int32> Result;
+		const int32 FirstRemainingEventNumber = SentEvents.Num() - GetHistorySize() + 1;
+		for (const FSentEvent& Event : SentEvents)
+		{
+			if (Event.EventNumber >= FirstRemainingEventNumber && Predicate(Event))
+			{
+				Result.Add(Event.EventNumber);
+			}
+		}
+		return Result;
+	}
+END_DEFINE_SPEC(FOUUAbilitySystemComponentSpec)
+
+void FOUUAbilitySystemComponentSpec::Define()
+{
+	BeforeEach([this]() {
+		TestWorld = MakeShared<FOUUAutomationTestWorld>("FOUUAbilitySystemComponentSpec");
+		TestWorld->CreateWorld("GameplayEventHistory");
+		InstigatorA = TestWorld->World->SpawnActor<AActor>();
+		InstigatorB = TestWorld->World->SpawnActor<AActor>();
+		EvictedInstigator = TestWorld->World->SpawnActor<AActor>();
+		AbilitySystem = NewObject<UOUUAbilitySystemComponent>(InstigatorA);
+		SendAllEvents();
+	});
+
+	AfterEach([this]() {
+		SentEvents.Reset();
+		AbilitySystem = nullptr;
+		InstigatorA = nullptr;
+		InstigatorB = nullptr;
+		EvictedInstigator = nullptr;
+		TestWorld->DestroyWorld();
+		TestWorld.Reset();
+	});
+
+	Describe("QueryGameplayEventHistory", [this]() {
+		It("should only keep the newest events once the history is full", [this]() {
+			const int32 HistorySize = GetHistorySize();
+			SPEC_TEST_TRUE(HistorySize > 0);
+			SPEC_TEST_TRUE(HistorySize < NumEvents);
+
+			const TArray<int32> Expected = GetExpectedEventNumbers([](const FSentEvent&) { return true; });
+			SPEC_TEST_ARRAYS_EQUAL(QueryEventNumbers({}), Expected);
+		});
+
+		It("should remove evicted events from the tag index", [this]() {
+			FOUUGameplayEventHistoryQuery ExactQuery;
+			ExactQuery.EventTag = FSampleGameplayTags::Baz::Get();
+			ExactQuery.bExactTagMatch = true;
+			SPEC_TEST_EQUAL(QueryEventNumbers(ExactQuery).Num(), 0);
+
+			FOUUGameplayEventHistoryQuery ChildTagQuery;
+			ChildTagQuery.EventTag = FSampleGameplayTags::Baz::Get();
+			SPEC_TEST_EQUAL(QueryEventNumbers(ChildTagQuery).Num(), 0);
+		});
+
+		It("should remove evicted events from the instigator index", [this]() {
+			FOUUGameplayEventHistoryQuery Query;
+			Query.Instigator = EvictedInstigator;
+			SPEC_TEST_EQUAL(QueryEventNumbers(Query).Num(), 0);
+		});
+
+		It("should only return events with exactly the same tag for exact tag queries", [this]() {
+			FOUUGameplayEventHistoryQuery Query;
+			Query.EventTag = FSampleGameplayTags::Bar::Get();
+			Query.bExactTagMatch = true;
+
+			const TArray<int32> Expected = GetExpectedEventNumbers(
+				[](const FSentEvent& Event) { return Event.EventTag == FSampleGameplayTags::Bar::Get(); });
+			SPEC_TEST_TRUE(Expected.Num() > 0);
+			SPEC_TEST_ARRAYS_EQUAL(QueryEventNumbers(Query), Expected);
+		});
+
+		It("should return events with child tags in chronological order for non-exact tag queries", [this]() {
+			FOUUGameplayEventHistoryQuery Query;
+			Query.EventTag = FSampleGameplayTags::Bar::Get();
+
+			const TArray<int32> Expected = GetExpectedEventNumbers(
+				[](const FSentEvent& Event) { return Event.EventTag.MatchesTag(FSampleGameplayTags::Bar::Get()); });
+			const TArray<int32> ExactTagEventNumbers = GetExpectedEventNumbers(
+				[](const FSentEvent& Event) { return Event.EventTag == FSampleGameplayTags::Bar::Get(); });
+			SPEC_TEST_TRUE(Expected.Num() > ExactTagEventNumbers.Num());
+			SPEC_TEST_ARRAYS_EQUAL(QueryEventNumbers(Query), Expected);
+		});
+
+		It("should only return events of the given instigator", [this]() {
+			FOUUGameplayEventHistoryQuery Query;
+			Query.Instigator = InstigatorB;
+
+			const TArray<int32> Expected =
+				GetExpectedEventNumbers([this](const FSentEvent& Event) { return Event.Instigator == InstigatorB; });
+			SPEC_TEST_TRUE(Expected.Num() > 0);
+			SPEC_TEST_ARRAYS_EQUAL(QueryEventNumbers(Query), Expected);
+		});
+
+		It("should combine instigator and tag filters", [this]() {
+			FOUUGameplayEventHistoryQuery Query;
+			Query.Instigator = InstigatorA;
+			Query.EventTag = FSampleGameplayTags::Bar::Get();
+
+			const TArray<int32> Expected = GetExpectedEventNumbers([this](const FSentEvent& Event) {
+				return Event.Instigator == InstigatorA && Event.EventTag.MatchesTag(FSampleGameplayTags::Bar::Get());
+			});
+			SPEC_TEST_TRUE(Expected.Num() > 0);
+			SPEC_TEST_ARRAYS_EQUAL(QueryEventNumbers(Query), Expected);
+		});
+	});
+
+	Describe("DumpGameplayEventHistoryToFile", [this]() {
+		It("should write a CSV row for each event matching the query", [this]() {
+			FOUUGameplayEventHistoryQuery Query;
+			Query.Instigator = InstigatorB;
+			const FString FilePath =
+				FPaths::AutomationTransientDir() / TEXT("OUUAbilitySystemComponentSpec_EventHistory.csv");
+
+			SPEC_TEST_TRUE(AbilitySystem->DumpGameplayEventHistoryToFile(Query, FilePath, false));
+			TArray<FString> Lines;
+			FFileHelper::LoadFileToStringArray(Lines, *FilePath);
+			IFileManager::Get().Delete(*FilePath);
+
+			// Header row + one row per event
+			SPEC_TEST_EQUAL(Lines.Num(), QueryEventNumbers(Query).Num() + 1);
+		});
+	});
+}
+
+#endif
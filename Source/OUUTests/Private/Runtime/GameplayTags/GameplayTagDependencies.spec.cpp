@@ -18,6 +18,21 @@ BEGIN_DEFINE_SPEC(
 	UGameplayTagDependency_TestObject* ObjectC; // depends on B + B2
 	// -- for event tests only
 	UGameplayTagDependency_TestEventHandler* EventHandler;
+
+	static bool SourceMapsEqual(
+		const TMap<FGameplayTag, TSet<const UObject*>>& A,
+		const TMap<FGameplayTag, TSet<const UObject*>>& B)
+	{
+		if (A.Num() != B.Num())
+			return false;
+		for (auto& EntryA : A)
+		{
+			const TSet<const UObject*>* SourcesB = B.Find(EntryA.Key);
+			if (!SourcesB || SourcesB->Num() != EntryA.Value.Num() || !SourcesB->Includes(EntryA.Value))
+				return false;
+		}
+		return true;
+	}
 END_DEFINE_SPEC(FTagDependenciesSpec)
 
 void FTagDependenciesSpec::Define()
@@ -33,6 +48,32 @@ void FTagDependenciesSpec::Define()
 		ObjectC->AddDependency(ObjectB2);
 	});
 
+	Describe("AddDependency", [this]() {
+		It("should reject self dependencies and dependencies that close a cycle", [this]() {
+			// Ensures may log the message multiple times (message + callstack), so expect any number of occurrences
+			AddExpectedError(
+				TEXT("Rejected cyclic gameplay tag dependency"),
+				EAutomationExpectedErrorFlags::Contains,
+				0);
+			ObjectA->AddDependency(ObjectA);
+			ObjectA->AddDependency(ObjectC);
+
+			ObjectA->SourceContainer.AddTag(FSampleGameplayTags::Foo::Get());
+			ObjectA->BroadcastTagsChanged();
+			SPEC_TEST_ARRAYS_EQUAL(
+				ObjectA->GetOriginalTagSources(FSampleGameplayTags::Foo::Get()),
+				TArray<const UObject*>{ObjectA});
+			SPEC_TEST_ARRAYS_EQUAL(
+				ObjectC->GetOriginalTagSources(FSampleGameplayTags::Foo::Get()),
+				TArray<const UObject*>{ObjectA});
+
+			TMap<FGameplayTag, TSet<const UObject*>> Maintained, Recomputed;
+			ObjectA->GetOriginalTagSources(OUT Maintained);
+			ObjectA->RecomputeOriginalTagSources(OUT Recomputed);
+			SPEC_TEST_TRUE(SourceMapsEqual(Maintained, Recomputed));
+		});
+	});
+
 	Describe("BroadcastTagsChanged", [this]() {
 		It("should allow propagating tag changes", [this]() {
 			ObjectA->SourceContainer.AddTag(FSampleGameplayTags::Foo::Get());
@@ -215,6 +256,88 @@ void FTagDependenciesSpec::Define()
 				}
 			}
 		});
+
+		It("should update the sources when dependencies are added or removed", [this]() {
+			ObjectA->SourceContainer.AddTag(FSampleGameplayTags::Foo::Get());
+			ObjectA->BroadcastTagsChanged();
+			ObjectB2->SourceContainer.AddTag(FSampleGameplayTags::Foo::Get());
+			ObjectB2->BroadcastTagsChanged();
+
+			SPEC_TEST_EQUAL(ObjectC->GetOriginalTagSources(FSampleGameplayTags::Foo::Get()).Num(), 2);
+
+			ObjectC->RemoveDependency(ObjectB);
+			SPEC_TEST_ARRAYS_EQUAL(
+				ObjectC->GetOriginalTagSources(FSampleGameplayTags::Foo::Get()),
+				TArray<const UObject*>{ObjectB2});
+
+			ObjectC->RemoveDependency(ObjectB2);
+			SPEC_TEST_EQUAL(ObjectC->GetOriginalTagSources(FSampleGameplayTags::Foo::Get()).Num(), 0);
+
+			ObjectB2->AddDependency(ObjectA);
+			ObjectC->AddDependency(ObjectB2);
+			SPEC_TEST_EQUAL(ObjectC->GetOriginalTagSources(FSampleGameplayTags::Foo::Get()).Num(), 2);
+		});
+
+		It("should match the recomputed sources after random graph edits", [this]() {
+			const TArray<FGameplayTag> Tags = {
+				FSampleGameplayTags::Foo::Get(),
+				FSampleGameplayTags::Bar::Get(),
+				FSampleGameplayTags::Bar::Beta::Get(),
+				FSampleGameplayTags::Baz::Get()};
+
+			// Objects only depend on objects with lower index to keep the graph acyclic
+			TArray<UGameplayTagDependency_TestObject*> Objects = {ObjectA, ObjectB, ObjectB2, ObjectC};
+			TArray<TPair<int32, int32>> Edges = {MakeTuple(1, 0), MakeTuple(3, 1), MakeTuple(3, 2)};
+			for (int32 i = 0; i < 6; i++)
+			{
+				Objects.Add(NewObject<UGameplayTagDependency_TestObject>());
+			}
+
+			FRandomStream RandomStream(1234);
+			int32 NumMismatches = 0;
+			for (int32 Step = 0; Step < 300; Step++)
+			{
+				const int32 Operation = RandomStream.RandRange(0, 2);
+				if (Operation == 0)
+				{
+					// Duplicate edges are allowed and removed together
+					const int32 Dependant = RandomStream.RandRange(1, Objects.Num() - 1);
+					const int32 Dependency = RandomStream.RandRange(0, Dependant - 1);
+					Objects[Dependant]->AddDependency(Objects[Dependency]);
+					Edges.Add(MakeTuple(Dependant, Dependency));
+				}
+				else if (Operation == 1 && Edges.Num() > 0)
+				{
+					const TPair<int32, int32> Edge = Edges[RandomStream.RandRange(0, Edges.Num() - 1)];
+					Objects[Edge.Key]->RemoveDependency(Objects[Edge.Value]);
+					Edges.Remove(Edge);
+				}
+				else
+				{
+					UGameplayTagDependency_TestObject* Object =
+						Objects[RandomStream.RandRange(0, Objects.Num() - 1)];
+					const FGameplayTag Tag = Tags[RandomStream.RandRange(0, Tags.Num() - 1)];
+					if (Object->SourceContainer.HasTagExact(Tag))
+					{
+						Object->SourceContainer.RemoveTag(Tag);
+					}
+					else
+					{
+						Object->SourceContainer.AddTag(Tag);
+					}
+					Object->BroadcastTagsChanged();
+				}
+
+				for (const UGameplayTagDependency_TestObject* Object : Objects)
+				{
+					TMap<FGameplayTag, TSet<const UObject*>> Maintained, Recomputed;
+					Object->GetOriginalTagSources(OUT Maintained);
+					Object->RecomputeOriginalTagSources(OUT Recomputed);
+					NumMismatches += SourceMapsEqual(Maintained, Recomputed) ? 0 : 1;
+				}
+			}
+			SPEC_TEST_EQUAL(NumMismatches, 0);
+		});
 	});
 }
 
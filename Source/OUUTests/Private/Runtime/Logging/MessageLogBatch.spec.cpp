@@ -0,0 +1,200 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Logging/MessageLogBatch.h"
+	#include "Misc/UObjectToken.h"
+
+BEGIN_DEFINE_SPEC(FMessageLogBatchSpec, "OpenUnrealUtilities.Runtime.Logging.MessageLogBatch", DEFAULT_OUU_TEST_FLAGS)
+	const FName TestMessageLogName = TEXT("OUUTests");
+
+	static FString GetTokenString(const TSharedRef<FTokenizedMessage>& Message, int32 TokenIdx)
+	{
+		const auto& Tokens = Message->GetMessageTokens();
+		return Tokens.IsValidIndex(TokenIdx) ? Tokens[TokenIdx]->ToText().ToString() : FString();
+	}
+
+	static const IMessageToken* GetTokenPtr(const TSharedRef<FTokenizedMessage>& Message, int32 TokenIdx)
+	{
+		const auto& Tokens = Message->GetMessageTokens();
+		return Tokens.IsValidIndex(TokenIdx) ? &Tokens[TokenIdx].Get() : nullptr;
+	}
+END_DEFINE_SPEC(FMessageLogBatchSpec)
+void FMessageLogBatchSpec::Define()
+{
+	Describe("AddMessage", [this]() {
+		It("should count all messages including duplicates", [this]() {
+			FMessageLogBatch Batch(TestMessageLogName, INVTEXT("Test"));
+			Batch.Add(EMessageLogSeverity::Error, TEXT("Foo"));
+			Batch.Add(EMessageLogSeverity::Error, TEXT("Foo"));
+			Batch.Add(EMessageLogSeverity::Warning, TEXT("Foo"));
+			SPEC_TEST_EQUAL(Batch.Num(), 3);
+			SPEC_TEST_EQUAL(Batch.NumUniqueMessages(), 2);
+			SPEC_TEST_EQUAL(Batch.NumWithSeverity(EMessageLogSeverity::Error), 2);
+			SPEC_TEST_EQUAL(Batch.NumWithSeverity(EMessageLogSeverity::Warning), 1);
+			Batch.Reset();
+		});
+
+		It("should collapse identical messages into one message with a repeat count", [this]() {
+			FMessageLogBatch Batch(TestMessageLogName, INVTEXT("Test"));
+			for (int32 i = 0; i < 3; i++)
+			{
+				Batch.Add(EMessageLogSeverity::Error, TEXT("Foo"), 42);
+			}
+			const auto Messages = Batch.BuildMessages();
+			if (SPEC_TEST_EQUAL(Messages.Num(), 1))
+			{
+				SPEC_TEST_EQUAL(Messages[0]->GetMessageTokens().Num(), 3);
+				SPEC_TEST_EQUAL(GetTokenString(Messages[0], 2), FString(TEXT("(x3)")));
+			}
+			Batch.Reset();
+		});
+	});
+
+	Describe("AddObjectMessage", [this]() {
+		It("should group messages by context object in the order of first occurrence", [this]() {
+			UObject* ObjectA = UObject::StaticClass();
+			UObject* ObjectB = UClass::StaticClass();
+
+			FMessageLogBatch Batch(TestMessageLogName, INVTEXT("Test"));
+			Batch.Add(EMessageLogSeverity::Info, TEXT("No context"));
+			Batch.AddForObject(ObjectA, EMessageLogSeverity::Warning, TEXT("A1"));
+			Batch.AddForObject(ObjectB, EMessageLogSeverity::Error, TEXT("B1"));
+			Batch.AddForObject(ObjectA, EMessageLogSeverity::Error, TEXT("A2"));
+
+			const auto Messages = Batch.BuildMessages();
+			// header A, A1, A2, header B, B1, no context
+			if (SPEC_TEST_EQUAL(Messages.Num(), 6))
+			{
+				SPEC_TEST_EQUAL(Messages[0]->GetSeverity(), EMessageSeverity::Error);
+				SPEC_TEST_EQUAL(GetTokenString(Messages[1], 1), FString(TEXT("A1")));
+				SPEC_TEST_EQUAL(GetTokenString(Messages[2], 1), FString(TEXT("A2")));
+				SPEC_TEST_EQUAL(GetTokenString(Messages[4], 1), FString(TEXT("B1")));
+				SPEC_TEST_EQUAL(GetTokenString(Messages[5], 0), FString(TEXT("No context")));
+			}
+			Batch.Reset();
+		});
+
+		It("should share a single token between all messages referencing the same object", [this]() {
+			UObject* ContextObject = UObject::StaticClass();
+			UObject* ReferencedObject = UClass::StaticClass();
+
+			FMessageLogBatch Batch(TestMessageLogName, INVTEXT("Test"));
+			Batch.AddForObject(ContextObject, EMessageLogSeverity::Error, TEXT("references"), ReferencedObject);
+			Batch.AddForObject(ContextObject, EMessageLogSeverity::Warning, TEXT("references"), ReferencedObject);
+			Batch.Add(EMessageLogSeverity::Info, ReferencedObject);
+			SPEC_TEST_EQUAL(Batch.NumInternedTokens(), 2);
+
+			const auto Messages = Batch.BuildMessages();
+			// header, error, warning, no context
+			if (SPEC_TEST_EQUAL(Messages.Num(), 4))
+			{
+				SPEC_TEST_TRUE(GetTokenPtr(Messages[0], 0) == GetTokenPtr(Messages[1], 0));
+				SPEC_TEST_TRUE(GetTokenPtr(Messages[1], 0) == GetTokenPtr(Messages[2], 0));
+				SPEC_TEST_TRUE(GetTokenPtr(Messages[1], 2) == GetTokenPtr(Messages[2], 2));
+				SPEC_TEST_TRUE(GetTokenPtr(Messages[2], 2) == GetTokenPtr(Messages[3], 0));
+			}
+			Batch.Reset();
+		});
+
+		It("should summarize messages exceeding MaxMessagesPerGroup in a single message", [this]() {
+			FMessageLogBatch Batch(TestMessageLogName, INVTEXT("Test"));
+			Batch.MaxMessagesPerGroup = 2;
+			for (int32 i = 0; i < 5; i++)
+			{
+				Batch.AddForObject(UObject::StaticClass(), EMessageLogSeverity::Warning, i);
+			}
+			Batch.AddForObject(UObject::StaticClass(), EMessageLogSeverity::Warning, 4);
+
+			const auto Messages = Batch.BuildMessages();
+			// header, 2 messages, summary
+			if (SPEC_TEST_EQUAL(Messages.Num(), 4))
+			{
+				SPEC_TEST_EQUAL(
+					GetTokenString(Messages[3], 1),
+					FString(TEXT("... and 3 more unique messages (4 in total)")));
+			}
+			Batch.Reset();
+		});
+	});
+
+	Describe("Commit", [this]() {
+		It("should reset the batch", [this]() {
+			FMessageLogBatch Batch(TestMessageLogName, INVTEXT("Test"));
+			Batch.Add(EMessageLogSeverity::Info, TEXT("Foo"));
+			SPEC_TEST_EQUAL(Batch.Commit(), 1);
+			SPEC_TEST_TRUE(Batch.IsEmpty());
+			SPEC_TEST_EQUAL(Batch.Commit(), 0);
+		});
+
+		It("should report the time to emit 50k messages compared to individual messages", [this]() {
+			constexpr int32 NumMessages = 50000;
+			constexpr int32 NumUniqueTexts = 500;
+			// Creating the individual messages is only measured for a subset and extrapolated
+			constexpr int32 ReferenceStride = 10;
+
+			const TArray<UObject*> ContextObjects = {
+				UObject::StaticClass(),
+				UClass::StaticClass(),
+				UPackage::StaticClass(),
+				UStruct::StaticClass(),
+				UFunction::StaticClass(),
+				GetTransientPackage()};
+			TArray<FText> Texts;
+			for (int32 i = 0; i < NumUniqueTexts; i++)
+			{
+				Texts.Add(FText::FromString(FString::Printf(TEXT("Issue number %i"), i)));
+			}
+			auto GetSeverity = [](int32 i) {
+				return i % 3 == 0 ? EMessageLogSeverity::Error : EMessageLogSeverity::Warning;
+			};
+
+			const double BatchStartTime = FPlatformTime::Seconds();
+			int32 NumCommitted = 0;
+			double BatchTime = 0.0;
+			{
+				FMessageLogBatch Batch(TestMessageLogName, INVTEXT("MessageLogBatch Benchmark"));
+				for (int32 i = 0; i < NumMessages; i++)
+				{
+					UObject* ContextObject = ContextObjects[i % ContextObjects.Num()];
+					Batch.AddForObject(ContextObject, GetSeverity(i), Texts[i % NumUniqueTexts]);
+				}
+				SPEC_TEST_EQUAL(Batch.Num(), NumMessages);
+				NumCommitted = Batch.Commit();
+				BatchTime = FPlatformTime::Seconds() - BatchStartTime;
+			}
+
+			const double ReferenceStartTime = FPlatformTime::Seconds();
+			double ReferenceTime = 0.0;
+			{
+				TArray<TSharedRef<FTokenizedMessage>> ReferenceMessages;
+				for (int32 i = 0; i < NumMessages; i += ReferenceStride)
+				{
+					UObject* ContextObject = ContextObjects[i % ContextObjects.Num()];
+					const TSharedRef<FTokenizedMessage> Message =
+						FTokenizedMessage::Create(static_cast<EMessageSeverity::Type>(GetSeverity(i)));
+					Message->AddToken(FUObjectToken::Create(ContextObject));
+					Message->AddToken(FTextToken::Create(Texts[i % NumUniqueTexts]));
+					ReferenceMessages.Add(Message);
+				}
+				ReferenceTime = (FPlatformTime::Seconds() - ReferenceStartTime) * static_cast<double>(ReferenceStride);
+			}
+
+			// Timings are only reported: They depend on the machine load and are not a pass/fail criterion.
+			AddInfo(FString::Printf(
+				TEXT("Batched %i messages into %i message log lines in %.3f ms (including adding them to the log). "
+					 "Creating one message per issue would take ~%.3f ms (extrapolated, not added to the log)."),
+				NumMessages,
+				NumCommitted,
+				BatchTime * 1000.0,
+				ReferenceTime * 1000.0));
+
+			// 6 context groups with 100 unique messages each (capped), a header and a summary line
+			SPEC_TEST_EQUAL(NumCommitted, ContextObjects.Num() * 102);
+		});
+	});
+}
+
+#endif
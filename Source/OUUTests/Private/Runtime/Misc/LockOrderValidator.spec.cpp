@@ -0,0 +1,141 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "Misc/LockOrderValidator.h"
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER && OUU_WITH_LOCK_ORDER_VALIDATION
+
+	#include "Templates/RWLockedVariable.h"
+	#include "Templates/ScopedMultiRWLock.h"
+
+using namespace OUU::Runtime;
+
+BEGIN_DEFINE_SPEC(
+	FLockOrderValidatorSpec,
+	"OpenUnrealUtilities.Runtime.Misc.LockOrderValidator",
+	DEFAULT_OUU_TEST_FLAGS)
+	TRWLockedVariable<int32> VarA;
+	TRWLockedVariable<int32> VarB;
+	TRWLockedVariable<int32> VarC;
+
+	TArray<FLockOrderViolation> Violations;
+	FLockOrderValidator::FViolationHandler PreviousHandler;
+
+	/** Acquire the write lock of Second while holding the write lock of First */
+	static void LockNested(TRWLockedVariable<int32>& First, TRWLockedVariable<int32>& Second)
+	{
+		auto FirstRef = First.Write();
+		auto SecondRef = Second.Write();
+		SecondRef = FirstRef.Get() + 1;
+	}
+END_DEFINE_SPEC(FLockOrderValidatorSpec)
+
+void FLockOrderValidatorSpec::Define()
+{
+	BeforeEach([this]() {
+		Violations.Reset();
+		FLockOrderValidator::Get().Reset();
+		PreviousHandler = FLockOrderValidator::Get().SetViolationHandler(
+			[this](const FLockOrderViolation& Violation) { Violations.Add(Violation); });
+	});
+
+	AfterEach([this]() {
+		FLockOrderValidator::Get().SetViolationHandler(MoveTemp(PreviousHandler));
+		FLockOrderValidator::Get().Reset();
+	});
+
+	Describe("TRWLockedVariable", [this]() {
+		It("should record the order of nested locks", [this]() {
+			LockNested(VarA, VarB);
+			SPEC_TEST_TRUE(FLockOrderValidator::Get().HasRecordedOrder(&VarA.GetLock(), &VarB.GetLock()));
+			SPEC_TEST_FALSE(FLockOrderValidator::Get().HasRecordedOrder(&VarB.GetLock(), &VarA.GetLock()));
+		});
+
+		It("should not report locks that are always acquired in the same order", [this]() {
+			LockNested(VarA, VarB);
+			LockNested(VarB, VarC);
+			LockNested(VarA, VarC);
+			LockNested(VarA, VarB);
+			SPEC_TEST_EQUAL(Violations.Num(), 0);
+		});
+
+		It("should report nested locks with inverted order", [this]() {
+			LockNested(VarA, VarB);
+			LockNested(VarB, VarA);
+			if (SPEC_TEST_EQUAL(Violations.Num(), 1))
+			{
+				const TArray<const void*>& Cycle = Violations[0].Cycle;
+				SPEC_TEST_EQUAL(Cycle.Num(), 2);
+				SPEC_TEST_TRUE(Cycle.Contains(&VarA.GetLock()));
+				SPEC_TEST_TRUE(Cycle.Contains(&VarB.GetLock()));
+				SPEC_TEST_TRUE(Violations[0].Report.Contains(TEXT("Potential deadlock")));
+			}
+		});
+
+		It("should report the inverted order only once", [this]() {
+			LockNested(VarA, VarB);
+			LockNested(VarB, VarA);
+			LockNested(VarB, VarA);
+			SPEC_TEST_EQUAL(Violations.Num(), 1);
+		});
+
+		It("should report cycles across more than two locks", [this]() {
+			LockNested(VarA, VarB);
+			LockNested(VarB, VarC);
+			SPEC_TEST_EQUAL(Violations.Num(), 0);
+			LockNested(VarC, VarA);
+			if (SPEC_TEST_EQUAL(Violations.Num(), 1))
+			{
+				SPEC_TEST_EQUAL(Violations[0].Cycle.Num(), 3);
+			}
+		});
+
+		It("should forget the lock orders of destroyed variables", [this]() {
+			auto TemporaryVar = MakeUnique<TRWLockedVariable<int32>>();
+			const void* TemporaryLock = &TemporaryVar->GetLock();
+			LockNested(VarA, *TemporaryVar);
+			SPEC_TEST_TRUE(FLockOrderValidator::Get().HasRecordedOrder(&VarA.GetLock(), TemporaryLock));
+
+			TemporaryVar.Reset();
+			SPEC_TEST_FALSE(FLockOrderValidator::Get().HasRecordedOrder(&VarA.GetLock(), TemporaryLock));
+		});
+	});
+
+	Describe("TScopedMultiRWLock", [this]() {
+		It("should acquire locks in the same order regardless of the argument order", [this]() {
+			{
+				const auto MultiLock = MakeScopedMultiRWLock(Write(VarA), Read(VarB), Write(VarC));
+			}
+			{
+				const auto MultiLock = MakeScopedMultiRWLock(Write(VarC), Write(VarB), Read(VarA));
+			}
+			SPEC_TEST_EQUAL(Violations.Num(), 0);
+		});
+
+		It("should report nested locks that invert the order of a multi lock", [this]() {
+			const bool bAIsFirst = &VarA.GetLock() < &VarB.GetLock();
+			TRWLockedVariable<int32>& FirstVar = bAIsFirst ? VarA : VarB;
+			TRWLockedVariable<int32>& SecondVar = bAIsFirst ? VarB : VarA;
+			{
+				const auto MultiLock = MakeScopedMultiRWLock(Write(VarA), Write(VarB));
+			}
+			SPEC_TEST_TRUE(FLockOrderValidator::Get().HasRecordedOrder(&FirstVar.GetLock(), &SecondVar.GetLock()));
+
+			LockNested(SecondVar, FirstVar);
+			SPEC_TEST_EQUAL(Violations.Num(), 1);
+		});
+
+		It("should report single locks nested in a multi lock", [this]() {
+			LockNested(VarC, VarA);
+			{
+				const auto MultiLock = MakeScopedMultiRWLock(Write(VarA), Write(VarB));
+				auto Ref = VarC.Write();
+			}
+			// Depending on the lock addresses, B -> C may close a second cycle via C -> A -> B
+			SPEC_TEST_TRUE(Violations.Num() >= 1);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,279 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+// ReSharper disable StringLiteralTypo
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Misc/OUUPatternSet.h"
+
+BEGIN_DEFINE_SPEC(FOUUPatternSetSpec, "OpenUnrealUtilities.Runtime.Misc.PatternSet", DEFAULT_OUU_TEST_FLAGS)
+END_DEFINE_SPEC(FOUUPatternSetSpec)
+void FOUUPatternSetSpec::Define()
+{
+	Describe("MatchesAny", [this]() {
+		It("should return false for an empty set", [this]() {
+			const FOUUPatternSet Set;
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("Foo")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("")));
+		});
+
+		It("should only match exact patterns with the whole string", [this]() {
+			FOUUPatternSet Set;
+			Set.AddExact("/Game/Foo");
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("/Game/Foo")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("/Game/Foo/Bar")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("/Game/Fo")));
+		});
+
+		It("should match prefix patterns with any string starting with the prefix", [this]() {
+			FOUUPatternSet Set;
+			Set.AddPrefix("/Game/Foo");
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("/Game/Foo")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("/Game/Foo/Bar")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("/Game/Fo")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("/Engine/Game/Foo")));
+		});
+
+		It("should match substring patterns anywhere in the string", [this]() {
+			FOUUPatternSet Set;
+			Set.AddSubstring("Foo");
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("Foo")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("BarFooBar")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("FFoo")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("FoBar")));
+		});
+
+		It("should treat wildcard characters in non-glob patterns as literals", [this]() {
+			FOUUPatternSet Set;
+			Set.AddPrefix("Foo*");
+			Set.AddExact("B?r");
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("Foo*Bar")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("FooBar")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("B?r")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("Bar")));
+		});
+
+		It("should match globs the same way as FString::MatchesWildcard", [this]() {
+			const TArray<FString> Globs = {
+				"*",
+				"",
+				"Foo",
+				"Foo*",
+				"*Foo",
+				"*Foo*",
+				"F?o",
+				"F*o",
+				"*o*o*",
+				"??",
+				"*?",
+				"**Bar",
+				"Foo*Bar*Baz",
+				"*_LOD?"};
+			const TArray<FString> Strings = {
+				"",
+				"F",
+				"Fo",
+				"Foo",
+				"FooBar",
+				"BarFoo",
+				"Fxo",
+				"Fooo",
+				"FooBarBaz",
+				"FooBazBarBaz",
+				"SM_Rock_LOD1",
+				"SM_Rock_LOD12"};
+			for (const FString& Glob : Globs)
+			{
+				FOUUPatternSet Set;
+				Set.AddGlob(Glob);
+				for (const FString& String : Strings)
+				{
+					TestEqual(
+						FString::Printf(TEXT("'%s' matches '%s'"), *String, *Glob),
+						Set.MatchesAny(String),
+						String.MatchesWildcard(Glob, ESearchCase::CaseSensitive));
+				}
+			}
+		});
+
+		It("should match regex patterns anywhere in the string", [this]() {
+			FOUUPatternSet Set;
+			Set.AddRegex("[0-9]+$");
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("Bone_12")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("Bone_12_End")));
+		});
+
+		It("should ignore empty regex matches", [this]() {
+			FOUUPatternSet Set;
+			Set.AddRegex("x*");
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("Bone_12")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("Bone_x")));
+		});
+
+		It("should ignore the case of all pattern types if the set is case insensitive", [this]() {
+			FOUUPatternSet Set(ESearchCase::IgnoreCase);
+			Set.AddExact("exact");
+			Set.AddPrefix("/game/");
+			Set.AddGlob("*_lod?");
+			Set.AddRegex("^bone_");
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("EXACT")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("/Game/Foo")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("SM_Rock_LOD1")));
+			SPEC_TEST_TRUE(Set.MatchesAny(TEXT("Bone_Spine")));
+		});
+
+		It("should respect the case of all pattern types if the set is case sensitive", [this]() {
+			FOUUPatternSet Set(ESearchCase::CaseSensitive);
+			Set.AddExact("exact");
+			Set.AddPrefix("/game/");
+			Set.AddGlob("*_lod?");
+			Set.AddRegex("^bone_");
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("EXACT")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("/Game/Foo")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("SM_Rock_LOD1")));
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("Bone_Spine")));
+		});
+	});
+
+	Describe("MatchAll", [this]() {
+		It("should return the indices of all matching patterns in ascending order", [this]() {
+			FOUUPatternSet Set;
+			const int32 Regex = Set.AddRegex("Rock");
+			const int32 Prefix = Set.AddPrefix("/Game/Env/");
+			Set.AddPrefix("/Game/Characters/");
+			const int32 Glob = Set.AddGlob("*_LOD?");
+			const int32 Exact = Set.AddExact("/Game/Env/SM_Rock_LOD1");
+			Set.AddExact("/Game/Env/SM_Rock_LOD");
+			const int32 Substring = Set.AddSubstring("SM_");
+			const TArray<int32> Expected = {Regex, Prefix, Glob, Exact, Substring};
+			SPEC_TEST_ARRAYS_EQUAL(Set.MatchAll(TEXT("/Game/Env/SM_Rock_LOD1")), Expected);
+		});
+
+		It("should report each pattern only once even if it matches at multiple positions", [this]() {
+			FOUUPatternSet Set;
+			Set.AddSubstring("a");
+			Set.AddGlob("*a*");
+			const TArray<int32> Expected = {0, 1};
+			SPEC_TEST_ARRAYS_EQUAL(Set.MatchAll(TEXT("banana")), Expected);
+		});
+
+		It("should distinguish patterns that share a common prefix", [this]() {
+			FOUUPatternSet Set;
+			Set.AddExact("/Game/A");
+			Set.AddExact("/Game/AB");
+			Set.AddPrefix("/Game/A");
+			Set.AddPrefix("/Game/ABC");
+			const TArray<int32> ExpectedA = {0, 2};
+			const TArray<int32> ExpectedAB = {1, 2};
+			const TArray<int32> ExpectedABCD = {2, 3};
+			SPEC_TEST_ARRAYS_EQUAL(Set.MatchAll(TEXT("/Game/A")), ExpectedA);
+			SPEC_TEST_ARRAYS_EQUAL(Set.MatchAll(TEXT("/Game/AB")), ExpectedAB);
+			SPEC_TEST_ARRAYS_EQUAL(Set.MatchAll(TEXT("/Game/ABCD")), ExpectedABCD);
+		});
+
+		It("should return an empty array if no pattern matches", [this]() {
+			FOUUPatternSet Set;
+			Set.AddPrefix("/Game/");
+			Set.AddRegex("^$");
+			SPEC_TEST_EQUAL(Set.MatchAll(TEXT("/Engine/")).Num(), 0);
+		});
+
+		It("should not match anything after Reset", [this]() {
+			FOUUPatternSet Set;
+			Set.AddPrefix("/Game/");
+			Set.AddRegex("Game");
+			Set.Reset();
+			SPEC_TEST_EQUAL(Set.Num(), 0);
+			SPEC_TEST_FALSE(Set.MatchesAny(TEXT("/Game/")));
+		});
+
+		It("should match the same patterns as matching them one by one for 1k patterns and 100k strings", [this]() {
+			constexpr int32 NumPatterns = 1000;
+			constexpr int32 NumStrings = 100000;
+			// Matching all strings one pattern at a time takes too long for a test, so only every Nth string is
+			// compared against the reference implementation.
+			constexpr int32 ReferenceStride = 100;
+
+			FOUUPatternSet Set;
+			for (int32 i = 0; i < NumPatterns; i++)
+			{
+				switch (i % 4)
+				{
+				case 0: Set.AddPrefix(FString::Printf(TEXT("/Game/Folder_%i/"), i)); break;
+				case 1: Set.AddExact(FString::Printf(TEXT("/Game/Folder_%i/Asset_%i"), i - 1, i)); break;
+				case 2: Set.AddGlob(FString::Printf(TEXT("/Game/*/Asset_%i_LOD?"), i)); break;
+				case 3: Set.AddSubstring(FString::Printf(TEXT("Asset_%i_"), i)); break;
+				}
+			}
+
+			TArray<FString> Strings;
+			Strings.Reserve(NumStrings);
+			for (int32 i = 0; i < NumStrings; i++)
+			{
+				const int32 Folder = i % (NumPatterns + 100);
+				const int32 Asset = (i * 7) % (NumPatterns + 100);
+				Strings.Add(FString::Printf(TEXT("/Game/Folder_%i/Asset_%i_LOD%i"), Folder, Asset, i % 3));
+			}
+
+			auto MatchesReference = [&](int32 PatternIndex, const FString& String) -> bool {
+				const FString& Pattern = Set.GetPattern(PatternIndex);
+				switch (Set.GetPatternType(PatternIndex))
+				{
+				case FOUUPatternSet::EPatternType::Exact: return String.Equals(Pattern, ESearchCase::CaseSensitive);
+				case FOUUPatternSet::EPatternType::Prefix:
+					return String.StartsWith(Pattern, ESearchCase::CaseSensitive);
+				case FOUUPatternSet::EPatternType::Substring:
+					return String.Contains(Pattern, ESearchCase::CaseSensitive);
+				case FOUUPatternSet::EPatternType::Glob:
+					return String.MatchesWildcard(Pattern, ESearchCase::CaseSensitive);
+				default: return false;
+				}
+			};
+
+			const double SetStartTime = FPlatformTime::Seconds();
+			int32 NumMatches = 0;
+			TArray<int32> MatchedPatterns;
+			for (const FString& String : Strings)
+			{
+				Set.MatchAll(String, MatchedPatterns);
+				NumMatches += MatchedPatterns.Num();
+			}
+			const double SetTime = FPlatformTime::Seconds() - SetStartTime;
+
+			const double ReferenceStartTime = FPlatformTime::Seconds();
+			bool bAllEqual = true;
+			for (int32 StringIdx = 0; StringIdx < NumStrings; StringIdx += ReferenceStride)
+			{
+				TArray<int32> ReferencePatterns;
+				for (int32 PatternIdx = 0; PatternIdx < NumPatterns; PatternIdx++)
+				{
+					if (MatchesReference(PatternIdx, Strings[StringIdx]))
+					{
+						ReferencePatterns.Add(PatternIdx);
+					}
+				}
+				bAllEqual &= (ReferencePatterns == Set.MatchAll(Strings[StringIdx]));
+			}
+			const double ReferenceTime =
+				(FPlatformTime::Seconds() - ReferenceStartTime) * static_cast<double>(ReferenceStride);
+
+			AddInfo(FString::Printf(
+				TEXT("Matched %i patterns (%i states) against %i strings in %.3f ms (%i matches). "
+					 "Matching one pattern at a time would take ~%.3f ms."),
+				NumPatterns,
+				Set.NumStates(),
+				NumStrings,
+				SetTime * 1000.0,
+				NumMatches,
+				ReferenceTime * 1000.0));
+
+			SPEC_TEST_TRUE(NumMatches > 0);
+			SPEC_TEST_TRUE(bAllEqual);
+		});
+	});
+}
+
+#endif
@@ -126,6 +126,78 @@ void FRegexUtilsSpec::Define()
 		});
 	});
 
+	Describe("RegexMatches", [this]() {
+		It("should iterate over all non-empty matches", [this]() {
+			const FString Input = "alphabet 1234 noodle soup";
+			TArray<FRegexMatch> Matches;
+			for (const auto& Match : OUU::Runtime::RegexMatches("[a-z]*", Input))
+			{
+				Matches.Add(Match.ToRegexMatch());
+			}
+			const TArray<FRegexMatch> ExpectedMatches = {
+				FRegexMatch{0, 8, "alphabet"},
+				FRegexMatch{14, 20, "noodle"},
+				FRegexMatch{21, 25, "soup"},
+			};
+			SPEC_TEST_ARRAYS_EQUAL(Matches, ExpectedMatches);
+		});
+
+		It("should return views into the input string", [this]() {
+			const FString Input = "xx jonasreich.de";
+			for (const auto& Match : OUU::Runtime::RegexMatches("([\\w-]+)\\.(\\w+)", Input))
+			{
+				SPEC_TEST_TRUE(Match.GetView().GetData() == (*Input + 3));
+				SPEC_TEST_EQUAL(FString(Match.GetView()), FString("jonasreich.de"));
+				SPEC_TEST_EQUAL(FString(Match.GetCaptureGroup(1)), FString("jonasreich"));
+				SPEC_TEST_EQUAL(FString(Match.GetCaptureGroup(2)), FString("de"));
+				SPEC_TEST_EQUAL(Match.GetCaptureGroupBeginning(2), 14);
+			}
+		});
+
+		It("should return empty views for capture groups that did not participate in the match", [this]() {
+			const FString Input = "abc";
+			for (const auto& Match : OUU::Runtime::RegexMatches("(abc)|(xyz)", Input))
+			{
+				SPEC_TEST_EQUAL(Match.GetCaptureGroupBeginning(2), static_cast<int32>(INDEX_NONE));
+				SPEC_TEST_TRUE(Match.GetCaptureGroup(2).IsEmpty());
+			}
+		});
+
+		It("should yield an empty range if there are no matches", [this]() {
+			const FString Input = "1234";
+			auto Matches = OUU::Runtime::RegexMatches("[a-z]+", Input);
+			SPEC_TEST_TRUE(Matches.begin() == Matches.end());
+		});
+
+		Describe("with more than 1 million matches", [this]() {
+			const int32 NumRepetitions = 1000 * 1000;
+			auto MakeLargeInput = [NumRepetitions]() {
+				FString Input;
+				Input.Reserve(NumRepetitions * 3);
+				for (int32 i = 0; i < NumRepetitions; i++)
+				{
+					Input += TEXT("ab ");
+				}
+				return Input;
+			};
+
+			It("should count all matches", [this, MakeLargeInput, NumRepetitions]() {
+				const FString Input = MakeLargeInput();
+				SPEC_TEST_EQUAL(OUU::Runtime::RegexUtils::CountRegexMatches("[a-z]+", Input), NumRepetitions);
+			});
+
+			It("should list all matches", [this, MakeLargeInput, NumRepetitions]() {
+				const FString Input = MakeLargeInput();
+				const auto Matches = OUU::Runtime::RegexUtils::GetRegexMatches("[a-z]+", Input);
+				if (SPEC_TEST_EQUAL(Matches.Num(), NumRepetitions))
+				{
+					const FRegexMatch ExpectedLastMatch{(NumRepetitions - 1) * 3, NumRepetitions * 3 - 1, "ab"};
+					SPEC_TEST_EQUAL(Matches.Last(), ExpectedLastMatch);
+				}
+			});
+		});
+	});
+
 	Describe("ReplaceFirstRegexMatch", [this]() {
 		It("should replace a single occurence with a given string", [this]() {
 			const FString Input = "My test string";
@@ -159,6 +231,92 @@ void FRegexUtilsSpec::Define()
 			SPEC_TEST_EQUAL(Result, "foobar My foobar string foobar foobar");
 		});
 	});
+
+	Describe("ReplaceAllRegexMatchesWithTemplate", [this]() {
+		It("should substitute numbered groups", [this]() {
+			const FString Result = OUU::Runtime::RegexUtils::ReplaceAllRegexMatchesWithTemplate(
+				"(\\w+)=(\\d+)",
+				"a=1, b=2",
+				"$2:$1");
+			SPEC_TEST_EQUAL(Result, "1:a, 2:b");
+		});
+
+		It("should substitute the whole match for $0 and ${0}", [this]() {
+			const FString Result =
+				OUU::Runtime::RegexUtils::ReplaceAllRegexMatchesWithTemplate("\\d+", "a1 b22", "<$0|${0}>");
+			SPEC_TEST_EQUAL(Result, "a<1|1> b<22|22>");
+		});
+
+		It("should substitute named groups", [this]() {
+			const FString Result = OUU::Runtime::RegexUtils::ReplaceAllRegexMatchesWithTemplate(
+				"(?<key>\\w+)=(?<value>\\d+)",
+				"a=1, b=2",
+				"${value}:${key}");
+			SPEC_TEST_EQUAL(Result, "1:a, 2:b");
+		});
+
+		It("should count named and unnamed groups in pattern order", [this]() {
+			const FString Result = OUU::Runtime::RegexUtils::ReplaceAllRegexMatchesWithTemplate(
+				"(\\w)(?:-)(?<=-)(?<second>\\w)[(]",
+				"a-b(",
+				"${second}$1");
+			SPEC_TEST_EQUAL(Result, "ba");
+		});
+
+		It("should keep $$ and unknown references as literal $", [this]() {
+			AddExpectedError(TEXT("references unknown group 'unknown'"), EAutomationExpectedErrorFlags::Contains, 1);
+			const FString Result =
+				OUU::Runtime::RegexUtils::ReplaceAllRegexMatchesWithTemplate("x", "x", "$$ $a ${unknown} $");
+			SPEC_TEST_EQUAL(Result, "$ $a ${unknown} $");
+		});
+	});
+
+	Describe("RegexReplace", [this]() {
+		It("should call the callback for every match", [this]() {
+			const FString Input = "1 2 3";
+			const FString Result = OUU::Runtime::RegexReplace(
+				"\\d",
+				Input,
+				[](const OUU::Runtime::FRegexMatchRange::FMatch& Match, FString& OutResult) {
+					int32 Value = 0;
+					LexFromString(Value, *FString(Match.GetView()));
+					OutResult.AppendInt(Value * 2);
+				});
+			SPEC_TEST_EQUAL(Result, "2 4 6");
+		});
+
+		It("should stop after the max number of replacements", [this]() {
+			const FString Result =
+				OUU::Runtime::RegexReplace("\\d", "1 2 3", OUU::Runtime::FRegexReplaceTemplate("x"), 2);
+			SPEC_TEST_EQUAL(Result, "x x 3");
+		});
+
+		It("should replace all matches in a multi-megabyte input", [this]() {
+			const int32 NumRepetitions = 500 * 1000;
+			FString Input;
+			Input.Reserve(NumRepetitions * 8);
+			FString Expected;
+			Expected.Reserve(NumRepetitions * 8);
+			for (int32 i = 0; i < NumRepetitions; i++)
+			{
+				Input += TEXT("key=42; ");
+				Expected += TEXT("42:key; ");
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			const FString Result = OUU::Runtime::RegexReplace(
+				"(?<key>\\w+)=(\\d+)",
+				Input,
+				OUU::Runtime::FRegexReplaceTemplate("$2:${key}", "(?<key>\\w+)=(\\d+)"));
+			AddInfo(FString::Printf(
+				TEXT("Replaced %i matches in %i characters in %.3f ms"),
+				NumRepetitions,
+				Input.Len(),
+				(FPlatformTime::Seconds() - StartTime) * 1000.0));
+
+			SPEC_TEST_TRUE(Result == Expected);
+		});
+	});
 }
 
 #endif
@@ -0,0 +1,256 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Algo/Reverse.h"
+	#include "Templates/CircularArrayAdaptor.h"
+	#include "Templates/ReverseIterator.h"
+
+BEGIN_DEFINE_SPEC(
+	FCircularArrayAdaptorSpec,
+	"OpenUnrealUtilities.Runtime.Templates.CircularArrayAdaptor",
+	DEFAULT_OUU_TEST_FLAGS)
+	template <typename CircularArrayType>
+	static TArray<int32> CollectRangedFor(const CircularArrayType& CircularArray)
+	{
+		TArray<int32> Result;
+		for (const int32 Element : CircularArray)
+		{
+			Result.Add(Element);
+		}
+		return Result;
+	}
+
+	template <typename CircularArrayType>
+	static TArray<int32> CollectIndexed(const CircularArrayType& CircularArray)
+	{
+		TArray<int32> Result;
+		for (int32 i = 0; i < CircularArray.Num(); i++)
+		{
+			Result.Add(CircularArray[i]);
+		}
+		return Result;
+	}
+
+	template <typename CircularArrayType>
+	static TArray<int32> CollectSpans(const CircularArrayType& CircularArray)
+	{
+		const auto HeadSpan = CircularArray.GetHeadSpan();
+		const auto TailSpan = CircularArray.GetTailSpan();
+		TArray<int32> Result;
+		Result.Append(HeadSpan.GetData(), HeadSpan.Num());
+		Result.Append(TailSpan.GetData(), TailSpan.Num());
+		return Result;
+	}
+
+	static TArray<int32> MakeSequence(int32 First, int32 LastInclusive)
+	{
+		TArray<int32> Result;
+		for (int32 i = First; i <= LastInclusive; i++)
+		{
+			Result.Add(i);
+		}
+		return Result;
+	}
+END_DEFINE_SPEC(FCircularArrayAdaptorSpec)
+void FCircularArrayAdaptorSpec::Define()
+{
+	Describe("GetHeadSpan/GetTailSpan", [this]() {
+		It("should return all elements in the head span before the array wrapped", [this]() {
+			TCircularArray<int32> CircularArray(5);
+			CircularArray.Add(1);
+			CircularArray.Add(2);
+			CircularArray.Add(3);
+			SPEC_TEST_ARRAYS_EQUAL(TArray<int32>(CircularArray.GetHeadSpan()), MakeSequence(1, 3));
+			SPEC_TEST_EQUAL(CircularArray.GetTailSpan().Num(), 0);
+		});
+
+		It("should split the elements at the oldest element after the array wrapped", [this]() {
+			TCircularArray<int32> CircularArray(5);
+			for (int32 i = 1; i <= 7; i++)
+			{
+				CircularArray.Add(i);
+			}
+			//   |6|7|3|4|5|
+			// head:   |3|4|5|
+			// tail: |6|7|
+			SPEC_TEST_ARRAYS_EQUAL(TArray<int32>(CircularArray.GetHeadSpan()), MakeSequence(3, 5));
+			SPEC_TEST_ARRAYS_EQUAL(TArray<int32>(CircularArray.GetTailSpan()), MakeSequence(6, 7));
+		});
+	});
+
+	Describe("ranged-based for loops", [this]() {
+		It("should match indexed access for any number of added elements", [this]() {
+			TCircularArray<int32> CircularArray(5);
+			for (int32 i = 1; i <= 13; i++)
+			{
+				CircularArray.Add(i);
+				SPEC_TEST_ARRAYS_EQUAL(CollectRangedFor(CircularArray), CollectIndexed(CircularArray));
+				SPEC_TEST_ARRAYS_EQUAL(CollectSpans(CircularArray), CollectIndexed(CircularArray));
+			}
+		});
+
+		It("should work on an empty array", [this]() {
+			const TCircularArray<int32> CircularArray(5);
+			SPEC_TEST_EQUAL(CollectRangedFor(CircularArray).Num(), 0);
+		});
+	});
+
+	Describe("ReverseRange", [this]() {
+		It("should iterate the elements newest to oldest across the head/tail boundary", [this]() {
+			TCircularArray<int32> CircularArray(5);
+			for (int32 i = 1; i <= 13; i++)
+			{
+				CircularArray.Add(i);
+				TArray<int32> Reversed;
+				for (const int32 Element : ReverseRange(AsConst(CircularArray)))
+				{
+					Reversed.Add(Element);
+				}
+				TArray<int32> Expected = CollectIndexed(CircularArray);
+				Algo::Reverse(Expected);
+				SPEC_TEST_ARRAYS_EQUAL(Reversed, Expected);
+			}
+		});
+
+		It("should allow modifying the elements of a wrapped adaptor", [this]() {
+			TArray<int32> Storage;
+			TCircularArrayAdaptor<int32> Adaptor(Storage, 4);
+			for (int32 i = 1; i <= 6; i++)
+			{
+				Adaptor.Add(i);
+			}
+			int32 Counter = 0;
+			for (int32& Element : ReverseRange(Adaptor))
+			{
+				Element = Counter++;
+			}
+			const TArray<int32> Expected = {3, 2, 1, 0};
+			SPEC_TEST_ARRAYS_EQUAL(CollectIndexed(Adaptor), Expected);
+		});
+	});
+
+	Describe("IsValidIndex", [this]() {
+		It("should only accept indices in [0, Num)", [this]() {
+			TCircularArray<int32> CircularArray(3);
+			for (int32 i = 0; i < 5; i++)
+			{
+				CircularArray.Add(i);
+			}
+			SPEC_TEST_TRUE(CircularArray.IsValidIndex(0));
+			SPEC_TEST_TRUE(CircularArray.IsValidIndex(2));
+			SPEC_TEST_FALSE(CircularArray.IsValidIndex(3));
+			SPEC_TEST_FALSE(CircularArray.IsValidIndex(-1));
+		});
+	});
+
+	Describe("TCircularArray_Pow2", [this]() {
+		It("should store the same elements as a regular circular array of the same capacity", [this]() {
+			TCircularArray<int32> CircularArray(8);
+			TCircularArray_Pow2<int32> CircularArray_Pow2(8);
+			for (int32 i = 1; i <= 21; i++)
+			{
+				CircularArray.Add(i);
+				CircularArray_Pow2.Add(i);
+				SPEC_TEST_ARRAYS_EQUAL(CollectIndexed(CircularArray_Pow2), CollectIndexed(CircularArray));
+				SPEC_TEST_ARRAYS_EQUAL(CollectRangedFor(CircularArray_Pow2), CollectIndexed(CircularArray));
+				SPEC_TEST_EQUAL(CircularArray_Pow2.Oldest(), CircularArray.Oldest());
+				SPEC_TEST_EQUAL(CircularArray_Pow2.Last(), CircularArray.Last());
+			}
+		});
+
+		It("should wrap an existing array with the adaptor", [this]() {
+			TArray<int32> Storage;
+			TCircularArrayAdaptor_Pow2<int32> Adaptor(Storage, 4);
+			for (int32 i = 1; i <= 6; i++)
+			{
+				Adaptor.Add(i);
+			}
+			SPEC_TEST_ARRAYS_EQUAL(CollectIndexed(Adaptor), MakeSequence(3, 6));
+			const TArray<int32> ExpectedStorage = {5, 6, 3, 4};
+			SPEC_TEST_ARRAYS_EQUAL(Storage, ExpectedStorage);
+		});
+	});
+
+	It("should report span iteration timings compared to indexed access", [this]() {
+		constexpr int32 Capacity = 4000;
+		constexpr int32 Capacity_Pow2 = 4096;
+		constexpr int32 NumIterations = 500;
+
+		TCircularArray<int32> CircularArray(Capacity);
+		TCircularArray_Pow2<int32> CircularArray_Pow2(Capacity_Pow2);
+		// Add more elements than the capacity, so the ring wrapped and both spans are used
+		for (int32 i = 0; i < Capacity + Capacity / 3; i++)
+		{
+			CircularArray.Add(i);
+		}
+		for (int32 i = 0; i < Capacity_Pow2 + Capacity_Pow2 / 3; i++)
+		{
+			CircularArray_Pow2.Add(i);
+		}
+
+		auto Measure = [&](auto&& SumFunction) {
+			int64 Sum = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+			{
+				Sum += SumFunction();
+			}
+			return TPair<double, int64>(FPlatformTime::Seconds() - StartTime, Sum);
+		};
+
+		const auto Indexed = Measure([&]() {
+			int64 Sum = 0;
+			for (int32 i = 0; i < CircularArray.Num(); i++)
+			{
+				Sum += CircularArray[i];
+			}
+			return Sum;
+		});
+		const auto Indexed_Pow2 = Measure([&]() {
+			int64 Sum = 0;
+			for (int32 i = 0; i < CircularArray_Pow2.Num(); i++)
+			{
+				Sum += CircularArray_Pow2[i];
+			}
+			return Sum;
+		});
+		const auto RangedFor = Measure([&]() {
+			int64 Sum = 0;
+			for (const int32 Element : CircularArray)
+			{
+				Sum += Element;
+			}
+			return Sum;
+		});
+		const auto Spans = Measure([&]() {
+			int64 Sum = 0;
+			for (const TArrayView<const int32> Span :
+				 {AsConst(CircularArray).GetHeadSpan(), AsConst(CircularArray).GetTailSpan()})
+			{
+				const int32* Data = Span.GetData();
+				for (int32 i = 0; i < Span.Num(); i++)
+				{
+					Sum += Data[i];
+				}
+			}
+			return Sum;
+		});
+
+		SPEC_TEST_EQUAL(RangedFor.Value, Indexed.Value);
+		SPEC_TEST_EQUAL(Spans.Value, Indexed.Value);
+		AddInfo(FString::Printf(
+			TEXT("Summing %i elements %i times: indexed %.3f ms, indexed pow2 %.3f ms, ranged-for %.3f ms, "
+				 "spans %.3f ms"),
+			Capacity,
+			NumIterations,
+			Indexed.Key * 1000.0,
+			Indexed_Pow2.Key * 1000.0,
+			RangedFor.Key * 1000.0,
+			Spans.Key * 1000.0));
+	});
+}
+
+#endif
@@ -0,0 +1,190 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+	#include "Templates/CircularQuantileAggregator.h"
+
+BEGIN_DEFINE_SPEC(
+	FCircularQuantileAggregatorSpec,
+	"OpenUnrealUtilities.Runtime.Templates.CircularQuantileAggregator",
+	DEFAULT_OUU_TEST_FLAGS)
+	const TArray<double> TestQuantiles = {0.0, 0.01, 0.25, 0.5, 0.95, 0.99, 1.0};
+
+	/** Reference implementation: copy and sort the last MaxNum samples */
+	template <typename ElementType>
+	static ElementType SortedQuantile(const TArray<ElementType>& AllSamples, int32 MaxNum, double Quantile)
+	{
+		const int32 NumSamples = FMath::Min(AllSamples.Num(), MaxNum);
+		TArray<ElementType> Window(AllSamples.GetData() + AllSamples.Num() - NumSamples, NumSamples);
+		Window.Sort();
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt(Quantile * NumSamples) - 1, 0, NumSamples - 1);
+		return Window[Rank];
+	}
+END_DEFINE_SPEC(FCircularQuantileAggregatorSpec)
+void FCircularQuantileAggregatorSpec::Define()
+{
+	Describe("TCircularQuantileAggregator", [this]() {
+		It("should return 0 without data", [this]() {
+			const TCircularQuantileAggregator<float> Aggregator(8);
+			SPEC_TEST_FALSE(Aggregator.HasData());
+			SPEC_TEST_EQUAL(Aggregator.Median(), 0.f);
+		});
+
+		It("should only consider the last MaxNum samples", [this]() {
+			TCircularQuantileAggregator<int32> Aggregator(3);
+			for (int32 Sample : {100, 1, 2, 3})
+			{
+				Aggregator.Add(Sample);
+			}
+			SPEC_TEST_EQUAL(Aggregator.Num(), 3);
+			SPEC_TEST_EQUAL(Aggregator.Max(), 3);
+			SPEC_TEST_EQUAL(Aggregator.Min(), 1);
+			SPEC_TEST_EQUAL(Aggregator.Median(), 2);
+			SPEC_TEST_EQUAL(Aggregator.Oldest(), 1);
+			SPEC_TEST_EQUAL(Aggregator.Last(), 3);
+		});
+
+		It("should match the quantiles of the sorted samples", [this]() {
+			constexpr int32 MaxNum = 200;
+			TCircularQuantileAggregator<float> Aggregator(MaxNum);
+			TArray<float> AllSamples;
+			FRandomStream RandomStream(42);
+
+			int32 NumMismatches = 0;
+			for (int32 i = 0; i < 2000; i++)
+			{
+				// Few distinct values, so the order of equal samples is covered as well
+				const float Sample = (i % 3 == 0) ? RandomStream.FRandRange(0.f, 100.f) : RandomStream.RandRange(0, 10);
+				Aggregator.Add(Sample);
+				AllSamples.Add(Sample);
+				if (i % 7 != 0)
+					continue;
+
+				for (const double Quantile : TestQuantiles)
+				{
+					if (Aggregator.Quantile(Quantile) != SortedQuantile(AllSamples, MaxNum, Quantile))
+					{
+						NumMismatches++;
+					}
+				}
+			}
+			SPEC_TEST_EQUAL(NumMismatches, 0);
+		});
+
+		It("should start over after Reset", [this]() {
+			TCircularQuantileAggregator<int32> Aggregator(4);
+			for (int32 i = 0; i < 10; i++)
+			{
+				Aggregator.Add(i);
+			}
+			Aggregator.Reset();
+			Aggregator.Add(42);
+			SPEC_TEST_EQUAL(Aggregator.Num(), 1);
+			SPEC_TEST_EQUAL(Aggregator.Min(), 42);
+			SPEC_TEST_EQUAL(Aggregator.Max(), 42);
+		});
+
+		It("should be faster than sorting a copy of the samples", [this]() {
+			constexpr int32 MaxNum = 1000;
+			constexpr int32 NumFrames = 10000;
+			TCircularQuantileAggregator<float> Aggregator(MaxNum);
+			TArray<float> Samples;
+			Samples.Reserve(NumFrames);
+			FRandomStream RandomStream(42);
+			for (int32 i = 0; i < NumFrames; i++)
+			{
+				Samples.Add(RandomStream.FRandRange(1.f, 50.f));
+			}
+
+			double AggregatorSum = 0.0;
+			const double AggregatorStartTime = FPlatformTime::Seconds();
+			for (const float Sample : Samples)
+			{
+				Aggregator.Add(Sample);
+				AggregatorSum += Aggregator.Quantile(0.5) + Aggregator.Quantile(0.95) + Aggregator.Quantile(0.99);
+			}
+			const double AggregatorTime = FPlatformTime::Seconds() - AggregatorStartTime;
+
+			// Sorting is only measured for every 10th frame and extrapolated
+			constexpr int32 SortStride = 10;
+			double SortedSum = 0.0;
+			const double SortStartTime = FPlatformTime::Seconds();
+			TArray<float> Window;
+			for (int32 i = 0; i < NumFrames; i += SortStride)
+			{
+				const int32 NumSamples = FMath::Min(i + 1, MaxNum);
+				Window.Reset();
+				Window.Append(Samples.GetData() + i + 1 - NumSamples, NumSamples);
+				Window.Sort();
+				SortedSum += Window[NumSamples / 2] + Window[NumSamples * 95 / 100] + Window[NumSamples * 99 / 100];
+			}
+			const double SortTime = (FPlatformTime::Seconds() - SortStartTime) * SortStride;
+
+			SPEC_TEST_TRUE(AggregatorSum > 0.0 && SortedSum > 0.0);
+			AddInfo(FString::Printf(
+				TEXT("p50/p95/p99 over the last %i of %i samples per sample: aggregator %.3f ms, copy & sort ~%.3f ms"),
+				MaxNum,
+				NumFrames,
+				AggregatorTime * 1000.0,
+				SortTime * 1000.0));
+		});
+	});
+
+	Describe("TCircularHistogramAggregator", [this]() {
+		It("should count samples per bucket and outside of the range", [this]() {
+			TCircularHistogramAggregator<float> Histogram(10, 0.f, 10.f, 5);
+			for (const float Sample : {-1.f, 0.f, 1.9f, 2.f, 9.99f, 10.f, 20.f})
+			{
+				Histogram.Add(Sample);
+			}
+			SPEC_TEST_EQUAL(Histogram.GetUnderflowCount(), 1);
+			SPEC_TEST_EQUAL(Histogram.GetBucketCount(0), 2);
+			SPEC_TEST_EQUAL(Histogram.GetBucketCount(1), 1);
+			SPEC_TEST_EQUAL(Histogram.GetBucketCount(4), 1);
+			SPEC_TEST_EQUAL(Histogram.GetOverflowCount(), 2);
+		});
+
+		It("should remove evicted samples from their buckets", [this]() {
+			TCircularHistogramAggregator<int32> Histogram(2, 0, 10, 10);
+			Histogram.Add(1);
+			Histogram.Add(5);
+			Histogram.Add(5);
+			SPEC_TEST_EQUAL(Histogram.Num(), 2);
+			SPEC_TEST_EQUAL(Histogram.GetBucketCount(1), 0);
+			SPEC_TEST_EQUAL(Histogram.GetBucketCount(5), 2);
+		});
+
+		It("should estimate quantiles within the bucket width of the sorted samples", [this]() {
+			constexpr int32 MaxNum = 300;
+			TCircularHistogramAggregator<double> Histogram(MaxNum, 0.0, 100.0, 64);
+			TArray<double> AllSamples;
+			FRandomStream RandomStream(7);
+
+			double MaxError = 0.0;
+			for (int32 i = 0; i < 3000; i++)
+			{
+				const double Sample = FMath::Square(RandomStream.FRand()) * 100.0;
+				Histogram.Add(Sample);
+				AllSamples.Add(Sample);
+				if (i % 11 != 0)
+					continue;
+
+				for (const double Quantile : TestQuantiles)
+				{
+					const double Error =
+						FMath::Abs(Histogram.Quantile(Quantile) - SortedQuantile(AllSamples, MaxNum, Quantile));
+					MaxError = FMath::Max(MaxError, Error);
+				}
+			}
+			SPEC_TEST_TRUE(MaxError <= Histogram.GetBucketWidth());
+			AddInfo(FString::Printf(
+				TEXT("Max quantile error %.4f with bucket width %.4f"),
+				MaxError,
+				Histogram.GetBucketWidth()));
+		});
+	});
+}
+
+#endif
@@ -130,6 +130,79 @@ void FAutomationTestParameterParserSpec::Define()
 			   TestEqual("Result array", Parser.GetArrayValue<int32>(2), {7, 8, 9});
 		   });
 	});
+
+	Describe("TAutomationTestParameterMatrix", [this]() {
+		const auto MakeTestMatrix = []() {
+			return MakeAutomationTestParameterMatrix(
+				TAutomationTestParameterAxis<int32>(TEXT("PoolSize"), {8, 64}),
+				TAutomationTestParameterAxis<EParameterParserTestEnum>(
+					TEXT("Mode"),
+					{EParameterParserTestEnum::Alpha, EParameterParserTestEnum::Beta, EParameterParserTestEnum::Gamma}),
+				TAutomationTestParameterAxis<FString>(TEXT("Label"), {TEXT("A"), TEXT("B")}));
+		};
+
+		It("should contain the cartesian product of all axes with the last axis changing fastest",
+		   [this, MakeTestMatrix]() {
+			   const auto Matrix = MakeTestMatrix();
+			   SPEC_TEST_EQUAL(Matrix.Num(), 12);
+			   SPEC_TEST_EQUAL(Matrix.GetCombination(1).Get<2>(), FString(TEXT("B")));
+			   SPEC_TEST_EQUAL(Matrix.GetCombination(2).Get<1>(), EParameterParserTestEnum::Beta);
+			   SPEC_TEST_EQUAL(Matrix.GetCombination(6).Get<0>(), 64);
+			   SPEC_TEST_EQUAL(Matrix.GetCombination(11).Get<1>(), EParameterParserTestEnum::Gamma);
+		   });
+
+		It("should generate test names from axis names and values", [this, MakeTestMatrix]() {
+			const auto Matrix = MakeTestMatrix();
+			SPEC_TEST_EQUAL(Matrix.GetTestName(0), FString(TEXT("PoolSize=8 Mode=0 Label=A")));
+			SPEC_TEST_EQUAL(Matrix.GetTestName(11), FString(TEXT("PoolSize=64 Mode=2 Label=B")));
+		});
+
+		It("should find the combination of every test command", [this, MakeTestMatrix]() {
+			const auto Matrix = MakeTestMatrix();
+			TArray<FString> BeautifiedNames, TestCommands;
+			Matrix.GetTests(OUT BeautifiedNames, OUT TestCommands);
+			if (SPEC_TEST_EQUAL(TestCommands.Num(), Matrix.Num()))
+			{
+				for (int32 i = 0; i < TestCommands.Num(); i++)
+				{
+					SPEC_TEST_TRUE(Matrix.FindCombination(TestCommands[i]) == &Matrix.GetCombination(i));
+				}
+			}
+		});
+
+		It("should parse axis values from strings once", [this]() {
+			const auto Matrix = MakeAutomationTestParameterMatrix(
+				TAutomationTestParameterAxis<int32>::FromString(TEXT("Budget"), TEXT("1;2;4")),
+				TAutomationTestParameterAxis<EParameterParserTestEnum_Parseable>::FromString(
+					TEXT("Mode"),
+					TEXT("Beta|Gamma"),
+					TEXT("|")));
+			SPEC_TEST_EQUAL(Matrix.Num(), 6);
+			SPEC_TEST_EQUAL(Matrix.GetCombination(5).Get<0>(), 4);
+			SPEC_TEST_EQUAL(Matrix.GetCombination(5).Get<1>(), EParameterParserTestEnum_Parseable::Gamma);
+			SPEC_TEST_EQUAL(Matrix.GetTestName(5), FString(TEXT("Budget=4 Mode=Gamma")));
+		});
+
+		It("should run all combinations in parallel if the test is thread-safe", [this, MakeTestMatrix]() {
+			const auto Matrix = MakeTestMatrix();
+			TArray<int32> Results;
+			Results.SetNumZeroed(Matrix.Num());
+			const auto Encode = [](int32 PoolSize, EParameterParserTestEnum Mode, const FString& Label) {
+				return PoolSize * 100 + static_cast<int32>(Mode) * 10 + Label.Len();
+			};
+			Matrix.ForEach(
+				[&](int32 CombinationIndex, int32 PoolSize, EParameterParserTestEnum Mode, const FString& Label) {
+					Results[CombinationIndex] = Encode(PoolSize, Mode, Label);
+				},
+				true);
+
+			for (int32 i = 0; i < Matrix.Num(); i++)
+			{
+				const auto& Combination = Matrix.GetCombination(i);
+				SPEC_TEST_EQUAL(Results[i], Encode(Combination.Get<0>(), Combination.Get<1>(), Combination.Get<2>()));
+			}
+		});
+	});
 }
 
 #endif
@@ -0,0 +1,141 @@
+// Copyright (c) 2023 Jonas Reich & Contributors
+
+#include "OUUTestUtilities.h"
+
+#if WITH_AUTOMATION_WORKER
+
+/** Element type without GetTypeHash() to test the fallback for non-hashable types */
+struct FCollectionTestUnhashable
+{
+	int32 Value = 0;
+
+	bool operator==(const FCollectionTestUnhashable& Other) const { return Value == Other.Value; }
+	bool operator!=(const FCollectionTestUnhashable& Other) const { return Value != Other.Value; }
+	FString ToString() const { return LexToString(Value); }
+};
+
+BEGIN_DEFINE_SPEC(
+	FCollectionTestFunctionsSpec,
+	"OpenUnrealUtilities.TestUtilities.CollectionTestFunctions",
+	DEFAULT_OUU_TEST_FLAGS)
+	static TArray<int32> MakeShuffledRange(int32 Num, int32 Seed)
+	{
+		TArray<int32> Result;
+		Result.Reserve(Num);
+		for (int32 i = 0; i < Num; i++)
+		{
+			Result.Add(i);
+		}
+		const FRandomStream RandomStream(Seed);
+		for (int32 i = Num - 1; i > 0; i--)
+		{
+			Result.Swap(i, RandomStream.RandRange(0, i));
+		}
+		return Result;
+	}
+END_DEFINE_SPEC(FCollectionTestFunctionsSpec)
+
+void FCollectionTestFunctionsSpec::Define()
+{
+	Describe("TestArraysEqual", [this]() {
+		It("should not report equal arrays", [this]() {
+			TestArraysEqual(*this, TEXT("Equal"), TArray<int32>{1, 2, 3}, TArray<int32>{1, 2, 3});
+			SPEC_TEST_FALSE(HasAnyErrors());
+		});
+
+		It("should report the first difference and the number of different positions", [this]() {
+			AddExpectedError(TEXT("differ at 2 positions"), EAutomationExpectedErrorFlags::Contains, 1);
+			AddExpectedError(TEXT("First difference at index 1"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestArraysEqual(*this, TEXT("Different"), TArray<int32>{1, 5, 6, 4}, TArray<int32>{1, 2, 3, 4});
+		});
+
+		It("should report elements that are only at different positions as moved", [this]() {
+			AddExpectedError(TEXT("same elements in a different order"), EAutomationExpectedErrorFlags::Contains, 1);
+			AddExpectedError(TEXT("moved: 3"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestArraysEqual(*this, TEXT("Moved"), TArray<int32>{1, 3, 2}, TArray<int32>{1, 2, 3});
+		});
+
+		It("should report missing elements of shorter arrays", [this]() {
+			AddExpectedError(TEXT("missing: 3"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestArraysEqual(*this, TEXT("Shorter"), TArray<int32>{1, 2}, TArray<int32>{1, 2, 3});
+		});
+	});
+
+	Describe("TestUnorderedArraysMatch", [this]() {
+		It("should match arrays with the same elements in any order", [this]() {
+			TestUnorderedArraysMatch(*this, TEXT("Shuffled"), MakeShuffledRange(1000, 1), MakeShuffledRange(1000, 2));
+			SPEC_TEST_FALSE(HasAnyErrors());
+		});
+
+		It("should respect the number of occurrences of each element", [this]() {
+			AddExpectedError(TEXT("1 missing, 1 extra"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestUnorderedArraysMatch(*this, TEXT("Duplicates"), TArray<int32>{1, 1, 2}, TArray<int32>{1, 2, 2});
+		});
+
+		It("should list missing and extra elements with counts", [this]() {
+			AddExpectedError(TEXT("missing: 7, 3 times"), EAutomationExpectedErrorFlags::Contains, 1);
+			AddExpectedError(TEXT("extra: 9, 2 times"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestUnorderedArraysMatch(*this, TEXT("Counts"), TArray<int32>{9, 1, 9}, TArray<int32>{7, 1, 7, 7});
+		});
+
+		It("should cap the number of listed elements", [this]() {
+			AddExpectedError(TEXT("and 90 more missing"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestUnorderedArraysMatch(*this, TEXT("Capped"), TArray<int32>{}, MakeShuffledRange(100, 1), 10);
+		});
+
+		It("should support element types without GetTypeHash", [this]() {
+			AddExpectedError(TEXT("missing: 2"), EAutomationExpectedErrorFlags::Contains, 1);
+			using FElement = FCollectionTestUnhashable;
+			TestUnorderedArraysMatch(
+				*this,
+				TEXT("Unhashable"),
+				TArray<FElement>{FElement{1}, FElement{3}},
+				TArray<FElement>{FElement{2}, FElement{1}});
+		});
+
+		It("should compare large arrays in linear time", [this]() {
+			constexpr int32 NumElements = 100000;
+			const TArray<int32> Actual = MakeShuffledRange(NumElements, 1);
+			const TArray<int32> Expected = MakeShuffledRange(NumElements, 2);
+
+			const double StartTime = FPlatformTime::Seconds();
+			TestUnorderedArraysMatch(*this, TEXT("Large"), Actual, Expected);
+			const double Duration = FPlatformTime::Seconds() - StartTime;
+
+			SPEC_TEST_FALSE(HasAnyErrors());
+			AddInfo(FString::Printf(TEXT("Matched %i shuffled elements in %.2f ms"), NumElements, Duration * 1000.0));
+		});
+	});
+
+	Describe("TestSetsEqual", [this]() {
+		It("should not report equal sets", [this]() {
+			SPEC_TEST_SETS_EQUAL(TSet<int32>({1, 2, 3}), TSet<int32>({3, 2, 1}));
+			SPEC_TEST_FALSE(HasAnyErrors());
+		});
+
+		It("should list missing and extra elements", [this]() {
+			AddExpectedError(TEXT("1 missing, 2 extra"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestSetsEqual(*this, TEXT("Sets"), TSet<int32>({1, 4, 5}), TSet<int32>({1, 2}));
+		});
+	});
+
+	Describe("TestMapsEqual", [this]() {
+		It("should not report equal maps", [this]() {
+			const TMap<FString, int32> Map = {{TEXT("A"), 1}, {TEXT("B"), 2}};
+			SPEC_TEST_MAPS_EQUAL(Map, Map);
+			SPEC_TEST_FALSE(HasAnyErrors());
+		});
+
+		It("should list missing keys, extra keys and different values", [this]() {
+			AddExpectedError(
+				TEXT("1 missing keys, 1 extra keys, 1 different values"),
+				EAutomationExpectedErrorFlags::Contains,
+				1);
+			const TMap<FString, int32> Actual = {{TEXT("A"), 1}, {TEXT("B"), 3}, {TEXT("D"), 4}};
+			const TMap<FString, int32> Expected = {{TEXT("A"), 1}, {TEXT("B"), 2}, {TEXT("C"), 3}};
+			TestMapsEqual(*this, TEXT("Maps"), Actual, Expected);
+		});
+	});
+}
+
+#endif
@@ -12,6 +12,33 @@ BEGIN_DEFINE_SPEC(
 	"OpenUnrealUtilities.TestUtilities.LatentAutomationPIEWorldLoader",
 	DEFAULT_OUU_TEST_FLAGS)
 	OUU::TestUtilities::FLatentAutomationPIEWorldLoader WorldLoader{*this};
+	OUU::TestUtilities::FLatentAutomationPIEWorldLoader SharedWorldLoader{*this};
+
+	/** Load the shared world, spawn an actor and load it again. */
+	void LatentLoadSharedTwice(const FDoneDelegate& Done, TFunction<void(UWorld&, int32, AActor*)> AfterSecondLoad)
+	{
+		SharedWorldLoader.LatentLoad(FDoneDelegate::CreateLambda([this, Done, AfterSecondLoad]() {
+			auto* LoadedWorld = SharedWorldLoader.GetLoadedWorld();
+			if (!SPEC_TEST_NOT_NULL(LoadedWorld))
+			{
+				Done.Execute();
+				return;
+			}
+
+			const int32 OriginalActorCount = LoadedWorld->GetActorCount();
+			AActor* MeshActor = LoadedWorld->SpawnActor<AStaticMeshActor>();
+			SPEC_TEST_NOT_NULL(MeshActor);
+
+			SharedWorldLoader.LatentLoad(
+				FDoneDelegate::CreateLambda([this, Done, AfterSecondLoad, OriginalActorCount, MeshActor]() {
+					if (auto* Loaded2ndWorld = SharedWorldLoader.GetLoadedWorld(); SPEC_TEST_NOT_NULL(Loaded2ndWorld))
+					{
+						AfterSecondLoad(*Loaded2ndWorld, OriginalActorCount, MeshActor);
+					}
+					Done.Execute();
+				}));
+		}));
+	}
 END_DEFINE_SPEC(FLatentAutomationPIEWorldLoaderSpec)
 void FLatentAutomationPIEWorldLoaderSpec::Define()
 {
@@ -73,6 +100,59 @@ void FLatentAutomationPIEWorldLoaderSpec::Define()
 		});
 	});
 
+	Describe("SharedSession", [this]() {
+		BeforeEach([this]() { SharedWorldLoader.SetUseSharedSession(true); });
+
+		LatentIt("should reuse the world and destroy previously spawned actors", [this](const FDoneDelegate& Done) {
+			LatentLoadSharedTwice(Done, [this](UWorld& World, int32 OriginalActorCount, AActor* MeshActor) {
+				SPEC_TEST_TRUE(SharedWorldLoader.WasLastLoadShared());
+				SPEC_TEST_EQUAL(World.GetActorCount(), OriginalActorCount);
+				SPEC_TEST_FALSE(IsValid(MeshActor));
+			});
+		});
+
+		LatentIt("should call reset hooks before reusing the world", [this](const FDoneDelegate& Done) {
+			const auto NumResetHookCalls = MakeShared<int32>(0);
+			SharedWorldLoader.AddResetHook([NumResetHookCalls](UWorld&) {
+				(*NumResetHookCalls)++;
+				return true;
+			});
+			LatentLoadSharedTwice(Done, [this, NumResetHookCalls](UWorld&, int32, AActor*) {
+				SPEC_TEST_TRUE(SharedWorldLoader.WasLastLoadShared());
+				SPEC_TEST_EQUAL(*NumResetHookCalls, 1);
+			});
+		});
+
+		LatentIt("should load the map again if a reset hook fails", [this](const FDoneDelegate& Done) {
+			SharedWorldLoader.AddResetHook([](UWorld&) { return false; });
+			LatentLoadSharedTwice(Done, [this](UWorld& World, int32 OriginalActorCount, AActor*) {
+				SPEC_TEST_FALSE(SharedWorldLoader.WasLastLoadShared());
+				SPEC_TEST_EQUAL(World.GetActorCount(), OriginalActorCount);
+			});
+		});
+
+		LatentIt("should load the map again if the world is polluted after reset", [this](const FDoneDelegate& Done) {
+			// Reset hooks run after the cleanup, so actors spawned by them survive and pollute the world
+			const auto PollutedWorld = MakeShared<TWeakObjectPtr<UWorld>>();
+			SharedWorldLoader.AddResetHook([PollutedWorld](UWorld& World) {
+				*PollutedWorld = &World;
+				return IsValid(World.SpawnActor<AStaticMeshActor>());
+			});
+			LatentLoadSharedTwice(Done, [this, PollutedWorld](UWorld& World, int32 OriginalActorCount, AActor*) {
+				// The reset hook was called on the shared world, but the world was replaced afterwards
+				SPEC_TEST_FALSE(PollutedWorld->IsExplicitlyNull());
+				SPEC_TEST_FALSE(SharedWorldLoader.WasLastLoadShared());
+				SPEC_TEST_TRUE(PollutedWorld->Get() != &World);
+				SPEC_TEST_EQUAL(World.GetActorCount(), OriginalActorCount);
+			});
+		});
+
+		AfterEach([this]() {
+			SharedWorldLoader.ClearResetHooks();
+			OUU::TestUtilities::FLatentAutomationPIEWorldLoader::CloseSharedSession();
+		});
+	});
+
 	AfterEach([this]() { WorldLoader.ClosePIE(); });
 }
 